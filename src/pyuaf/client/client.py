@@ -2285,6 +2285,90 @@ class Client(ClientBase):
         
         finally:
             self.__eventNotificationLock__.release()
+    
+    
+    def registerNodes(self, addresses, **kwargs):
+        """
+        Register a number of nodes that will be accessed repeatedly.
+        
+        This is a convenience function for calling :class:`~pyuaf.client.Client.processRequest` with 
+        a :class:`~pyuaf.client.requests.RegisterNodesRequest` as its first argument.
+        For full flexibility, use that function.
+        
+        The aliases that the server assigns to the registered nodes are stored by the session, and
+        are used transparently by all following read and write requests to these nodes (so you can
+        keep on using the same addresses). When the session is reconnected, the nodes are registered
+        again automatically.
+        
+        :param addresses: A single address or a list of addresses of nodes to be registered.
+        :type  addresses: :class:`~pyuaf.util.Address` or a ``list`` of :class:`~pyuaf.util.Address` 
+        :param kwargs: The following \*\*kwargs are available (see :ref:`note-client-kwargs`):
+        
+           - clientConnectionId: (type: ``int``)
+           - sessionSettings (type: :class:`~pyuaf.client.settings.SessionSettings`)
+           - serviceSettings (type: :class:`~pyuaf.client.settings.RegisterNodesSettings`)
+           - translateSettings (type: :class:`~pyuaf.client.settings.TranslateBrowsePathsToNodeIdsSettings`)
+           
+        :return: The result of the RegisterNodes request.
+        :rtype:  :class:`~pyuaf.client.results.RegisterNodesResult`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        if type(addresses) == pyuaf.util.Address:
+            addressVector = pyuaf.util.AddressVector([addresses])
+        else:
+            addressVector = pyuaf.util.AddressVector(addresses)
+        result = pyuaf.client.results.RegisterNodesResult()
+        
+        ClientBase.registerNodes(self, 
+                                 addressVector, 
+                                 __getElementFromKwargs__(kwargs, "clientConnectionId"   , pyuaf.util.constants.CLIENTHANDLE_NOT_ASSIGNED), 
+                                 __getElementFromKwargs__(kwargs, "serviceSettings"      , None), 
+                                 __getElementFromKwargs__(kwargs, "translateSettings"    , None), 
+                                 __getElementFromKwargs__(kwargs, "sessionSettings"      , None),
+                                 result).test()
+        
+        return result
+    
+    
+    def unregisterNodes(self, addresses, **kwargs):
+        """
+        Unregister a number of nodes that were registered by :meth:`~pyuaf.client.Client.registerNodes`.
+        
+        This is a convenience function for calling :class:`~pyuaf.client.Client.processRequest` with 
+        a :class:`~pyuaf.client.requests.UnregisterNodesRequest` as its first argument.
+        For full flexibility, use that function.
+        
+        :param addresses: A single address or a list of addresses of nodes to be unregistered
+                          (the same addresses as the ones that were registered).
+        :type  addresses: :class:`~pyuaf.util.Address` or a ``list`` of :class:`~pyuaf.util.Address` 
+        :param kwargs: The following \*\*kwargs are available (see :ref:`note-client-kwargs`):
+        
+           - clientConnectionId: (type: ``int``)
+           - sessionSettings (type: :class:`~pyuaf.client.settings.SessionSettings`)
+           - serviceSettings (type: :class:`~pyuaf.client.settings.UnregisterNodesSettings`)
+           - translateSettings (type: :class:`~pyuaf.client.settings.TranslateBrowsePathsToNodeIdsSettings`)
+           
+        :return: The result of the UnregisterNodes request.
+        :rtype:  :class:`~pyuaf.client.results.UnregisterNodesResult`
+        :raise pyuaf.util.errors.UafError:
+             Base exception, catch this to handle any UAF errors.
+        """
+        if type(addresses) == pyuaf.util.Address:
+            addressVector = pyuaf.util.AddressVector([addresses])
+        else:
+            addressVector = pyuaf.util.AddressVector(addresses)
+        result = pyuaf.client.results.UnregisterNodesResult()
+        
+        ClientBase.unregisterNodes(self, 
+                                   addressVector, 
+                                   __getElementFromKwargs__(kwargs, "clientConnectionId"   , pyuaf.util.constants.CLIENTHANDLE_NOT_ASSIGNED), 
+                                   __getElementFromKwargs__(kwargs, "serviceSettings"      , None), 
+                                   __getElementFromKwargs__(kwargs, "translateSettings"    , None), 
+                                   __getElementFromKwargs__(kwargs, "sessionSettings"      , None),
+                                   result).test()
+        
+        return result
 
             
     def setPublishingMode(self, clientSubscriptionHandle, publishingEnabled, serviceSettings=None):
@@ -2564,6 +2648,10 @@ class Client(ClientBase):
             result = pyuaf.client.results.BrowseNextResult()
         elif type(request) == pyuaf.client.requests.HistoryReadRawModifiedRequest:
             result = pyuaf.client.results.HistoryReadRawModifiedResult()
+        elif type(request) == pyuaf.client.requests.RegisterNodesRequest:
+            result = pyuaf.client.results.RegisterNodesResult()
+        elif type(request) == pyuaf.client.requests.UnregisterNodesRequest:
+            result = pyuaf.client.results.UnregisterNodesResult()
         elif type(request) == pyuaf.client.requests.AsyncMethodCallRequest:
             result = pyuaf.client.results.AsyncMethodCallResult()
         elif type(request) == pyuaf.client.requests.CreateMonitoredDataRequest:
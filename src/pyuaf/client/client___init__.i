@@ -40,6 +40,8 @@
 #include "uaf/client/requests/translatebrowsepathstonodeidsrequesttarget.h"
 #include "uaf/client/requests/writerequesttarget.h"
 #include "uaf/client/requests/historyreadrawmodifiedrequesttarget.h"
+#include "uaf/client/requests/registernodesrequesttarget.h"
+#include "uaf/client/requests/unregisternodesrequesttarget.h"
 #include "uaf/client/requests/basesessionrequest.h"
 #include "uaf/client/requests/basesubscriptionrequest.h"
 #include "uaf/client/requests/requests.h"
@@ -57,6 +59,8 @@
 #include "uaf/client/results/translatebrowsepathstonodeidsresulttarget.h"
 #include "uaf/client/results/writeresulttarget.h"
 #include "uaf/client/results/historyreadrawmodifiedresulttarget.h"
+#include "uaf/client/results/registernodesresulttarget.h"
+#include "uaf/client/results/unregisternodesresulttarget.h"
 #include "uaf/client/results/results.h"
 #include "uaf/client/subscriptions/monitoreditemnotification.h"
 #include "uaf/client/subscriptions/datachangenotification.h"
@@ -38,6 +38,8 @@
 #include "uaf/client/requests/translatebrowsepathstonodeidsrequesttarget.h"
 #include "uaf/client/requests/writerequesttarget.h"
 #include "uaf/client/requests/historyreadrawmodifiedrequesttarget.h"
+#include "uaf/client/requests/registernodesrequesttarget.h"
+#include "uaf/client/requests/unregisternodesrequesttarget.h"
 #include "uaf/client/requests/basesessionrequest.h"
 #include "uaf/client/requests/basesubscriptionrequest.h"
 #include "uaf/client/requests/requests.h"
@@ -89,6 +91,8 @@ MAKE_NON_DYNAMIC(uaf::BrowseRequestTarget)
 MAKE_NON_DYNAMIC(uaf::BrowseNextRequestTarget)
 MAKE_NON_DYNAMIC(uaf::WriteRequestTarget)
 MAKE_NON_DYNAMIC(uaf::HistoryReadRawModifiedRequestTarget)
+MAKE_NON_DYNAMIC(uaf::RegisterNodesRequestTarget)
+MAKE_NON_DYNAMIC(uaf::UnregisterNodesRequestTarget)
 %ignore operator==(const BaseSessionRequest<_ServiceSettings, _Target, _Async>& object1, const BaseSessionRequest<_ServiceSettings, _Target, _Async>& object2);
 %ignore operator!=(const BaseSessionRequest<_ServiceSettings, _Target, _Async>& object1, const BaseSessionRequest<_ServiceSettings, _Target, _Async>& object2);
 %ignore operator< (const BaseSessionRequest<_ServiceSettings, _Target, _Async>& object1, const BaseSessionRequest<_ServiceSettings, _Target, _Async>& object2);
@@ -109,6 +113,8 @@ UAF_WRAP_CLASS("uaf/client/requests/readrequesttarget.h"
 UAF_WRAP_CLASS("uaf/client/requests/translatebrowsepathstonodeidsrequesttarget.h", uaf , TranslateBrowsePathsToNodeIdsRequestTarget , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client.requests, TranslateBrowsePathsToNodeIdsRequestTargetVector)
 UAF_WRAP_CLASS("uaf/client/requests/writerequesttarget.h"                        , uaf , WriteRequestTarget                         , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client.requests, WriteRequestTargetVector)
 UAF_WRAP_CLASS("uaf/client/requests/historyreadrawmodifiedrequesttarget.h"       , uaf , HistoryReadRawModifiedRequestTarget        , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client.requests, HistoryReadRawModifiedRequestTargetVector)
+UAF_WRAP_CLASS("uaf/client/requests/registernodesrequesttarget.h"                , uaf , RegisterNodesRequestTarget                 , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client.requests, RegisterNodesRequestTargetVector)
+UAF_WRAP_CLASS("uaf/client/requests/unregisternodesrequesttarget.h"              , uaf , UnregisterNodesRequestTarget               , COPY_YES, TOSTRING_YES, COMP_YES, pyuaf.client.requests, UnregisterNodesRequestTargetVector)
 UAF_WRAP_CLASS("uaf/client/requests/basesessionrequest.h"                        , uaf , BaseSessionRequest                         , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client.requests, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/requests/basesubscriptionrequest.h"                   , uaf , BaseSubscriptionRequest                    , COPY_YES, TOSTRING_YES, COMP_NO,  pyuaf.client.requests, VECTOR_NO)
 
@@ -179,6 +185,8 @@ CREATE_UAF_SYNC_SESSIONREQUEST(TranslateBrowsePathsToNodeIds)
 CREATE_UAF_SYNC_SESSIONREQUEST(Browse)
 CREATE_UAF_SYNC_SESSIONREQUEST(BrowseNext)
 CREATE_UAF_SYNC_SESSIONREQUEST(HistoryReadRawModified)
+CREATE_UAF_SYNC_SESSIONREQUEST(RegisterNodes)
+CREATE_UAF_SYNC_SESSIONREQUEST(UnregisterNodes)
 
 
 // create asynchronous session requests
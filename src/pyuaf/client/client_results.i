@@ -35,6 +35,8 @@
 #include "uaf/client/results/translatebrowsepathstonodeidsresulttarget.h"
 #include "uaf/client/results/writeresulttarget.h"
 #include "uaf/client/results/historyreadrawmodifiedresulttarget.h"
+#include "uaf/client/results/registernodesresulttarget.h"
+#include "uaf/client/results/unregisternodesresulttarget.h"
 #include "uaf/client/results/results.h"
 %}
 
@@ -93,6 +95,8 @@ UAF_WRAP_CLASS("uaf/client/results/readresulttarget.h"
 UAF_WRAP_CLASS("uaf/client/results/translatebrowsepathstonodeidsresulttarget.h" , uaf , TranslateBrowsePathsToNodeIdsResultTarget , COPY_NO , TOSTRING_YES, COMP_YES, pyuaf.client.results, TranslateBrowsePathsToNodeIdsResultTargetVector)
 UAF_WRAP_CLASS("uaf/client/results/writeresulttarget.h"                         , uaf , WriteResultTarget                         , COPY_NO , TOSTRING_YES, COMP_YES, pyuaf.client.results, WriteResultTargetVector)
 UAF_WRAP_CLASS("uaf/client/results/historyreadrawmodifiedresulttarget.h"        , uaf , HistoryReadRawModifiedResultTarget        , COPY_NO , TOSTRING_YES, COMP_YES, pyuaf.client.results, HistoryReadRawModifiedResultTargetVector)
+UAF_WRAP_CLASS("uaf/client/results/registernodesresulttarget.h"                 , uaf , RegisterNodesResultTarget                 , COPY_NO , TOSTRING_YES, COMP_YES, pyuaf.client.results, RegisterNodesResultTargetVector)
+UAF_WRAP_CLASS("uaf/client/results/unregisternodesresulttarget.h"               , uaf , UnregisterNodesResultTarget               , COPY_NO , TOSTRING_YES, COMP_YES, pyuaf.client.results, UnregisterNodesResultTargetVector)
 UAF_WRAP_CLASS("uaf/client/results/basesessionresult.h"                         , uaf , BaseSessionResult                         , COPY_YES, TOSTRING_NO,  COMP_NO,  pyuaf.client.results, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/results/basesubscriptionresult.h"                    , uaf , BaseSubscriptionResult                    , COPY_YES, TOSTRING_NO,  COMP_NO,  pyuaf.client.results, VECTOR_NO)
 
@@ -118,6 +122,8 @@ CREATE_UAF_SYNC_SESSIONRESULT(TranslateBrowsePathsToNodeIds)
 CREATE_UAF_SYNC_SESSIONRESULT(Browse)
 %template(BrowseNextResult) uaf::BaseSessionResult<uaf::BrowseResultTarget, false>;
 CREATE_UAF_SYNC_SESSIONRESULT(HistoryReadRawModified)
+CREATE_UAF_SYNC_SESSIONRESULT(RegisterNodes)
+CREATE_UAF_SYNC_SESSIONRESULT(UnregisterNodes)
 
 // create the asynchronous session results
 CREATE_UAF_ASYNC_SESSIONRESULT(Read)
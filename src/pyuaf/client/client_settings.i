@@ -30,10 +30,12 @@
 #include "uaf/client/settings/methodcallsettings.h"
 #include "uaf/client/settings/monitoreditemsettings.h"
 #include "uaf/client/settings/readsettings.h"
+#include "uaf/client/settings/registernodessettings.h"
 #include "uaf/client/settings/sessionsecuritysettings.h"
 #include "uaf/client/settings/sessionsettings.h"
 #include "uaf/client/settings/subscriptionsettings.h"
 #include "uaf/client/settings/translatebrowsepathstonodeidssettings.h"
+#include "uaf/client/settings/unregisternodessettings.h"
 #include "uaf/client/settings/writesettings.h"
 #include "uaf/client/settings/historyreadrawmodifiedsettings.h"
 #include "uaf/util/address.h"
@@ -105,6 +107,8 @@ UAF_WRAP_CLASS("uaf/client/settings/browsesettings.h"                        , u
 UAF_WRAP_CLASS("uaf/client/settings/browsenextsettings.h"                    , uaf , BrowseNextSettings                    , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/createmonitoreddatasettings.h"           , uaf , CreateMonitoredDataSettings           , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 UAF_WRAP_CLASS("uaf/client/settings/createmonitoredeventssettings.h"         , uaf , CreateMonitoredEventsSettings         , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/settings/registernodessettings.h"                 , uaf , RegisterNodesSettings                 , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
+UAF_WRAP_CLASS("uaf/client/settings/unregisternodessettings.h"               , uaf , UnregisterNodesSettings               , COPY_YES, TOSTRING_YES, COMP_YES,  pyuaf.client.settings, VECTOR_NO)
 
 
 // create the SpecificSessionSettings and SpecificSubscriptionSettings
@@ -379,6 +379,27 @@
     }
 
 
+#define CREATE_NUMERIC_ARRAY(TYPE, CTYPE, VARIANT, PYRESULT)                                    \
+    uaf::ArrayView<CTYPE> view;                                                                 \
+    if (VARIANT.to##TYPE##ArrayView(view).isGood())                                             \
+    {                                                                                           \
+        PYRESULT = PyList_New(view.size());                                                     \
+        for (Py_ssize_t i = 0; i < Py_ssize_t(view.size()); i++)                                \
+        {                                                                                       \
+            uaf::primitives::TYPE* primitive = new uaf::primitives::TYPE;                       \
+            primitive->value = view[i];                                                         \
+            PyObject* newItem = SWIG_NewPointerObj(primitive,                                   \
+                                                   $descriptor(uaf::primitives::TYPE *),        \
+                                                   SWIG_POINTER_OWN);                           \
+            PyList_SetItem(PYRESULT, i, newItem);                                               \
+        }                                                                                       \
+    }                                                                                           \
+    else                                                                                        \
+    {                                                                                           \
+        CREATE_PRIMITIVE_ARRAY(TYPE, CTYPE, VARIANT, PYRESULT)                                  \
+    }
+
+
 #define CREATE_UAFTYPE_ARRAY(TYPE, VARIANT, PYRESULT)                                           \
     std::vector<uaf::TYPE> vec;                                                                 \
     uaf::Status conversionStatus = VARIANT.to##TYPE##Array(vec);                                \
@@ -400,16 +421,16 @@
 
 #define CREATE_ARRAYOBJECT(VARIANT, PYOBJECT)  \
     if (VARIANT.type() == uaf::opcuatypes::Boolean)              { CREATE_PRIMITIVE_ARRAY(Boolean,    bool, VARIANT, PYOBJECT)     } \
-    else if (VARIANT.type() == uaf::opcuatypes::SByte)           { CREATE_PRIMITIVE_ARRAY(SByte,      int8_t, VARIANT, PYOBJECT)   } \
-    else if (VARIANT.type() == uaf::opcuatypes::Byte)            { CREATE_PRIMITIVE_ARRAY(Byte,       uint8_t, VARIANT, PYOBJECT)  } \
-    else if (VARIANT.type() == uaf::opcuatypes::Int16)           { CREATE_PRIMITIVE_ARRAY(Int16,      int16_t, VARIANT, PYOBJECT)  } \
-    else if (VARIANT.type() == uaf::opcuatypes::UInt16)          { CREATE_PRIMITIVE_ARRAY(UInt16,     uint16_t, VARIANT, PYOBJECT) } \
-    else if (VARIANT.type() == uaf::opcuatypes::Int32)           { CREATE_PRIMITIVE_ARRAY(Int32,      int32_t, VARIANT, PYOBJECT)  } \
-    else if (VARIANT.type() == uaf::opcuatypes::UInt32)          { CREATE_PRIMITIVE_ARRAY(UInt32,     uint32_t, VARIANT, PYOBJECT) } \
-    else if (VARIANT.type() == uaf::opcuatypes::Int64)           { CREATE_PRIMITIVE_ARRAY(Int64,      int64_t, VARIANT, PYOBJECT)  } \
-    else if (VARIANT.type() == uaf::opcuatypes::UInt64)          { CREATE_PRIMITIVE_ARRAY(UInt64,     uint64_t, VARIANT, PYOBJECT) } \
-    else if (VARIANT.type() == uaf::opcuatypes::Float)           { CREATE_PRIMITIVE_ARRAY(Float,      float, VARIANT, PYOBJECT)    } \
-    else if (VARIANT.type() == uaf::opcuatypes::Double)          { CREATE_PRIMITIVE_ARRAY(Double,     double, VARIANT, PYOBJECT)   } \
+    else if (VARIANT.type() == uaf::opcuatypes::SByte)           { CREATE_NUMERIC_ARRAY(SByte,      int8_t, VARIANT, PYOBJECT)   } \
+    else if (VARIANT.type() == uaf::opcuatypes::Byte)            { CREATE_NUMERIC_ARRAY(Byte,       uint8_t, VARIANT, PYOBJECT)  } \
+    else if (VARIANT.type() == uaf::opcuatypes::Int16)           { CREATE_NUMERIC_ARRAY(Int16,      int16_t, VARIANT, PYOBJECT)  } \
+    else if (VARIANT.type() == uaf::opcuatypes::UInt16)          { CREATE_NUMERIC_ARRAY(UInt16,     uint16_t, VARIANT, PYOBJECT) } \
+    else if (VARIANT.type() == uaf::opcuatypes::Int32)           { CREATE_NUMERIC_ARRAY(Int32,      int32_t, VARIANT, PYOBJECT)  } \
+    else if (VARIANT.type() == uaf::opcuatypes::UInt32)          { CREATE_NUMERIC_ARRAY(UInt32,     uint32_t, VARIANT, PYOBJECT) } \
+    else if (VARIANT.type() == uaf::opcuatypes::Int64)           { CREATE_NUMERIC_ARRAY(Int64,      int64_t, VARIANT, PYOBJECT)  } \
+    else if (VARIANT.type() == uaf::opcuatypes::UInt64)          { CREATE_NUMERIC_ARRAY(UInt64,     uint64_t, VARIANT, PYOBJECT) } \
+    else if (VARIANT.type() == uaf::opcuatypes::Float)           { CREATE_NUMERIC_ARRAY(Float,      float, VARIANT, PYOBJECT)    } \
+    else if (VARIANT.type() == uaf::opcuatypes::Double)          { CREATE_NUMERIC_ARRAY(Double,     double, VARIANT, PYOBJECT)   } \
     else if (VARIANT.type() == uaf::opcuatypes::String)          { CREATE_PRIMITIVE_ARRAY(String,     std::string, VARIANT, PYOBJECT)   } \
     else if (VARIANT.type() == uaf::opcuatypes::ByteString)      { CREATE_PRIMITIVE_ARRAY(ByteString, uaf::ByteString, VARIANT, PYOBJECT)   } \
     else if (VARIANT.type() == uaf::opcuatypes::NodeId)          { CREATE_UAFTYPE_ARRAY(NodeId, VARIANT, PYOBJECT)         } \
@@ -182,6 +182,16 @@ UAF_WRAP_CLASS("uaf/util/structuredefinition.h"    , uaf , StructureDefinition
 #endif
 
 
+// SWIG sees the raisedBy_XXX errors of a Status as accessor methods (since in C++ they all share
+// the storage of a single error). In Python they remain attributes, as they always were.
+%pythoncode %{
+for _name in dir(Status):
+    if _name.startswith("raisedBy_"):
+        setattr(Status, _name, property(getattr(Status, _name)))
+del _name
+%}
+
+
 // SWIG iterators don't work well for our vectors (probably SWIG bug),
 // so therefore we create our own iterators:
 %pythoncode %{
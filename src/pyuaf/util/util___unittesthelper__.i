@@ -28,6 +28,23 @@
 #include "uaf/util/localizedtext.h"
 #include "uaf/util/extensionobject.h"
 #include <stdio.h>
+#include <algorithm>
+
+
+// view the array of the variant "v" as XXX (without copying it), and let the variant "ret" adopt
+// a copy of the viewed elements
+#define UNITTESTHELPER_ADOPT_VIEWED_ARRAY(XXX, TYPE)                                               \
+    case uaf::opcuatypes::XXX:                                                                     \
+    {                                                                                              \
+        uaf::ArrayView<TYPE> view;                                                                 \
+        if (v.to##XXX##ArrayView(view).isGood())                                                   \
+        {                                                                                          \
+            TYPE* data = uaf::allocateArray<TYPE>(view.size());                                    \
+            std::copy(view.begin(), view.end(), data);                                             \
+            ret.adopt##XXX##Array(data, view.size());                                              \
+        }                                                                                          \
+        break;                                                                                     \
+    }
 %}
 
 // import the necessary headers
@@ -322,5 +339,69 @@
         {
             return uaf::Variant(v);
         }
+
+        uaf::Variant testVariantArrayView_adopt(const uaf::Variant& v,
+                                                uaf::opcuatypes::OpcUaType type)
+        {
+            // declare the variant to return (it remains empty if the array cannot be viewed)
+            uaf::Variant ret;
+
+            switch (type)
+            {
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(SByte  , int8_t)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(Byte   , uint8_t)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(Int16  , int16_t)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(UInt16 , uint16_t)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(Int32  , int32_t)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(UInt32 , uint32_t)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(Int64  , int64_t)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(UInt64 , uint64_t)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(Float  , float)
+                UNITTESTHELPER_ADOPT_VIEWED_ARRAY(Double , double)
+                default: break;
+            }
+
+            return ret;
+        }
+
+        bool testVariantString_roundTrip(uint32_t length, bool embeddedNull)
+        {
+            // create a string of the given length, optionally with a NUL character in the middle
+            std::string s;
+            for (uint32_t i = 0; i < length; i++)
+                s += char('a' + i % 26);
+            if (embeddedNull && length > 0)
+                s[length / 2] = '\0';
+
+            uaf::Variant v;
+            v.setString(s);
+
+            // copy the variant in all possible ways
+            uaf::Variant copied(v);
+            uaf::Variant assigned;
+            assigned = v;
+            UaVariant uaVariant;
+            v.toSdk(uaVariant);
+            uaf::Variant fromSdk;
+            fromSdk.fromSdk(uaVariant);
+
+            std::vector<std::string> array;
+            array.push_back(s);
+            array.push_back("short");
+            array.push_back(s);
+            uaf::Variant arrayVariant;
+            arrayVariant.setStringArray(array);
+            uaf::Variant copiedArray(arrayVariant);
+
+            // all copies must hold all bytes of the original string
+            std::string val;
+            std::vector<std::string> vec;
+            return    v.toString(val).isGood()                  && val == s
+                   && copied.toString(val).isGood()             && val == s
+                   && assigned.toString(val).isGood()           && val == s
+                   && fromSdk.toString(val).isGood()            && val == s
+                   && copiedArray.toStringArray(vec).isGood()   && vec == array
+                   && v == copied && v == assigned && v == fromSdk;
+        }
     };
 %}
@@ -79,17 +79,37 @@ namespace uaf
     void Client::construct()
     {
         currentRequestHandle_ = 0;
-        doFinishThread_ = false;
 
         database_       = new Database(logger_->loggerFactory());
         discoverer_     = new Discoverer(logger_->loggerFactory(), database_);
         sessionFactory_ = new SessionFactory(logger_->loggerFactory(), this, discoverer_, database_);
         resolver_       = new Resolver(logger_->loggerFactory(), sessionFactory_, database_);
 
-        logger_->debug("Now starting the thread to periodically check the requests");
-
-        // start the thread
-        start();
+        // apply the default limits of the address cache and the resolver (even if the client
+        // settings are never set, e.g. by the default constructor)
+        database_->addressCache.setLimits(database_->clientSettings.addressCacheMaxEntries,
+                                          database_->clientSettings.addressCacheMaxBytes,
+                                          database_->clientSettings.addressCacheTimeToLiveSec);
+        resolver_->setUnresolvableTimeToLive(
+                database_->clientSettings.addressCacheUnresolvableTimeToLiveSec);
+
+        logger_->debug("Now starting the periodic jobs");
+
+        // every job gets its own thread, so that e.g. a slow discovery server doesn't delay
+        // the reconnection of sessions or the re-creation of monitored items
+        scheduler_ = new Scheduler(logger_->loggerFactory());
+        scheduler_->schedule(new PeriodicJob(this,
+                                             &Client::discoverPeriodically,
+                                             &ClientSettings::discoveryIntervalSec),
+                             "Discovery");
+        scheduler_->schedule(new PeriodicJob(this,
+                                             &Client::doHouseKeepingPeriodically,
+                                             &ClientSettings::houseKeepingIntervalSec),
+                             "HouseKeeping");
+        scheduler_->schedule(new PeriodicJob(this,
+                                             &Client::processPersistedRequestsPeriodically,
+                                             &ClientSettings::persistedRequestsIntervalSec),
+                             "PersistedRequests");
 
         logger_->debug("The client has been constructed");
     }
@@ -101,13 +121,13 @@ namespace uaf
     {
         logger_->debug("Destructing the client");
 
-        // make sure the thread isn't doing anything
-        //UaMutexLocker locker(&threadStoppingMutex_);
-
-        doFinishThread_ = true;
-
-        wait();
+        // stop the periodic jobs (this returns as soon as the running jobs have finished)
+        delete scheduler_;
+        scheduler_ = 0;
 
+        // persist the resolved addresses for the next run
+        if (!database_->clientSettings.addressCacheFile.empty())
+            database_->addressCache.save(database_->clientSettings.addressCacheFile);
 
         delete resolver_;
         resolver_ = 0;
@@ -146,8 +166,26 @@ namespace uaf
         logger_->loggerFactory()->setCallbackLevel(settings.logToCallbackLevel);
 
         bool doFindServers = (settings.discoveryUrls != database_->clientSettings.discoveryUrls);
+        bool doLoadAddressCache = (   !settings.addressCacheFile.empty()
+                                   && (settings.addressCacheFile
+                                       != database_->clientSettings.addressCacheFile));
         database_->clientSettings = settings;
 
+        database_->addressCache.setLimits(settings.addressCacheMaxEntries,
+                                          settings.addressCacheMaxBytes,
+                                          settings.addressCacheTimeToLiveSec);
+        resolver_->setUnresolvableTimeToLive(settings.addressCacheUnresolvableTimeToLiveSec);
+
+        // load the addresses that were resolved by a previous run (after setting the limits)
+        if (doLoadAddressCache)
+        {
+            logger_->debug("The addressCacheFile was changed, so we load the address cache");
+            database_->addressCache.load(settings.addressCacheFile);
+        }
+
+        // the periodic jobs must take their changed intervals into account immediately
+        scheduler_->reschedule();
+
         if (doFindServers)
         {
             logger_->debug("The discoveryUrls were changed, so we rediscover the system");
@@ -168,7 +206,7 @@ namespace uaf
 
     // Get the servers that were found
     // =============================================================================================
-    const vector<ApplicationDescription>& Client::serversFound() const
+    vector<ApplicationDescription> Client::serversFound() const
     {
         return discoverer_->serversFound();
     }
@@ -613,6 +651,260 @@ namespace uaf
     }
 
 
+    // Register a number of nodes
+    //==============================================================================================
+    Status Client::registerNodes(
+            const vector<Address>&                          addresses,
+            ClientConnectionId                              clientConnectionId,
+            const RegisterNodesSettings*                    serviceSettings,
+            const TranslateBrowsePathsToNodeIdsSettings*    translateSettings,
+            const SessionSettings*                          sessionSettings,
+            RegisterNodesResult&                            result)
+    {
+        logger_->debug("Registering %d nodes", addresses.size());
+
+        RegisterNodesRequest request(0,
+                                     clientConnectionId,
+                                     serviceSettings,
+                                     translateSettings,
+                                     sessionSettings);
+
+        request.targets.reserve(addresses.size());
+
+        for (vector<Address>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
+            request.targets.push_back(RegisterNodesRequestTarget(*it));
+
+        return processRequest(request, result);
+    }
+
+
+    // Unregister a number of nodes
+    //==============================================================================================
+    Status Client::unregisterNodes(
+            const vector<Address>&                          addresses,
+            ClientConnectionId                              clientConnectionId,
+            const UnregisterNodesSettings*                  serviceSettings,
+            const TranslateBrowsePathsToNodeIdsSettings*    translateSettings,
+            const SessionSettings*                          sessionSettings,
+            UnregisterNodesResult&                          result)
+    {
+        logger_->debug("Unregistering %d nodes", addresses.size());
+
+        UnregisterNodesRequest request(0,
+                                       clientConnectionId,
+                                       serviceSettings,
+                                       translateSettings,
+                                       sessionSettings);
+
+        request.targets.reserve(addresses.size());
+
+        for (vector<Address>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
+            request.targets.push_back(UnregisterNodesRequestTarget(*it));
+
+        return processRequest(request, result);
+    }
+
+
+    // Prepare a number of addresses
+    //==============================================================================================
+    Status Client::prepare(const vector<Address>& addresses, PreparedAddresses& prepared)
+    {
+        logger_->debug("Preparing %d addresses", addresses.size());
+
+        PreparedAddressesHandle handle = database_->preparedAddressStore.add(addresses);
+
+        // bind the addresses for the first time
+        PreparedAddressStore::Item* item = 0;
+        Status ret = database_->preparedAddressStore.acquire(handle, item);
+        if (ret.isGood())
+        {
+            {
+                UaMutexLocker locker(&item->mutex); // unlocks when locker goes out of scope
+                ret = resolver_->bind(*item);
+                prepared.statuses = item->statuses;
+            }
+            database_->preparedAddressStore.release(item);
+        }
+
+        if (ret.isGood())
+        {
+            prepared.handle = handle;
+        }
+        else
+        {
+            logger_->error("The addresses could not be prepared");
+            database_->preparedAddressStore.remove(handle);
+        }
+
+        return ret;
+    }
+
+
+    // Forget a number of prepared addresses
+    //==============================================================================================
+    Status Client::unprepare(const PreparedAddresses& prepared)
+    {
+        logger_->debug("Unpreparing the prepared addresses %d", prepared.handle);
+        return database_->preparedAddressStore.remove(prepared.handle);
+    }
+
+
+    // Read a number of prepared node attributes
+    //==============================================================================================
+    Status Client::read(
+            const uaf::PreparedAddresses&                       prepared,
+            uaf::attributeids::AttributeId                      attributeId,
+            uaf::ClientConnectionId                             clientConnectionId,
+            const uaf::ReadSettings*                            serviceSettings,
+            const uaf::SessionSettings*                         sessionSettings,
+            uaf::ReadResult&                                    result)
+    {
+        // log read request
+        logger_->debug("Reading %d prepared node attributes", prepared.size());
+
+        ReadRequest request(0, clientConnectionId, serviceSettings, NULL, sessionSettings);
+
+        PreparedAddressStore::Item* item = 0;
+        Status ret = database_->preparedAddressStore.acquire(prepared.handle, item);
+        if (ret.isNotGood())
+            return ret;
+
+        // rebind the addresses if needed, and fill the targets with the bound addresses
+        Mask mask(item->addresses.size(), false);
+        {
+            UaMutexLocker locker(&item->mutex); // unlocks when locker goes out of scope
+
+            ret = resolver_->bind(*item);
+
+            if (ret.isGood())
+            {
+                request.targets.reserve(item->boundAddresses.size());
+                result.targets.resize(item->boundAddresses.size());
+
+                for (size_t i = 0; i < item->boundAddresses.size(); i++)
+                {
+                    request.targets.push_back(
+                            ReadRequestTarget(item->boundAddresses[i], attributeId));
+                    result.targets[i].status = item->statuses[i];
+                    if (item->statuses[i].isGood())
+                        mask.set(i);
+                }
+            }
+        }
+
+        database_->preparedAddressStore.release(item);
+
+        // perform the read request
+        if (ret.isGood())
+            ret = processPreparedRequest<ReadService>(request, mask, result);
+
+        return ret;
+    }
+
+
+    // Write a number of prepared node attributes
+    //==============================================================================================
+    Status Client::write(
+            const uaf::PreparedAddresses&                       prepared,
+            const std::vector<uaf::Variant>&                    data,
+            const uaf::attributeids::AttributeId                attributeId,
+            uaf::ClientConnectionId                             clientConnectionId,
+            const uaf::WriteSettings*                           serviceSettings,
+            const uaf::SessionSettings*                         sessionSettings,
+            uaf::WriteResult&                                   result)
+    {
+        // log write request
+        logger_->debug("Writing %d prepared node attributes", prepared.size());
+
+        // create a write request
+        WriteRequest request(0, clientConnectionId, serviceSettings, NULL, sessionSettings);
+
+        PreparedAddressStore::Item* item = 0;
+        Status ret = database_->preparedAddressStore.acquire(prepared.handle, item);
+        if (ret.isNotGood())
+            return ret;
+
+        // check if the addresses and the data match
+        if (item->addresses.size() != data.size())
+        {
+            database_->preparedAddressStore.release(item);
+            return DataDontMatchAddressesError();
+        }
+
+        // rebind the addresses if needed, and fill the targets with the bound addresses
+        Mask mask(item->addresses.size(), false);
+        {
+            UaMutexLocker locker(&item->mutex); // unlocks when locker goes out of scope
+
+            ret = resolver_->bind(*item);
+
+            if (ret.isGood())
+            {
+                request.targets.reserve(item->boundAddresses.size());
+                result.targets.resize(item->boundAddresses.size());
+
+                for (size_t i = 0; i < item->boundAddresses.size(); i++)
+                {
+                    request.targets.push_back(
+                            WriteRequestTarget(item->boundAddresses[i], data[i], attributeId));
+                    result.targets[i].status = item->statuses[i];
+                    if (item->statuses[i].isGood())
+                        mask.set(i);
+                }
+            }
+        }
+
+        database_->preparedAddressStore.release(item);
+
+        // perform the write request
+        if (ret.isGood())
+            ret = processPreparedRequest<WriteService>(request, mask, result);
+
+        return ret;
+    }
+
+
+    // Start monitoring the data of prepared addresses
+    //==============================================================================================
+    Status Client::createMonitoredData(
+            const uaf::PreparedAddresses&                       prepared,
+            uaf::ClientConnectionId                             clientConnectionId,
+            const uaf::CreateMonitoredDataSettings*             serviceSettings,
+            const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+            const uaf::SessionSettings*                         sessionSettings,
+            uaf::ClientSubscriptionHandle                       clientSubscriptionHandle,
+            const uaf::SubscriptionSettings*                    subscriptionSettings,
+            uaf::CreateMonitoredDataResult&                     result)
+    {
+        CreateMonitoredDataRequest request(0,
+                                           clientConnectionId,
+                                           serviceSettings,
+                                           translateSettings,
+                                           sessionSettings,
+                                           clientSubscriptionHandle,
+                                           subscriptionSettings);
+
+        PreparedAddressStore::Item* item = 0;
+        Status ret = database_->preparedAddressStore.acquire(prepared.handle, item);
+        if (ret.isNotGood())
+            return ret;
+
+        // the monitored items are persisted, so they are created for the original addresses
+        // (which are resolved again if the monitored items must be re-created later on)
+        request.targets.reserve(item->addresses.size());
+        for (vector<Address>::const_iterator it = item->addresses.begin();
+             it != item->addresses.end();
+             ++it)
+        {
+            request.targets.push_back(CreateMonitoredDataRequestTarget(*it));
+        }
+
+        database_->preparedAddressStore.release(item);
+
+        return processRequest(request, result);
+    }
+
+
     // Manual connection
     //==============================================================================================
     Status Client::manuallyConnect(
@@ -759,51 +1051,62 @@ namespace uaf
     }
 
 
-    // Run the thread
+    // Get the interval of a periodic job
     // =============================================================================================
-    void Client::run()
+    double Client::PeriodicJob::intervalSec() const
     {
-        logger_->debug("Thread has started to periodically check the requests");
-
-        // declare the current time and the time of the last actions
-        time_t currentTime;
-        time_t lastTime;
-
-        // initialize the time values
-        time(&currentTime);
-        time(&lastTime);
+        return client_->database_->clientSettings.*interval_;
+    }
 
 
-        double updateInterval;
+    // Execute a periodic job
+    // =============================================================================================
+    void Client::PeriodicJob::execute()
+    {
+        (client_->*action_)();
+    }
 
-        while (!doFinishThread_)
-        {
-            updateInterval = database_->clientSettings.discoveryIntervalSec;
 
-            msleep(100);
+    // Periodically discover the servers
+    // =============================================================================================
+    void Client::discoverPeriodically()
+    {
+        logger_->debug("Now discovering the system");
+        discoverer_->findServers();
+    }
 
-            time(&currentTime);
 
-            if (difftime(currentTime, lastTime) > updateInterval)
-            {
-                logger_->debug("Now discovering the system and checking the persistent requests");
+    // Periodically check the sessions and subscriptions
+    // =============================================================================================
+    void Client::doHouseKeepingPeriodically()
+    {
+        logger_->debug("Now doing the housekeeping of the sessions");
+        sessionFactory_->doHouseKeeping();
 
-                // update the lastTime
-                time(&lastTime);
+        if (logger_->isDebugEnabled())
+        {
+            AddressCache::Statistics stats = database_->addressCache.statistics();
+            logger_->debug("Address cache: %d entries (%d bytes), %llu hits, %llu misses, "
+                           "%llu evictions, %llu expirations",
+                           stats.entries, stats.bytes,
+                           (unsigned long long)stats.hits,
+                           (unsigned long long)stats.misses,
+                           (unsigned long long)stats.evictions,
+                           (unsigned long long)stats.expirations);
+        }
+    }
 
-                if (!doFinishThread_)
-                    discoverer_->findServers();
 
-                if (!doFinishThread_)
-                    sessionFactory_->doHouseKeeping();
+    // Periodically process the persisted requests
+    // =============================================================================================
+    void Client::processPersistedRequestsPeriodically()
+    {
+        logger_->debug("Now checking the persistent requests");
 
-                if (!doFinishThread_)
-                    processPersistedRequests(database_->createMonitoredDataRequestStore);
+        processPersistedRequests(database_->createMonitoredDataRequestStore);
 
-                if (!doFinishThread_)
-                    processPersistedRequests(database_->createMonitoredEventsRequestStore);
-            }
-        }
+        if (!scheduler_->isStopping())
+            processPersistedRequests(database_->createMonitoredEventsRequestStore);
     }
 
 
@@ -915,6 +1218,26 @@ namespace uaf
     }
 
 
+    // Process a RegisterNodesRequest
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::RegisterNodesRequest&   request,
+            uaf::RegisterNodesResult&          result)
+    {
+        return processRequest<uaf::RegisterNodesService>(request, result);
+    }
+
+
+    // Process an UnregisterNodesRequest
+    // =============================================================================================
+    Status Client::processRequest(
+            const uaf::UnregisterNodesRequest& request,
+            uaf::UnregisterNodesResult&        result)
+    {
+        return processRequest<uaf::UnregisterNodesService>(request, result);
+    }
+
+
     // Get a structure definition
     // =============================================================================================
     Status Client::structureDefinition(const uaf::NodeId &dataTypeId, uaf::StructureDefinition& definition)
@@ -1008,8 +1331,11 @@ namespace uaf
         // declare the return Status
         uaf::Status ret;
 
-        logger_->debug("Processing the following %sRequest:", _Service::name().c_str());
-        logger_->debug(request.toString());
+        if (logger_->isDebugEnabled())
+        {
+            logger_->debug("Processing the following %sRequest:", _Service::name().c_str());
+            logger_->debug(request.toString());
+        }
 
         // resize the result
         result.targets.resize(request.targets.size());
@@ -1060,7 +1386,7 @@ namespace uaf
             ret = updateResultIfNeeded<_Service>(result, mask, database_);
 
         // log the result, if good
-        if (ret.isGood())
+        if (ret.isGood() && logger_->isDebugEnabled())
         {
             logger_->debug("%sResult %d:", _Service::name().c_str(), result.requestHandle);
             logger_->debug(result.toString());
@@ -1078,5 +1404,41 @@ namespace uaf
     }
 
 
+    // Private template function implementation: process a prepared request
+    // =============================================================================================
+    template<typename _Service>
+    uaf::Status Client::processPreparedRequest(
+            typename _Service::Request&         request,
+            const uaf::Mask&                    mask,
+            typename _Service::Result&          result)
+    {
+        if (logger_->isDebugEnabled())
+        {
+            logger_->debug("Processing the following prepared %sRequest:",
+                           _Service::name().c_str());
+            logger_->debug(request.toString());
+        }
+
+        // get a new unique request handle, and update the request and result with it
+        uaf::Status ret = assignRequestHandle<_Service>(request, result);
+
+        // if no error occurred, invoke the (already resolved) service request
+        if (ret.isGood())
+            ret = sessionFactory_->invokeRequest<_Service>(request, mask, result);
+
+        // finally, update the overall status
+        result.updateOverallStatus();
+
+        // log the result, if good
+        if (ret.isGood() && logger_->isDebugEnabled())
+        {
+            logger_->debug("%sResult %d:", _Service::name().c_str(), result.requestHandle);
+            logger_->debug(result.toString());
+        }
+
+        return ret;
+    }
+
+
 }
 
@@ -27,17 +27,18 @@
 #include <vector>
 #include <map>
 // SDK
-#include "uabase/uathread.h"
 #include "uabase/uamutex.h"
 #include "uabase/uadatetime.h"
 // UAF
 #include "uaf/util/logger.h"
 #include "uaf/util/mask.h"
 #include "uaf/util/logginginterface.h"
+#include "uaf/util/scheduler.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/settings/clientsettings.h"
 #include "uaf/client/database/database.h"
 #include "uaf/client/resolution/resolver.h"
+#include "uaf/client/resolution/preparedaddresses.h"
 #include "uaf/client/sessions/sessionfactory.h"
 #include "uaf/client/clientservices.h"
 
@@ -52,8 +53,7 @@ namespace uaf
     *
     * @ingroup Client
     ***********************************************************************************************/
-    class UAF_EXPORT Client : private UaThread,
-                               public uaf::ClientInterface,
+    class UAF_EXPORT Client : public uaf::ClientInterface,
                                public uaf::LoggingInterface
     {
     public:
@@ -129,17 +129,20 @@ namespace uaf
 
 
         /**
-         * Get a const reference to the servers that were found.
+         * Get a snapshot of the servers that were found.
          *
-         * @return  A vector of the application descriptions that were discovered.
+         * @return  A copy of the application descriptions that were discovered.
          */
-        const std::vector<uaf::ApplicationDescription>& serversFound() const;
+        std::vector<uaf::ApplicationDescription> serversFound() const;
 
 
         /**
          * Get the endpoint descriptions for a given server by calling the OPC UA
          * GetEndpoints service on the given URL.
          *
+         * Endpoints that were fetched less than ClientSettings::discoveryEndpointsCacheTimeSec
+         * seconds ago are taken from the cache of the discoverer.
+         *
          * @param discoveryUrl          URL of the server to discover.
          * @param endpointDescriptions  Endpoint descriptions that will be fetched.
          * @return                      Status of the service call.
@@ -556,6 +559,165 @@ namespace uaf
                 uaf::CreateMonitoredEventsResult&                   result);
 
 
+        /**
+         * Register a number of nodes that will be accessed repeatedly.
+         *
+         * The aliases that the server assigns to the nodes are stored by the session, and will be
+         * used transparently by all following read and write requests to these nodes (so you can
+         * keep on using the original addresses). When the session is reconnected, the nodes are
+         * registered again automatically.
+         *
+         * @param addresses         Addresses of the nodes to register.
+         * @param serviceSettings   RegisterNodes settings.
+         * @param sessionSettings   Session settings.
+         * @param result            Result of the request.
+         * @return                  Client-side status.
+         */
+        uaf::Status registerNodes(
+                const std::vector<uaf::Address>&                    addresses,
+                uaf::ClientConnectionId                             clientConnectionId,
+                const uaf::RegisterNodesSettings*                   serviceSettings,
+                const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+                const uaf::SessionSettings*                         sessionSettings,
+                uaf::RegisterNodesResult&                           result);
+
+
+        /**
+         * Unregister a number of nodes that were registered by registerNodes().
+         *
+         * @param addresses         Addresses of the nodes to unregister (the same addresses as
+         *                          the ones that were registered).
+         * @param serviceSettings   UnregisterNodes settings.
+         * @param sessionSettings   Session settings.
+         * @param result            Result of the request.
+         * @return                  Client-side status.
+         */
+        uaf::Status unregisterNodes(
+                const std::vector<uaf::Address>&                    addresses,
+                uaf::ClientConnectionId                             clientConnectionId,
+                const uaf::UnregisterNodesSettings*                 serviceSettings,
+                const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+                const uaf::SessionSettings*                         sessionSettings,
+                uaf::UnregisterNodesResult&                         result);
+
+
+
+#ifndef SWIG /* The prepared addresses are not wrapped by pyuaf (yet). */
+
+        ///@} //////////////////////////////////////////////////////////////////////////////////////
+        /**
+         *  @name Prepared
+         *  Methods to resolve addresses once, and to read, write or monitor them many times.
+         */
+        ///@{
+
+
+        /**
+         * Prepare a number of addresses, so that they can be read, written or monitored many
+         * times without being resolved again.
+         *
+         * The addresses are resolved immediately, and their resolved NodeIds (with the namespace
+         * indexes of their servers) are kept by the client until unprepare() is called. The
+         * client resolves them again automatically when needed, i.e. when the addresses could
+         * not be resolved before, when the cached addresses of their server have been cleared
+         * or invalidated (e.g. after a reconnection, or a change of the address space), or when
+         * the namespace array of their server has changed.
+         *
+         * @param addresses The addresses to prepare.
+         * @param prepared  Output parameter: the handle to the prepared addresses, and the
+         *                  statuses of their resolution.
+         * @return          Client-side status.
+         */
+        uaf::Status prepare(
+                const std::vector<uaf::Address>&    addresses,
+                uaf::PreparedAddresses&             prepared);
+
+
+        /**
+         * Forget the given prepared addresses.
+         *
+         * @param prepared  The prepared addresses.
+         * @return          Client-side status (ItemNotFoundForTheGivenHandleError if the
+         *                  addresses were not prepared by this client, or already unprepared).
+         */
+        uaf::Status unprepare(const uaf::PreparedAddresses& prepared);
+
+
+        /**
+         * Read a number of prepared node attributes synchronously.
+         *
+         * Only the addresses that could be resolved are read, the others get the status of
+         * their resolution as result.
+         *
+         * @param prepared          The prepared addresses of the nodes of which the attributes
+         *                          should be read.
+         * @param attributeId       The attribute to be read (e.g. Value or DisplayName).
+         * @param serviceSettings   Read settings.
+         * @param sessionSettings   Session settings.
+         * @param result            Result of the request.
+         * @return                  Client-side status.
+         */
+        uaf::Status read(
+                const uaf::PreparedAddresses&                       prepared,
+                uaf::attributeids::AttributeId                      attributeId,
+                uaf::ClientConnectionId                             clientConnectionId,
+                const uaf::ReadSettings*                            serviceSettings,
+                const uaf::SessionSettings*                         sessionSettings,
+                uaf::ReadResult&                                    result);
+
+
+        /**
+         * Write a number of prepared node attributes synchronously.
+         *
+         * Only the addresses that could be resolved are written, the others get the status of
+         * their resolution as result.
+         *
+         * @param prepared          The prepared addresses of the nodes of which the attribute
+         *                          should be written.
+         * @param data              Data values that should be written (one data value per address).
+         * @param attributeId       Attribute id that should be written for all nodes.
+         * @param serviceSettings   Write settings.
+         * @param sessionSettings   Session settings.
+         * @param result            Result of the request.
+         * @return                  Client-side status.
+         */
+        uaf::Status write(
+                const uaf::PreparedAddresses&                       prepared,
+                const std::vector<uaf::Variant>&                    data,
+                const uaf::attributeids::AttributeId                attributeId,
+                uaf::ClientConnectionId                             clientConnectionId,
+                const uaf::WriteSettings*                           serviceSettings,
+                const uaf::SessionSettings*                         sessionSettings,
+                uaf::WriteResult&                                   result);
+
+
+        /**
+         * Start to monitor the data of a number of prepared addresses.
+         *
+         * The monitored items are created for the original addresses (so that they are
+         * re-created correctly in the background if their server is restarted, just like the
+         * monitored items that are created by the other createMonitoredData() method).
+         *
+         * @param prepared                  The prepared addresses of the nodes of which the Value
+         *                                  attribute should be monitored.
+         * @param serviceSettings           Create monitored data settings.
+         * @param translateSettings         Translate browse paths settings.
+         * @param sessionSettings           Session settings.
+         * @param subscriptionSettings      Subscription settings.
+         * @param result                    Result of the request.
+         * @return                          Client-side status.
+         */
+        uaf::Status createMonitoredData(
+                const uaf::PreparedAddresses&                       prepared,
+                uaf::ClientConnectionId                             clientConnectionId,
+                const uaf::CreateMonitoredDataSettings*             serviceSettings,
+                const uaf::TranslateBrowsePathsToNodeIdsSettings*   translateSettings,
+                const uaf::SessionSettings*                         sessionSettings,
+                uaf::ClientSubscriptionHandle                       clientSubscriptionHandle,
+                const uaf::SubscriptionSettings*                    subscriptionSettings,
+                uaf::CreateMonitoredDataResult&                     result);
+
+#endif  /* SWIG (the section above is not visible by the SWIG preprocessor) */
 
 
         ///@} //////////////////////////////////////////////////////////////////////////////////////
@@ -719,6 +881,28 @@ namespace uaf
                 const uaf::HistoryReadRawModifiedRequest&  request,
                 uaf::HistoryReadRawModifiedResult&         result);
 
+        /**
+         * Process a synchronous RegisterNodes request.
+         *
+         * @param request   The request.
+         * @param result    The result.
+         * @return          The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::RegisterNodesRequest&           request,
+                uaf::RegisterNodesResult&                  result);
+
+        /**
+         * Process a synchronous UnregisterNodes request.
+         *
+         * @param request   The request.
+         * @param result    The result.
+         * @return          The client-side status.
+         */
+        uaf::Status processRequest(
+                const uaf::UnregisterNodesRequest&         request,
+                uaf::UnregisterNodesResult&                result);
+
 
 
         ///@} //////////////////////////////////////////////////////////////////////////////////////
@@ -1045,8 +1229,8 @@ namespace uaf
         /** The shared database of the client. */
         uaf::Database* database_;
 
-        /** The flag to finish the run() method of the thread during destruction of the client. */
-        bool doFinishThread_;
+        /** The scheduler of the periodic jobs (discovery, housekeeping, ...) of the client. */
+        uaf::Scheduler* scheduler_;
 
         /** The current request handle (only to be incremented when requestHandleMutex_ is locked). */
         uaf::RequestHandle currentRequestHandle_;
@@ -1054,10 +1238,45 @@ namespace uaf
         /** The mutex to lock when the currentRequestHandle_ is read or manipulated. */
         UaMutex requestHandleMutex_;
 
+#ifndef SWIG /* The periodic jobs do not need to be seen by SWIG. */
         /**
-         * Run method of the thread.
+         * A periodic job of the client, which calls one of the member functions of the client
+         * at the interval given by one of the client settings (e.g. discoveryIntervalSec).
          */
-        void run();
+        class PeriodicJob : public uaf::ScheduledJob
+        {
+        public:
+            typedef void (Client::*Action)();
+            typedef float uaf::ClientSettings::*Interval;
+            PeriodicJob(uaf::Client* client, Action action, Interval interval)
+            : client_(client), action_(action), interval_(interval) {}
+            double intervalSec() const;
+            void execute();
+        private:
+            uaf::Client*    client_;
+            Action          action_;
+            Interval        interval_;
+        };
+        friend class PeriodicJob;
+#endif
+
+
+        /**
+         * Periodic job: discover the servers in the system.
+         */
+        void discoverPeriodically();
+
+
+        /**
+         * Periodic job: check the sessions and subscriptions (and reconnect them if needed).
+         */
+        void doHouseKeepingPeriodically();
+
+
+        /**
+         * Periodic job: process the persisted requests (e.g. re-create monitored items).
+         */
+        void processPersistedRequestsPeriodically();
 
 
         /**
@@ -1152,6 +1371,26 @@ namespace uaf
                 typename _Service::Result&          result);
         // Private template functions can be implemented in the CPP file (keeps the header clean!)
 
+
+        /**
+         * Private templated member function to process a masked request of which the targets
+         * are already resolved (i.e. a request for prepared addresses).
+         *
+         * The request is invoked directly: it is not copied, resolved or stored.
+         *
+         * @tparam _Service The Service type, as defined in uaf/client/services/services.h.
+         * @param request   The request to be processed (it will get a new request handle).
+         * @param mask      The mask, specifying the targets that need to be processed.
+         * @param result    The result to be updated.
+         * @return          The client-side status.
+         */
+        template<typename _Service>
+        uaf::Status processPreparedRequest(
+                typename _Service::Request&         request,
+                const uaf::Mask&                    mask,
+                typename _Service::Result&          result);
+        // Private template functions can be implemented in the CPP file (keeps the header clean!)
+
 #endif  /* SWIG (the section above is not visible by the SWIG preprocessor) */
 
         ///@}
@@ -92,6 +92,8 @@ namespace uaf
     DEFINE_SYNC_SERVICE(CreateMonitoredData)
     DEFINE_SYNC_SERVICE(CreateMonitoredEvents)
     DEFINE_SYNC_SERVICE(HistoryReadRawModified)
+    DEFINE_SYNC_SERVICE(RegisterNodes)
+    DEFINE_SYNC_SERVICE(UnregisterNodes)
 
     // define the asynchronous services
     DEFINE_ASYNC_SERVICE(Read)
@@ -29,12 +29,18 @@ namespace uaf
     using std::string;
     using std::vector;
     using std::map;
+    using std::set;
     using std::size_t;
 
 
     // Constructor
     // =============================================================================================
     AddressCache::AddressCache(LoggerFactory* loggerFactory)
+    : maxEntriesPerShard_(0),
+      maxBytesPerShard_(0),
+      timeToLiveMs_(0),
+      generation_(0),
+      clearedGeneration_(0)
     {
         logger_ = new Logger(loggerFactory, "AddressCache");
         logger_->debug("The address cache has been constructed");
@@ -54,15 +60,72 @@ namespace uaf
     }
 
 
+    // Set the limits
+    // =============================================================================================
+    void AddressCache::setLimits(size_t maxEntries, size_t maxBytes, double timeToLiveSec)
+    {
+        {
+            UaMutexLocker locker(&limitsMutex_); // unlocks when locker goes out of scope
+
+            // divide the limits evenly over the shards (rounded up)
+            maxEntriesPerShard_ = (maxEntries + NUMBER_OF_SHARDS - 1) / NUMBER_OF_SHARDS;
+            maxBytesPerShard_   = (maxBytes + NUMBER_OF_SHARDS - 1) / NUMBER_OF_SHARDS;
+            timeToLiveMs_       = timeToLiveSec > 0.0 ? int64_t(timeToLiveSec * 1000.0) : 0;
+        }
+
+        logger_->debug("The cache is now limited to %d entries, %d bytes, %.3f seconds "
+                       "(0 means no limit)", maxEntries, maxBytes, timeToLiveSec);
+
+        size_t maxEntriesPerShard, maxBytesPerShard;
+        int64_t timeToLiveMs;
+        getLimits(maxEntriesPerShard, maxBytesPerShard, timeToLiveMs);
+
+        for (size_t i = 0; i < NUMBER_OF_SHARDS; i++)
+        {
+            UaMutexLocker locker(&shards_[i].mutex); // unlocks when locker goes out of scope
+            evict(shards_[i], maxEntriesPerShard, maxBytesPerShard);
+        }
+    }
+
+
+    // Get a copy of the limits
+    // =============================================================================================
+    void AddressCache::getLimits(size_t& maxEntries, size_t& maxBytes, int64_t& ttlMs) const
+    {
+        UaMutexLocker locker(&limitsMutex_); // unlocks when locker goes out of scope
+
+        maxEntries = maxEntriesPerShard_;
+        maxBytes   = maxBytesPerShard_;
+        ttlMs      = timeToLiveMs_;
+    }
+
+
     // Remove all items from the cache
     // =============================================================================================
     void AddressCache::clear()
     {
         logger_->info("Clearing the address cache");
 
-        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        for (size_t i = 0; i < NUMBER_OF_SHARDS; i++)
+        {
+            Shard& s = shards_[i];
+
+            UaMutexLocker locker(&s.mutex); // unlocks when locker goes out of scope
 
-        cache_.clear();
+            s.entries.clear();
+            s.buckets.clear();
+            s.serverIndex.clear();
+            s.statistics.entries = 0;
+            s.statistics.bytes   = 0;
+        }
+
+        UaMutexLocker locker(&namespacesMutex_); // unlocks when locker goes out of scope
+        pendingServers_.clear();
+
+        // only increment the generation after the entries have been removed, so that nobody
+        // can resolve an address from a removed entry at the new generation
+        generation_++;
+        clearedGeneration_ = generation_;
     }
 
 
@@ -72,26 +135,267 @@ namespace uaf
     {
         logger_->info("Clearing the cached addresses for ServerUri '%s':", serverUri.c_str());
 
-        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        size_t noOfRemoved = 0;
 
-        Cache::iterator it = cache_.begin();
-        while(it != cache_.end())
+        for (size_t i = 0; i < NUMBER_OF_SHARDS; i++)
         {
-            if (it->second.serverUri() == serverUri)
+            Shard& s = shards_[i];
+
+            UaMutexLocker locker(&s.mutex); // unlocks when locker goes out of scope
+
+            ServerIndex::iterator server = s.serverIndex.find(serverUri);
+
+            if (server == s.serverIndex.end())
+                continue;
+
+            // copy the entries first, since removing them also updates the server index
+            vector<Entries::iterator> entries;
+            for (map<const Entry*, Entries::iterator>::const_iterator it = server->second.begin();
+                 it != server->second.end();
+                 ++it)
             {
-                logger_->debug("Removing the address from the cache");
-                cache_.erase(it++);  // The post increment increments the iterator but returns the
-                                     // original value for use by erase
+                entries.push_back(it->second);
             }
-            else
+
+            for (size_t j = 0; j < entries.size(); j++)
+                removeEntry(s, entries[j]);
+
+            noOfRemoved += entries.size();
+        }
+
+        {
+            UaMutexLocker locker(&namespacesMutex_); // unlocks when locker goes out of scope
+            serverGenerations_[serverUri] = ++generation_;
+        }
+
+        logger_->debug("All %d cached addresses for ServerUri '%s' have been cleared",
+                       noOfRemoved, serverUri.c_str());
+
+    }
+
+
+    // Check if a (cached) node id refers to the same node as a changed node id
+    // =============================================================================================
+    static bool isSameNode(const NodeId& nodeId, const NodeId& changedNodeId)
+    {
+        if (!(nodeId.identifier() == changedNodeId.identifier()))
+            return false;
+        else if (nodeId.hasNameSpaceUri() && changedNodeId.hasNameSpaceUri())
+            return nodeId.nameSpaceUri() == changedNodeId.nameSpaceUri();
+        else if (nodeId.hasNameSpaceIndex() && changedNodeId.hasNameSpaceIndex())
+            return nodeId.nameSpaceIndex() == changedNodeId.nameSpaceIndex();
+        else
+            return true; // can't tell, so better safe than sorry
+    }
+
+
+    // Check if a (cached) node id refers to any of the changed node ids
+    // =============================================================================================
+    static bool isAnyNode(const NodeId& nodeId, const vector<NodeId>& changedNodeIds)
+    {
+        for (vector<NodeId>::const_iterator it = changedNodeIds.begin();
+             it != changedNodeIds.end();
+             ++it)
+        {
+            if (isSameNode(nodeId, *it))
+                return true;
+        }
+
+        return false;
+    }
+
+
+    // Check if an address is (or starts from) one of the given nodes
+    // =============================================================================================
+    bool AddressCache::startsFrom(const Address& address, const vector<NodeId>& nodeIds)
+    {
+        if (address.isRelativePath())
+            return startsFrom(*address.getStartingAddress(), nodeIds);
+        else
+            return isAnyNode(address.getExpandedNodeId().nodeId(), nodeIds);
+    }
+
+
+    // Remove the cached addresses that are affected by a change of the given nodes
+    // =============================================================================================
+    size_t AddressCache::invalidate(const string& serverUri, const vector<NodeId>& nodeIds)
+    {
+        logger_->debug("Invalidating the cached addresses of %d changed nodes of ServerUri '%s'",
+                       nodeIds.size(), serverUri.c_str());
+
+        size_t noOfRemoved = 0;
+
+        for (size_t i = 0; i < NUMBER_OF_SHARDS && !nodeIds.empty(); i++)
+        {
+            Shard& s = shards_[i];
+
+            UaMutexLocker locker(&s.mutex); // unlocks when locker goes out of scope
+
+            ServerIndex::iterator server = s.serverIndex.find(serverUri);
+
+            if (server == s.serverIndex.end())
+                continue;
+
+            // collect the affected entries first, since removing them updates the server index
+            vector<Entries::iterator> entries;
+            for (map<const Entry*, Entries::iterator>::const_iterator it = server->second.begin();
+                 it != server->second.end();
+                 ++it)
             {
-                ++it; // Can use pre-increment here to make sure you have the efficient version
+                const Entry& entry = *(it->second);
+
+                if (   isAnyNode(entry.expandedNodeId.nodeId(), nodeIds)
+                    || startsFrom(entry.address, nodeIds))
+                {
+                    entries.push_back(it->second);
+                }
             }
+
+            for (size_t j = 0; j < entries.size(); j++)
+                removeEntry(s, entries[j]);
+
+            noOfRemoved += entries.size();
+        }
+
+        // also if nothing was removed, since others may have resolved the changed nodes
+        {
+            UaMutexLocker locker(&namespacesMutex_); // unlocks when locker goes out of scope
+            serverGenerations_[serverUri] = ++generation_;
         }
 
-        logger_->debug("All cached addresses for ServerUri '%s' have been cleared",
-                       serverUri.c_str());
+        logger_->debug("%d cached addresses for ServerUri '%s' have been invalidated",
+                       noOfRemoved, serverUri.c_str());
+
+        return noOfRemoved;
+    }
+
 
+    // Estimate the number of bytes of an ExpandedNodeId
+    // =============================================================================================
+    static size_t estimateNodeIdBytes(const ExpandedNodeId& expandedNodeId)
+    {
+        NodeId nodeId = expandedNodeId.nodeId();
+        NodeIdIdentifier identifier = nodeId.identifier();
+
+        return   sizeof(ExpandedNodeId)
+               + expandedNodeId.serverUri().size()
+               + nodeId.nameSpaceUri().size()
+               + identifier.idString.size()
+               + identifier.idOpaque.length();
+    }
+
+
+    // Estimate the number of bytes of an Address
+    // =============================================================================================
+    size_t AddressCache::estimateBytes(const Address& address)
+    {
+        size_t bytes = sizeof(Address);
+
+        if (address.isRelativePath())
+        {
+            vector<RelativePathElement> relativePath = address.getRelativePath();
+
+            for (vector<RelativePathElement>::const_iterator it = relativePath.begin();
+                 it != relativePath.end();
+                 ++it)
+            {
+                bytes +=   sizeof(RelativePathElement)
+                         + it->targetName.name().size()
+                         + it->targetName.nameSpaceUri().size()
+                         + it->referenceType.nameSpaceUri().size()
+                         + it->referenceType.identifier().idString.size();
+            }
+
+            bytes += estimateBytes(*address.getStartingAddress());
+        }
+        else
+        {
+            bytes += estimateNodeIdBytes(address.getExpandedNodeId());
+        }
+
+        return bytes;
+    }
+
+
+    // Find an address in a shard
+    // =============================================================================================
+    AddressCache::Entries::iterator AddressCache::findEntry(Shard& shard, const Address& address)
+    {
+        Buckets::iterator bucket = shard.buckets.find(address.hash());
+
+        if (bucket == shard.buckets.end())
+            return shard.entries.end();
+
+        // only the addresses with the same hash need to be compared in full
+        for (vector<Entries::iterator>::iterator it = bucket->second.begin();
+             it != bucket->second.end();
+             ++it)
+        {
+            if ((*it)->address == address)
+            {
+                Entries::iterator entry = *it;
+
+                if (entry->expiryTime != 0 && int64_t(UaDateTime::now()) >= entry->expiryTime)
+                {
+                    removeEntry(shard, entry);
+                    shard.statistics.expirations++;
+                    return shard.entries.end();
+                }
+
+                // move the entry to the front, as it's now the most recently used one
+                shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+                return entry;
+            }
+        }
+
+        return shard.entries.end();
+    }
+
+
+    // Remove an entry from a shard
+    // =============================================================================================
+    void AddressCache::removeEntry(Shard& shard, Entries::iterator entry)
+    {
+        Buckets::iterator bucket = shard.buckets.find(entry->address.hash());
+        if (bucket != shard.buckets.end())
+        {
+            vector<Entries::iterator>& entries = bucket->second;
+            entries.erase(std::remove(entries.begin(), entries.end(), entry), entries.end());
+
+            if (entries.empty())
+                shard.buckets.erase(bucket);
+        }
+
+        ServerIndex::iterator server = shard.serverIndex.find(entry->expandedNodeId.serverUri());
+        if (server != shard.serverIndex.end())
+        {
+            server->second.erase(&(*entry));
+
+            if (server->second.empty())
+                shard.serverIndex.erase(server);
+        }
+
+        shard.statistics.entries--;
+        shard.statistics.bytes -= entry->bytes;
+
+        shard.entries.erase(entry);
+    }
+
+
+    // Evict the least recently used entries
+    // =============================================================================================
+    void AddressCache::evict(Shard& shard, size_t maxEntries, size_t maxBytes)
+    {
+        while (   !shard.entries.empty()
+               && (   (maxEntries > 0 && shard.statistics.entries > maxEntries)
+                   || (maxBytes > 0   && shard.statistics.bytes   > maxBytes)))
+        {
+            Entries::iterator leastRecentlyUsed = shard.entries.end();
+            --leastRecentlyUsed;
+
+            removeEntry(shard, leastRecentlyUsed);
+            shard.statistics.evictions++;
+        }
     }
 
 
@@ -102,16 +406,68 @@ namespace uaf
             const ExpandedNodeId&   expandedNodeId,
             bool                    replaceIfExists)
     {
+        size_t maxEntries, maxBytes;
+        int64_t timeToLiveMs;
+        getLimits(maxEntries, maxBytes, timeToLiveMs);
 
-        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        int64_t expiryTime = 0;
+        if (timeToLiveMs > 0)
+            expiryTime = int64_t(UaDateTime::now()) + timeToLiveMs * 10000; // 100 ns ticks
 
-        Cache::iterator iter = cache_.find(address);
+        Shard& s = shard(address.hash());
 
-        if (iter == cache_.end() || replaceIfExists)
+        UaMutexLocker locker(&s.mutex); // unlocks when locker goes out of scope
+
+        Entries::iterator entry = findEntry(s, address);
+
+        if (entry == s.entries.end())
         {
             logger_->info("The address is now cached");
 
-            cache_[address] = expandedNodeId;
+            Entry newEntry;
+            newEntry.address        = address;
+            newEntry.expandedNodeId = expandedNodeId;
+            newEntry.bytes          =   sizeof(Entry)
+                                      + estimateBytes(address)
+                                      + estimateNodeIdBytes(expandedNodeId);
+            newEntry.expiryTime     = expiryTime;
+
+            s.entries.push_front(newEntry);
+            entry = s.entries.begin();
+
+            s.buckets[address.hash()].push_back(entry);
+            s.serverIndex[expandedNodeId.serverUri()][&(*entry)] = entry;
+            s.statistics.entries++;
+            s.statistics.bytes += entry->bytes;
+
+            evict(s, maxEntries, maxBytes);
+        }
+        else if (replaceIfExists)
+        {
+            logger_->info("The address is now cached");
+
+            // the entry may belong to another server now
+            ServerIndex::iterator server = s.serverIndex.find(entry->expandedNodeId.serverUri());
+            if (server != s.serverIndex.end())
+            {
+                server->second.erase(&(*entry));
+
+                if (server->second.empty())
+                    s.serverIndex.erase(server);
+            }
+
+            s.statistics.bytes -= entry->bytes;
+
+            entry->expandedNodeId = expandedNodeId;
+            entry->bytes          =   sizeof(Entry)
+                                    + estimateBytes(address)
+                                    + estimateNodeIdBytes(expandedNodeId);
+            entry->expiryTime     = expiryTime;
+
+            s.serverIndex[expandedNodeId.serverUri()][&(*entry)] = entry;
+            s.statistics.bytes += entry->bytes;
+
+            evict(s, maxEntries, maxBytes);
         }
         else
         {
@@ -143,20 +499,42 @@ namespace uaf
     // =============================================================================================
     bool AddressCache::find(const Address& address, uaf::ExpandedNodeId& expandedNodeId)
     {
-        logger_->debug("Trying to find the following address in the cache (size=%d)", cache_.size());
-        logger_->debug(address.toString());
+        bool found;
+
+        {
+            Shard& s = shard(address.hash());
+
+            UaMutexLocker locker(&s.mutex); // unlocks when locker goes out of scope
+
+            Entries::iterator entry = findEntry(s, address);
 
-        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            found = (entry != s.entries.end());
 
-        Cache::const_iterator iter = cache_.find(address);
+            if (found)
+            {
+                expandedNodeId = entry->expandedNodeId;
+                s.statistics.hits++;
+            }
+            else
+            {
+                s.statistics.misses++;
+            }
+        }
 
-        bool found = (iter != cache_.end());
+        // log outside the lock, and only if needed (converting the address is expensive)
+        if (logger_->isDebugEnabled())
+        {
+            logger_->debug("Tried to find the following address in the cache:");
+            logger_->debug(address.toString());
+        }
 
         if (found)
         {
-            expandedNodeId = iter->second;
-            logger_->info("The address was found in the cache");
-            logger_->info("It corresponds to %s", expandedNodeId.toString().c_str());
+            if (logger_->checkLevel(uaf::loglevels::Info))
+            {
+                logger_->info("The address was found in the cache");
+                logger_->info("It corresponds to %s", expandedNodeId.toString().c_str());
+            }
         }
         else
         {
@@ -167,8 +545,410 @@ namespace uaf
     }
 
 
+    // Find the resolved ExpandedNodeIds for a number of addresses
+    // =============================================================================================
+    size_t AddressCache::find(
+            const vector<Address>&  addresses,
+            vector<ExpandedNodeId>& expandedNodeIds,
+            Mask&                   foundMask)
+    {
+        foundMask = Mask(addresses.size());
 
+        // group the addresses per shard
+        vector<size_t> ranksPerShard[NUMBER_OF_SHARDS];
+        for (size_t i = 0; i < addresses.size(); i++)
+            ranksPerShard[addresses[i].hash() % NUMBER_OF_SHARDS].push_back(i);
 
-}
+        size_t noOfFound = 0;
 
+        // lock every shard only once
+        for (size_t i = 0; i < NUMBER_OF_SHARDS; i++)
+        {
+            const vector<size_t>& ranks = ranksPerShard[i];
 
+            if (ranks.empty())
+                continue;
+
+            Shard& s = shards_[i];
+
+            UaMutexLocker locker(&s.mutex); // unlocks when locker goes out of scope
+
+            for (vector<size_t>::const_iterator rank = ranks.begin(); rank != ranks.end(); ++rank)
+            {
+                Entries::iterator entry = findEntry(s, addresses[*rank]);
+
+                if (entry != s.entries.end())
+                {
+                    expandedNodeIds[*rank] = entry->expandedNodeId;
+                    foundMask.set(*rank);
+                    noOfFound++;
+                    s.statistics.hits++;
+                }
+                else
+                {
+                    s.statistics.misses++;
+                }
+            }
+        }
+
+        logger_->debug("%d of %d addresses were found in the cache", noOfFound, addresses.size());
+
+        return noOfFound;
+    }
+
+
+    // Get the statistics
+    // =============================================================================================
+    AddressCache::Statistics AddressCache::statistics() const
+    {
+        Statistics ret;
+
+        for (size_t i = 0; i < NUMBER_OF_SHARDS; i++)
+        {
+            UaMutexLocker locker(&shards_[i].mutex); // unlocks when locker goes out of scope
+
+            const Statistics& s = shards_[i].statistics;
+            ret.entries     += s.entries;
+            ret.bytes       += s.bytes;
+            ret.hits        += s.hits;
+            ret.misses      += s.misses;
+            ret.evictions   += s.evictions;
+            ret.expirations += s.expirations;
+        }
+
+        return ret;
+    }
+
+
+    // Collect the namespace index of a node id, if it depends on the namespace array
+    // =============================================================================================
+    static void collectNamespaceIndexes(const NodeId& nodeId, set<NameSpaceIndex>& indexes)
+    {
+        // namespace 0 is always the OPC UA namespace
+        if (!nodeId.hasNameSpaceUri() && nodeId.nameSpaceIndex() != 0)
+            indexes.insert(nodeId.nameSpaceIndex());
+    }
+
+
+    // Collect the namespace indexes of an address that depend on the namespace array
+    // =============================================================================================
+    static void collectNamespaceIndexes(const Address& address, set<NameSpaceIndex>& indexes)
+    {
+        if (address.isRelativePath())
+        {
+            collectNamespaceIndexes(*address.getStartingAddress(), indexes);
+
+            vector<RelativePathElement> relativePath = address.getRelativePath();
+            for (vector<RelativePathElement>::const_iterator it = relativePath.begin();
+                 it != relativePath.end();
+                 ++it)
+            {
+                if (!it->targetName.hasNameSpaceUri() && it->targetName.nameSpaceIndex() != 0)
+                    indexes.insert(it->targetName.nameSpaceIndex());
+
+                collectNamespaceIndexes(it->referenceType, indexes);
+            }
+        }
+        else
+        {
+            collectNamespaceIndexes(address.getExpandedNodeId().nodeId(), indexes);
+        }
+    }
+
+
+    // Check if the namespace indexes refer to the same namespace URIs in both maps
+    // =============================================================================================
+    static bool haveSameUris(
+            const set<NameSpaceIndex>&  indexes,
+            const NameSpaceMap&         map1,
+            const NameSpaceMap&         map2)
+    {
+        for (set<NameSpaceIndex>::const_iterator it = indexes.begin(); it != indexes.end(); ++it)
+        {
+            NameSpaceMap::const_iterator uri1 = map1.find(*it);
+            NameSpaceMap::const_iterator uri2 = map2.find(*it);
+
+            if (uri1 == map1.end() || uri2 == map2.end() || uri1->second != uri2->second)
+                return false;
+        }
+
+        return true;
+    }
+
+
+    // Add the loaded entries that are still valid
+    // =============================================================================================
+    size_t AddressCache::addValidEntries(
+            const AddressCacheFile::Server& loaded,
+            const NameSpaceMap&             currentNameSpaceMap)
+    {
+        size_t noOfAdded = 0;
+
+        for (size_t i = 0; i < loaded.addresses.size(); i++)
+        {
+            set<NameSpaceIndex> indexes;
+            collectNamespaceIndexes(loaded.addresses[i], indexes);
+            collectNamespaceIndexes(loaded.expandedNodeIds[i].nodeId(), indexes);
+
+            if (haveSameUris(indexes, loaded.nameSpaceMap, currentNameSpaceMap))
+            {
+                add(loaded.addresses[i], loaded.expandedNodeIds[i]);
+                noOfAdded++;
+            }
+        }
+
+        return noOfAdded;
+    }
+
+
+    // Store the current namespace array of a server
+    // =============================================================================================
+    void AddressCache::setNamespaceArray(
+            const string&           serverUri,
+            const NamespaceArray&   namespaceArray)
+    {
+        AddressCacheFile::Server pending;
+        bool hasPending = false;
+
+        {
+            UaMutexLocker locker(&namespacesMutex_); // unlocks when locker goes out of scope
+
+            map<string, NamespaceArray>::const_iterator previous
+                = namespaceArrays_.find(serverUri);
+
+            if (   previous == namespaceArrays_.end()
+                || previous->second.nameSpaceMap() != namespaceArray.nameSpaceMap())
+            {
+                namespaceArrays_[serverUri] = namespaceArray;
+                serverGenerations_[serverUri] = ++generation_;
+            }
+
+            map<string, AddressCacheFile::Server>::iterator it = pendingServers_.find(serverUri);
+            if (it != pendingServers_.end())
+            {
+                pending = it->second;
+                pendingServers_.erase(it);
+                hasPending = true;
+            }
+        }
+
+        if (hasPending)
+        {
+            size_t noOfAdded = addValidEntries(pending, namespaceArray.nameSpaceMap());
+
+            logger_->debug("%d of %d loaded addresses of ServerUri '%s' are still valid for the "
+                           "current namespace array", noOfAdded, pending.addresses.size(),
+                           serverUri.c_str());
+        }
+    }
+
+
+    // Get the current namespace array of a server
+    // =============================================================================================
+    bool AddressCache::findNamespaceArray(
+            const string&   serverUri,
+            NamespaceArray& namespaceArray) const
+    {
+        UaMutexLocker locker(&namespacesMutex_); // unlocks when locker goes out of scope
+
+        map<string, NamespaceArray>::const_iterator it = namespaceArrays_.find(serverUri);
+
+        if (it == namespaceArrays_.end())
+            return false;
+
+        namespaceArray = it->second;
+        return true;
+    }
+
+
+    // Get the current generation
+    // =============================================================================================
+    uint64_t AddressCache::generation() const
+    {
+        UaMutexLocker locker(&namespacesMutex_); // unlocks when locker goes out of scope
+        return generation_;
+    }
+
+
+    // Get the generation of a server
+    // =============================================================================================
+    uint64_t AddressCache::generation(const string& serverUri) const
+    {
+        UaMutexLocker locker(&namespacesMutex_); // unlocks when locker goes out of scope
+
+        map<string, uint64_t>::const_iterator it = serverGenerations_.find(serverUri);
+
+        if (it == serverGenerations_.end() || it->second < clearedGeneration_)
+            return clearedGeneration_;
+        else
+            return it->second;
+    }
+
+
+    // Save the cache to a file
+    // =============================================================================================
+    Status AddressCache::save(const string& fileName)
+    {
+        logger_->debug("Saving the address cache to '%s'", fileName.c_str());
+
+        map<string, AddressCacheFile::Server> servers;
+
+        int64_t now = int64_t(UaDateTime::now());
+
+        for (size_t i = 0; i < NUMBER_OF_SHARDS; i++)
+        {
+            Shard& s = shards_[i];
+
+            UaMutexLocker locker(&s.mutex); // unlocks when locker goes out of scope
+
+            // from the least to the most recently used entry, so that the order is restored
+            // when the entries are added again
+            for (Entries::reverse_iterator it = s.entries.rbegin(); it != s.entries.rend(); ++it)
+            {
+                if (it->expiryTime != 0 && now >= it->expiryTime)
+                    continue;
+
+                AddressCacheFile::Server& server = servers[it->expandedNodeId.serverUri()];
+                server.addresses.push_back(it->address);
+                server.expandedNodeIds.push_back(it->expandedNodeId);
+            }
+        }
+
+        {
+            UaMutexLocker locker(&namespacesMutex_); // unlocks when locker goes out of scope
+
+            for (map<string, AddressCacheFile::Server>::iterator it = servers.begin();
+                 it != servers.end();
+                 ++it)
+            {
+                map<string, NamespaceArray>::const_iterator namespaceArray
+                    = namespaceArrays_.find(it->first);
+
+                if (namespaceArray != namespaceArrays_.end())
+                    it->second.nameSpaceMap = namespaceArray->second.nameSpaceMap();
+            }
+
+            // the loaded entries that are still pending (because their server has not been
+            // connected) are saved again, with the namespace array they were resolved with
+            for (map<string, AddressCacheFile::Server>::const_iterator it = pendingServers_.begin();
+                 it != pendingServers_.end();
+                 ++it)
+            {
+                AddressCacheFile::Server& server = servers[it->first];
+
+                if (server.nameSpaceMap.empty())
+                    server.nameSpaceMap = it->second.nameSpaceMap;
+
+                server.addresses.insert(server.addresses.end(),
+                                        it->second.addresses.begin(),
+                                        it->second.addresses.end());
+                server.expandedNodeIds.insert(server.expandedNodeIds.end(),
+                                              it->second.expandedNodeIds.begin(),
+                                              it->second.expandedNodeIds.end());
+            }
+        }
+
+        vector<AddressCacheFile::Server> serverVector;
+        size_t noOfAddresses = 0;
+        for (map<string, AddressCacheFile::Server>::iterator it = servers.begin();
+             it != servers.end();
+             ++it)
+        {
+            it->second.serverUri = it->first;
+            noOfAddresses += it->second.addresses.size();
+            serverVector.push_back(it->second);
+        }
+
+        Status ret = AddressCacheFile::write(fileName, serverVector);
+
+        if (ret.isGood())
+            logger_->debug("%d addresses of %d servers have been saved", noOfAddresses,
+                           serverVector.size());
+        else
+            logger_->error(ret);
+
+        return ret;
+    }
+
+
+    // Load the cache from a file
+    // =============================================================================================
+    Status AddressCache::load(const string& fileName)
+    {
+        logger_->debug("Loading the address cache from '%s'", fileName.c_str());
+
+        vector<AddressCacheFile::Server> servers;
+        Status ret = AddressCacheFile::read(fileName, servers);
+
+        if (ret.isBad())
+        {
+            logger_->error(ret);
+            return ret;
+        }
+
+        size_t noOfAdded = 0, noOfPending = 0;
+
+        for (vector<AddressCacheFile::Server>::const_iterator server = servers.begin();
+             server != servers.end();
+             ++server)
+        {
+            // split the entries into the ones that can be used immediately, and the ones that
+            // must wait until the namespace array of the server is known
+            AddressCacheFile::Server pending;
+            pending.serverUri    = server->serverUri;
+            pending.nameSpaceMap = server->nameSpaceMap;
+
+            for (size_t i = 0; i < server->addresses.size(); i++)
+            {
+                set<NameSpaceIndex> indexes;
+                collectNamespaceIndexes(server->addresses[i], indexes);
+                collectNamespaceIndexes(server->expandedNodeIds[i].nodeId(), indexes);
+
+                if (indexes.empty())
+                {
+                    add(server->addresses[i], server->expandedNodeIds[i]);
+                    noOfAdded++;
+                }
+                else
+                {
+                    pending.addresses.push_back(server->addresses[i]);
+                    pending.expandedNodeIds.push_back(server->expandedNodeIds[i]);
+                }
+            }
+
+            if (pending.addresses.empty())
+                continue;
+
+            // if the namespace array is known already, the entries can be validated now
+            NameSpaceMap currentNameSpaceMap;
+            bool isKnown;
+            {
+                UaMutexLocker locker(&namespacesMutex_); // unlocks when out of scope
+
+                map<string, NamespaceArray>::const_iterator it
+                    = namespaceArrays_.find(server->serverUri);
+
+                isKnown = (it != namespaceArrays_.end());
+
+                if (isKnown)
+                    currentNameSpaceMap = it->second.nameSpaceMap();
+                else
+                    pendingServers_[server->serverUri] = pending;
+            }
+
+            if (isKnown)
+                noOfAdded += addValidEntries(pending, currentNameSpaceMap);
+            else
+                noOfPending += pending.addresses.size();
+        }
+
+        logger_->debug("%d addresses have been loaded, %d are waiting for the namespace array "
+                       "of their server", noOfAdded, noOfPending);
+
+        return ret;
+    }
+
+
+
+
+}
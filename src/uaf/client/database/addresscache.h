@@ -25,15 +25,24 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <list>
+#include <algorithm>
 #include <map>
+#include <set>
+#include <stdint.h>
 // SDK
 #include "uabase/uamutex.h"
+#include "uabase/uadatetime.h"
 // UAF
+#include "uaf/util/nodeid.h"
 #include "uaf/util/expandednodeid.h"
 #include "uaf/util/status.h"
 #include "uaf/util/logger.h"
 #include "uaf/util/address.h"
+#include "uaf/util/mask.h"
+#include "uaf/util/namespacearray.h"
 #include "uaf/client/clientexport.h"
+#include "uaf/client/database/addresscachefile.h"
 
 
 namespace uaf
@@ -44,6 +53,30 @@ namespace uaf
     * A uaf::AddressCache can speed up address resolution by storing the ExpandedNodeId for each
     * Address.
     *
+    * The cache is split into a number of shards, each with its own mutex, so that concurrent
+    * lookups rarely need to wait for each other. Within a shard, the addresses are looked up by
+    * their hash (see uaf::Address::hash()), so they only need to be compared in full with the
+    * (few) addresses that have the same hash.
+    *
+    * The size of the cache can be limited (see setLimits()): when a shard holds too many entries
+    * (or too many bytes), its least recently used entries are evicted. The limits are divided
+    * evenly over the shards. Entries may also expire after a fixed time. Each shard keeps an
+    * index of its entries per server URI, so clearing the entries of a single server doesn't
+    * need to visit the entries of other servers.
+    *
+    * The cache can be saved to a file and loaded again (see uaf::AddressCacheFile), so that a
+    * restarted client doesn't need to resolve all addresses again. The loaded entries that only
+    * refer to namespace URIs (or to namespace 0) are used immediately. The other ones refer to
+    * namespace indexes, which are only valid as long as the namespace array of the server
+    * doesn't change. They are kept aside until the current namespace array of their server is
+    * known (see setNamespaceArray()), and only the ones whose namespace indexes still refer to
+    * the same namespace URIs are added to the cache.
+    *
+    * The cache also keeps a generation counter, which is incremented every time cached
+    * addresses of a server are cleared or invalidated, or the namespace array of a server has
+    * changed. Those who keep resolved addresses themselves (such as the prepared addresses of
+    * the uaf::Client) can use it to find out whether their resolved addresses may be outdated.
+    *
     * @ingroup ClientDatabase
     ***********************************************************************************************/
     class UAF_EXPORT AddressCache
@@ -51,9 +84,34 @@ namespace uaf
     public:
 
 
+        /**
+         * The statistics of the cache.
+         */
+        struct Statistics
+        {
+            Statistics() : entries(0), bytes(0), hits(0), misses(0), evictions(0), expirations(0)
+            {}
+
+            /** The number of cached entries. */
+            std::size_t entries;
+            /** The (estimated) number of bytes used by the cached entries. */
+            std::size_t bytes;
+            /** The number of addresses that were found. */
+            uint64_t hits;
+            /** The number of addresses that were not found (including the expired ones). */
+            uint64_t misses;
+            /** The number of entries that were evicted because the cache was full. */
+            uint64_t evictions;
+            /** The number of entries that were removed because they had expired. */
+            uint64_t expirations;
+        };
+
+
         /**
          * Create an address cache which logs to the specified logger factory.
          *
+         * The cache is not limited, until setLimits() is called.
+         *
          * @param loggerFactory The logger factory to log to.
          */
         AddressCache(uaf::LoggerFactory* loggerFactory);
@@ -65,6 +123,20 @@ namespace uaf
         virtual ~AddressCache();
 
 
+        /**
+         * Limit the size of the cache, and the time during which entries remain valid.
+         *
+         * If the cache holds too many entries already, the least recently used ones are evicted
+         * immediately. The time to live only applies to the entries that are added afterwards.
+         *
+         * @param maxEntries    The maximum number of entries (0 for no limit).
+         * @param maxBytes      The maximum (estimated) number of bytes (0 for no limit).
+         * @param timeToLiveSec The time after which an entry expires, in seconds (0 or less
+         *                      to never expire).
+         */
+        void setLimits(std::size_t maxEntries, std::size_t maxBytes, double timeToLiveSec);
+
+
         /**
          * Clear the cache.
          */
@@ -77,6 +149,23 @@ namespace uaf
         void clear(const std::string& serverUri);
 
 
+        /**
+         * Remove the cached addresses of a server that are affected by a change of the given
+         * nodes (e.g. because a GeneralModelChangeEvent or SemanticChangeEvent was received).
+         *
+         * An address is affected if it was resolved to one of the nodes, or if it is (or starts
+         * from) one of the nodes. Nodes that have a namespace URI are compared by namespace URI,
+         * other nodes by namespace index.
+         *
+         * @param serverUri The server URI of the changed nodes.
+         * @param nodeIds   The nodes that have changed.
+         * @return          The number of cached addresses that were removed.
+         */
+        std::size_t invalidate(
+                const std::string&                  serverUri,
+                const std::vector<uaf::NodeId>&     nodeIds);
+
+
         /**
          * Add an address (and its resolved ExpandedNodeId) to the cache.
          *
@@ -113,6 +202,102 @@ namespace uaf
         bool find(const uaf::Address& address, uaf::ExpandedNodeId& expandedNodeId);
 
 
+        /**
+         * Find the resolved expanded node ids of a number of addresses in the cache.
+         *
+         * The addresses are grouped per shard, so that every shard is locked only once.
+         *
+         * @param addresses         The addresses to look up.
+         * @param expandedNodeIds   The found expandedNodeIds (only the ones of the found addresses
+         *                          are updated). The vector must have the same size as the
+         *                          addresses.
+         * @param foundMask         Output parameter: the mask is resized to the number of
+         *                          addresses, and the found addresses are set.
+         * @return                  The number of addresses that were found.
+         */
+        std::size_t find(
+                const std::vector<uaf::Address>&    addresses,
+                std::vector<uaf::ExpandedNodeId>&   expandedNodeIds,
+                uaf::Mask&                          foundMask);
+
+
+        /**
+         * Store the current namespace array of a server (e.g. because a session to the server
+         * has been connected).
+         *
+         * The loaded entries of the server that are still waiting for validation, are now
+         * validated against the namespace array.
+         *
+         * @param serverUri         The server URI.
+         * @param namespaceArray    The current namespace array of the server.
+         */
+        void setNamespaceArray(
+                const std::string&          serverUri,
+                const uaf::NamespaceArray&  namespaceArray);
+
+
+        /**
+         * Get the current namespace array of a server (as stored by setNamespaceArray()).
+         *
+         * @param serverUri         The server URI.
+         * @param namespaceArray    Output parameter: the namespace array of the server.
+         * @return                  True if the namespace array of the server is known.
+         */
+        bool findNamespaceArray(
+                const std::string&      serverUri,
+                uaf::NamespaceArray&    namespaceArray) const;
+
+
+        /**
+         * Get the current generation of the cache.
+         *
+         * @return  A counter that is incremented every time cached addresses are cleared or
+         *          invalidated, or the namespace array of a server has changed.
+         */
+        uint64_t generation() const;
+
+
+        /**
+         * Get the generation at which the cached addresses of a server were cleared or
+         * invalidated for the last time, or the namespace array of the server has changed.
+         *
+         * Addresses that were resolved while the generation() of the cache was G, are still
+         * valid as long as the generation of their server is not higher than G.
+         *
+         * @param serverUri The server URI.
+         * @return          The generation of the server (0 if nothing has changed yet).
+         */
+        uint64_t generation(const std::string& serverUri) const;
+
+
+        /**
+         * Save the cached addresses (including the loaded ones that are still waiting for
+         * validation) to a file. Expired entries are not saved.
+         *
+         * @param fileName  The name of the file.
+         * @return          Good if the file was written, bad if not.
+         */
+        uaf::Status save(const std::string& fileName);
+
+
+        /**
+         * Load the cached addresses from a file (that was written by save()). The entries that
+         * are cached already are not replaced.
+         *
+         * @param fileName  The name of the file.
+         * @return          Good if the file was read, bad if not.
+         */
+        uaf::Status load(const std::string& fileName);
+
+
+        /**
+         * Get the statistics of the cache.
+         *
+         * @return  The current size of the cache, and the counters since it was constructed.
+         */
+        Statistics statistics() const;
+
+
 
     private:
 
@@ -124,8 +309,89 @@ namespace uaf
         // private typedefs
 
 
-        /** A cache stores the addresses and their corresponding ExpandedNodeIds. */
-        typedef std::map<uaf::Address, uaf::ExpandedNodeId> Cache;
+        /** An entry stores an address and its corresponding ExpandedNodeId. */
+        struct Entry
+        {
+            uaf::Address        address;
+            uaf::ExpandedNodeId expandedNodeId;
+            /** The (estimated) number of bytes of the entry. */
+            std::size_t         bytes;
+            /** The time when the entry expires, in 100 nanosecond ticks (0 for no expiry). */
+            int64_t             expiryTime;
+        };
+
+        /** The entries of a shard, from the most recently used to the least recently used. */
+        typedef std::list<Entry> Entries;
+
+        /** The entries of a shard, grouped by the hash of their address. */
+        typedef std::map<uint32_t, std::vector<Entries::iterator> > Buckets;
+
+        /** The entries of a shard, grouped by the server URI of their resolved node id. */
+        typedef std::map<std::string, std::map<const Entry*, Entries::iterator> > ServerIndex;
+
+        /** A shard holds a part of the cached addresses, protected by its own mutex. */
+        struct Shard
+        {
+            Entries             entries;
+            Buckets             buckets;
+            ServerIndex         serverIndex;
+            Statistics          statistics;
+            mutable UaMutex     mutex;
+        };
+
+
+        /** The number of shards. */
+        static const std::size_t NUMBER_OF_SHARDS = 16;
+
+
+        // private methods
+
+
+        /** Get the shard of a hash. */
+        Shard& shard(uint32_t hash) { return shards_[hash % NUMBER_OF_SHARDS]; }
+
+
+        /** Get a copy of the limits. */
+        void getLimits(std::size_t& maxEntries, std::size_t& maxBytes, int64_t& ttlMs) const;
+
+
+        /**
+         * Find an entry in a shard, and mark it as the most recently used one. An expired entry
+         * is removed (the mutex of the shard must be locked!).
+         *
+         * @return  The entry, or shard.entries.end() if the address was not found.
+         */
+        static Entries::iterator findEntry(Shard& shard, const uaf::Address& address);
+
+
+        /** Remove an entry from a shard (the mutex of the shard must be locked!). */
+        static void removeEntry(Shard& shard, Entries::iterator entry);
+
+
+        /**
+         * Evict the least recently used entries until the shard respects the limits (the mutex
+         * of the shard must be locked!).
+         */
+        static void evict(Shard& shard, std::size_t maxEntries, std::size_t maxBytes);
+
+
+        /** Check if an address is (or starts from) one of the given nodes. */
+        static bool startsFrom(
+                const uaf::Address&                 address,
+                const std::vector<uaf::NodeId>&     nodeIds);
+
+
+        /**
+         * Add the loaded entries of a server that are still valid according to the current
+         * namespace array of the server, and return the number of added entries.
+         */
+        std::size_t addValidEntries(
+                const uaf::AddressCacheFile::Server&    loaded,
+                const uaf::NameSpaceMap&                currentNameSpaceMap);
+
+
+        /** Estimate the number of bytes used by an address. */
+        static std::size_t estimateBytes(const uaf::Address& address);
 
 
         // private members
@@ -134,11 +400,36 @@ namespace uaf
         /** The logger of the address cache. */
         uaf::Logger* logger_;
 
-        /** The map containing the cached addresses. */
-        Cache cache_;
+        /** The shards containing the cached addresses. */
+        Shard shards_[NUMBER_OF_SHARDS];
+
+        /** The maximum number of entries per shard (0 for no limit). */
+        std::size_t maxEntriesPerShard_;
+
+        /** The maximum number of bytes per shard (0 for no limit). */
+        std::size_t maxBytesPerShard_;
+
+        /** The time to live of the entries, in milliseconds (0 for no expiry). */
+        int64_t timeToLiveMs_;
+
+        /** The mutex to safely manipulate the limits. */
+        mutable UaMutex limitsMutex_;
+
+        /** The current namespace arrays of the servers (as far as they are known). */
+        std::map<std::string, uaf::NamespaceArray> namespaceArrays_;
+
+        /** The loaded entries per server URI that are waiting for the namespace array. */
+        std::map<std::string, uaf::AddressCacheFile::Server> pendingServers_;
+
+        /** The current generation, and the generation of the last clear() of all servers. */
+        uint64_t generation_;
+        uint64_t clearedGeneration_;
+
+        /** The generation of the last change, per server URI. */
+        std::map<std::string, uint64_t> serverGenerations_;
 
-        /** The mutex to safely manipulate the map. */
-        UaMutex mutex_;
+        /** The mutex to safely manipulate the namespace arrays, pending servers and generations. */
+        mutable UaMutex namespacesMutex_;
 
     };
 
@@ -0,0 +1,512 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/database/addresscachefile.h"
+
+
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using namespace uaf::nodeididentifiertypes;
+    using std::string;
+    using std::vector;
+    using std::size_t;
+
+
+    // the magic bytes at the start of the file
+    static const char MAGIC[8] = { 'U', 'A', 'F', 'A', 'D', 'D', 'R', 'C' };
+
+    // the maximum nesting of relative addresses (to protect against corrupt files)
+    static const int MAX_ADDRESS_DEPTH = 64;
+
+    // the flags of the optional parts of node ids, qualified names and expanded node ids
+    static const uint8_t URI_GIVEN   = 0x01;
+    static const uint8_t INDEX_GIVEN = 0x02;
+
+
+    // =============================================================================================
+    // Encoding
+    // =============================================================================================
+
+
+    // Append raw bytes to the buffer
+    // =============================================================================================
+    static void putBytes(string& buffer, const void* data, size_t length)
+    {
+        buffer.append(static_cast<const char*>(data), length);
+    }
+
+
+    // Append an integer to the buffer
+    // =============================================================================================
+    template<typename _Int>
+    static void putInt(string& buffer, _Int value)
+    {
+        putBytes(buffer, &value, sizeof(value));
+    }
+
+
+    // Append a string to the buffer
+    // =============================================================================================
+    static void putString(string& buffer, const string& s)
+    {
+        putInt<uint32_t>(buffer, uint32_t(s.size()));
+        putBytes(buffer, s.data(), s.size());
+    }
+
+
+    // Append a NodeId to the buffer
+    // =============================================================================================
+    static void putNodeId(string& buffer, const NodeId& nodeId)
+    {
+        NodeIdIdentifier identifier = nodeId.identifier();
+
+        putInt<uint8_t>(buffer, uint8_t(identifier.type));
+
+        if (identifier.type == Identifier_Numeric)
+            putInt<uint32_t>(buffer, identifier.idNumeric);
+        else if (identifier.type == Identifier_String)
+            putString(buffer, identifier.idString);
+        else if (identifier.type == Identifier_Guid)
+            putString(buffer, identifier.idGuid.toString());
+        else
+        {
+            putInt<uint32_t>(buffer, uint32_t(identifier.idOpaque.length()));
+            putBytes(buffer, identifier.idOpaque.data(), identifier.idOpaque.length());
+        }
+
+        uint8_t flags = 0;
+        if (nodeId.hasNameSpaceUri())   flags |= URI_GIVEN;
+        if (nodeId.hasNameSpaceIndex()) flags |= INDEX_GIVEN;
+
+        putInt<uint8_t>(buffer, flags);
+        putString(buffer, nodeId.nameSpaceUri());
+        putInt<uint16_t>(buffer, nodeId.nameSpaceIndex());
+    }
+
+
+    // Append a QualifiedName to the buffer
+    // =============================================================================================
+    static void putQualifiedName(string& buffer, const QualifiedName& qualifiedName)
+    {
+        uint8_t flags = 0;
+        if (qualifiedName.hasNameSpaceUri())   flags |= URI_GIVEN;
+        if (qualifiedName.hasNameSpaceIndex()) flags |= INDEX_GIVEN;
+
+        putString(buffer, qualifiedName.name());
+        putInt<uint8_t>(buffer, flags);
+        putString(buffer, qualifiedName.nameSpaceUri());
+        putInt<uint16_t>(buffer, qualifiedName.nameSpaceIndex());
+    }
+
+
+    // Append an ExpandedNodeId to the buffer
+    // =============================================================================================
+    static void putExpandedNodeId(string& buffer, const ExpandedNodeId& expandedNodeId)
+    {
+        uint8_t flags = 0;
+        if (expandedNodeId.hasServerUri())   flags |= URI_GIVEN;
+        if (expandedNodeId.hasServerIndex()) flags |= INDEX_GIVEN;
+
+        putNodeId(buffer, expandedNodeId.nodeId());
+        putInt<uint8_t>(buffer, flags);
+        putString(buffer, expandedNodeId.serverUri());
+        putInt<uint32_t>(buffer, expandedNodeId.serverIndex());
+    }
+
+
+    // Append an Address to the buffer
+    // =============================================================================================
+    static void putAddress(string& buffer, const Address& address)
+    {
+        putInt<uint8_t>(buffer, address.isRelativePath() ? 1 : 0);
+
+        if (address.isRelativePath())
+        {
+            putAddress(buffer, *address.getStartingAddress());
+
+            vector<RelativePathElement> relativePath = address.getRelativePath();
+            putInt<uint32_t>(buffer, uint32_t(relativePath.size()));
+
+            for (vector<RelativePathElement>::const_iterator it = relativePath.begin();
+                 it != relativePath.end();
+                 ++it)
+            {
+                putQualifiedName(buffer, it->targetName);
+                putNodeId(buffer, it->referenceType);
+                putInt<uint8_t>(buffer, it->isInverse ? 1 : 0);
+                putInt<uint8_t>(buffer, it->includeSubtypes ? 1 : 0);
+            }
+        }
+        else
+        {
+            putExpandedNodeId(buffer, address.getExpandedNodeId());
+        }
+    }
+
+
+    // =============================================================================================
+    // Decoding
+    // =============================================================================================
+
+
+    // The state of the decoding (as soon as ok is false, all further decoding fails)
+    struct AddressCacheDecoder
+    {
+        AddressCacheDecoder(const vector<char>& data) : data(data), position(0), ok(true) {}
+
+        const vector<char>& data;
+        size_t              position;
+        bool                ok;
+    };
+
+
+    // Get raw bytes from the buffer
+    // =============================================================================================
+    static bool getBytes(AddressCacheDecoder& decoder, void* destination, size_t length)
+    {
+        if (decoder.ok && length <= decoder.data.size() - decoder.position)
+        {
+            if (length > 0)
+                memcpy(destination, &decoder.data[decoder.position], length);
+            decoder.position += length;
+        }
+        else
+        {
+            decoder.ok = false;
+        }
+
+        return decoder.ok;
+    }
+
+
+    // Get an integer from the buffer
+    // =============================================================================================
+    template<typename _Int>
+    static _Int getInt(AddressCacheDecoder& decoder)
+    {
+        _Int value = 0;
+        getBytes(decoder, &value, sizeof(value));
+        return value;
+    }
+
+
+    // Get a string from the buffer
+    // =============================================================================================
+    static string getString(AddressCacheDecoder& decoder)
+    {
+        uint32_t length = getInt<uint32_t>(decoder);
+
+        if (!decoder.ok || length > decoder.data.size() - decoder.position)
+        {
+            decoder.ok = false;
+            return string();
+        }
+
+        string s;
+        if (length > 0)
+            s.assign(&decoder.data[decoder.position], length);
+        decoder.position += length;
+        return s;
+    }
+
+
+    // Get a NodeId from the buffer
+    // =============================================================================================
+    static NodeId getNodeId(AddressCacheDecoder& decoder)
+    {
+        NodeIdIdentifier identifier;
+
+        uint8_t type = getInt<uint8_t>(decoder);
+
+        if (type == Identifier_Numeric)
+        {
+            identifier = NodeIdIdentifier(getInt<uint32_t>(decoder));
+        }
+        else if (type == Identifier_String)
+        {
+            identifier = NodeIdIdentifier(getString(decoder));
+        }
+        else if (type == Identifier_Guid)
+        {
+            identifier = NodeIdIdentifier(Guid(getString(decoder)));
+        }
+        else if (type == Identifier_Opaque)
+        {
+            uint32_t length = getInt<uint32_t>(decoder);
+            vector<uint8_t> bytes;
+            if (decoder.ok && length <= decoder.data.size() - decoder.position)
+            {
+                bytes.resize(length);
+                getBytes(decoder, length > 0 ? &bytes[0] : 0, length);
+            }
+            else
+            {
+                decoder.ok = false;
+            }
+            identifier = NodeIdIdentifier(
+                    ByteString(int32_t(bytes.size()), bytes.empty() ? 0 : &bytes[0]));
+        }
+        else
+        {
+            decoder.ok = false;
+        }
+
+        uint8_t        flags = getInt<uint8_t>(decoder);
+        string         uri   = getString(decoder);
+        NameSpaceIndex index = getInt<uint16_t>(decoder);
+
+        if ((flags & URI_GIVEN) && (flags & INDEX_GIVEN))
+            return NodeId(identifier, uri, index);
+        else if (flags & INDEX_GIVEN)
+            return NodeId(identifier, index);
+        else if (flags & URI_GIVEN)
+            return NodeId(identifier, uri);
+        else
+            return NodeId(identifier);
+    }
+
+
+    // Get a QualifiedName from the buffer
+    // =============================================================================================
+    static QualifiedName getQualifiedName(AddressCacheDecoder& decoder)
+    {
+        QualifiedName qualifiedName(getString(decoder));
+
+        uint8_t  flags = getInt<uint8_t>(decoder);
+        string   uri   = getString(decoder);
+        uint16_t index = getInt<uint16_t>(decoder);
+
+        if (flags & URI_GIVEN)
+            qualifiedName.setNameSpaceUri(uri);
+        if (flags & INDEX_GIVEN)
+            qualifiedName.setNameSpaceIndex(index);
+
+        return qualifiedName;
+    }
+
+
+    // Get an ExpandedNodeId from the buffer
+    // =============================================================================================
+    static ExpandedNodeId getExpandedNodeId(AddressCacheDecoder& decoder)
+    {
+        NodeId      nodeId = getNodeId(decoder);
+        uint8_t     flags  = getInt<uint8_t>(decoder);
+        string      uri    = getString(decoder);
+        ServerIndex index  = getInt<uint32_t>(decoder);
+
+        if ((flags & URI_GIVEN) && (flags & INDEX_GIVEN))
+            return ExpandedNodeId(nodeId, uri, index);
+        else if (flags & URI_GIVEN)
+            return ExpandedNodeId(nodeId, uri);
+        else if (flags & INDEX_GIVEN)
+            return ExpandedNodeId(nodeId, index);
+
+        ExpandedNodeId expandedNodeId;
+        expandedNodeId.setNodeId(nodeId);
+        return expandedNodeId;
+    }
+
+
+    // Get an Address from the buffer
+    // =============================================================================================
+    static Address getAddress(AddressCacheDecoder& decoder, int depth = 0)
+    {
+        uint8_t isRelativePath = getInt<uint8_t>(decoder);
+
+        if (!decoder.ok || depth > MAX_ADDRESS_DEPTH)
+        {
+            decoder.ok = false;
+            return Address();
+        }
+
+        if (isRelativePath)
+        {
+            Address startingAddress = getAddress(decoder, depth + 1);
+
+            uint32_t noOfElements = getInt<uint32_t>(decoder);
+
+            vector<RelativePathElement> relativePath;
+            for (uint32_t i = 0; i < noOfElements && decoder.ok; i++)
+            {
+                RelativePathElement element;
+                element.targetName      = getQualifiedName(decoder);
+                element.referenceType   = getNodeId(decoder);
+                element.isInverse       = getInt<uint8_t>(decoder) != 0;
+                element.includeSubtypes = getInt<uint8_t>(decoder) != 0;
+                relativePath.push_back(element);
+            }
+
+            return Address(&startingAddress, relativePath);
+        }
+        else
+        {
+            return Address(getExpandedNodeId(decoder));
+        }
+    }
+
+
+    // =============================================================================================
+    // AddressCacheFile
+    // =============================================================================================
+
+
+    // Write the cached addresses to a file
+    // =============================================================================================
+    Status AddressCacheFile::write(const string& fileName, const vector<Server>& servers)
+    {
+        string buffer;
+
+        // header
+        putBytes(buffer, MAGIC, sizeof(MAGIC));
+        putInt<uint32_t>(buffer, VERSION);
+        putInt<uint32_t>(buffer, BYTE_ORDER_MARK);
+        putInt<uint32_t>(buffer, uint32_t(servers.size()));
+
+        // servers
+        for (vector<Server>::const_iterator server = servers.begin();
+             server != servers.end();
+             ++server)
+        {
+            putString(buffer, server->serverUri);
+
+            putInt<uint32_t>(buffer, uint32_t(server->nameSpaceMap.size()));
+            for (NameSpaceMap::const_iterator it = server->nameSpaceMap.begin();
+                 it != server->nameSpaceMap.end();
+                 ++it)
+            {
+                putInt<uint16_t>(buffer, it->first);
+                putString(buffer, it->second);
+            }
+
+            putInt<uint32_t>(buffer, uint32_t(server->addresses.size()));
+            for (size_t i = 0; i < server->addresses.size(); i++)
+            {
+                putAddress(buffer, server->addresses[i]);
+                putExpandedNodeId(buffer, server->expandedNodeIds[i]);
+            }
+        }
+
+        // write the file under a temporary name first, so we never leave a half written file
+        string temporaryFileName = fileName + ".tmp";
+
+        FILE* file = fopen(temporaryFileName.c_str(), "wb");
+        if (file == 0)
+            return PathCreationError(temporaryFileName, "address cache file");
+
+        bool written = (fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size());
+        written = (fclose(file) == 0) && written;
+
+        // rename replaces an existing file atomically on POSIX systems, but fails on other
+        // platforms (e.g. Windows) if the file exists, so only then the old file is removed first
+        if (written && rename(temporaryFileName.c_str(), fileName.c_str()) != 0)
+        {
+            remove(fileName.c_str());
+            written = (rename(temporaryFileName.c_str(), fileName.c_str()) == 0);
+        }
+
+        if (!written)
+        {
+            remove(temporaryFileName.c_str());
+            return PathCreationError(fileName, "address cache file");
+        }
+
+        return statuscodes::Good;
+    }
+
+
+    // Read the cached addresses from a file
+    // =============================================================================================
+    Status AddressCacheFile::read(const string& fileName, vector<Server>& servers)
+    {
+        servers.clear();
+
+        // read the whole file into memory at once
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (file == 0)
+            return PathNotExistsError(fileName, "address cache file");
+
+        vector<char> data;
+        char block[65536];
+        size_t noOfBytes;
+        while ((noOfBytes = fread(block, 1, sizeof(block), file)) > 0)
+            data.insert(data.end(), block, block + noOfBytes);
+
+        bool readError = (ferror(file) != 0);
+        fclose(file);
+
+        if (readError)
+            return UnexpectedError(uaf::format("The address cache file '%s' could not be read",
+                                               fileName.c_str()));
+
+        AddressCacheDecoder decoder(data);
+
+        // header
+        char magic[sizeof(MAGIC)];
+        getBytes(decoder, magic, sizeof(magic));
+        uint32_t version       = getInt<uint32_t>(decoder);
+        uint32_t byteOrderMark = getInt<uint32_t>(decoder);
+        uint32_t noOfServers   = getInt<uint32_t>(decoder);
+
+        if (   !decoder.ok
+            || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+            || version != VERSION
+            || byteOrderMark != BYTE_ORDER_MARK)
+        {
+            return UnexpectedError(uaf::format("'%s' is not a compatible address cache file",
+                                               fileName.c_str()));
+        }
+
+        // servers
+        for (uint32_t i = 0; i < noOfServers && decoder.ok; i++)
+        {
+            servers.push_back(Server());
+            Server& server = servers.back();
+
+            server.serverUri = getString(decoder);
+
+            uint32_t noOfNamespaces = getInt<uint32_t>(decoder);
+            for (uint32_t j = 0; j < noOfNamespaces && decoder.ok; j++)
+            {
+                NameSpaceIndex index = getInt<uint16_t>(decoder);
+                server.nameSpaceMap[index] = getString(decoder);
+            }
+
+            uint32_t noOfAddresses = getInt<uint32_t>(decoder);
+            for (uint32_t j = 0; j < noOfAddresses && decoder.ok; j++)
+            {
+                server.addresses.push_back(getAddress(decoder));
+                server.expandedNodeIds.push_back(getExpandedNodeId(decoder));
+            }
+        }
+
+        if (!decoder.ok)
+        {
+            servers.clear();
+            return UnexpectedError(uaf::format("The address cache file '%s' is corrupt",
+                                               fileName.c_str()));
+        }
+
+        return statuscodes::Good;
+    }
+
+}
@@ -0,0 +1,120 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_ADDRESSCACHEFILE_H_
+#define UAF_ADDRESSCACHEFILE_H_
+
+// STD
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/status.h"
+#include "uaf/util/address.h"
+#include "uaf/util/expandednodeid.h"
+#include "uaf/util/namespacearray.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::AddressCacheFile reads and writes the contents of an uaf::AddressCache from and to
+    * a file, so that the resolved addresses survive a restart of the client.
+    *
+    * The file is a flat binary file (in the byte order of the host) which is read into memory
+    * in a single block and then decoded sequentially:
+    *  - a header: the magic bytes "UAFADDRC", the format version, a byte order mark and the
+    *    number of servers;
+    *  - for every server: its server URI, the namespace array that was in use when the addresses
+    *    were resolved (as index/URI pairs), and the cached addresses with their resolved
+    *    ExpandedNodeIds.
+    *
+    * Strings are stored as a 32-bit length followed by the (UTF-8) bytes. A file that was
+    * written by another version (or on a host with another byte order) is rejected.
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    class UAF_EXPORT AddressCacheFile
+    {
+    public:
+
+
+        /**
+         * The cached addresses of a single server.
+         */
+        struct Server
+        {
+            /** The server URI. */
+            std::string                         serverUri;
+            /** The namespace array of the server when the addresses were resolved (may be empty
+             *  if it was unknown). */
+            uaf::NameSpaceMap                   nameSpaceMap;
+            /** The cached addresses. */
+            std::vector<uaf::Address>           addresses;
+            /** The resolved ExpandedNodeIds of the addresses (same size as the addresses). */
+            std::vector<uaf::ExpandedNodeId>    expandedNodeIds;
+        };
+
+
+        /**
+         * Write the cached addresses to a file.
+         *
+         * The file is first written under a temporary name, and then renamed, so that an
+         * existing file is never left half written.
+         *
+         * @param fileName  The name of the file.
+         * @param servers   The cached addresses, per server.
+         * @return          Good if the file was written, bad if not.
+         */
+        static uaf::Status write(const std::string& fileName, const std::vector<Server>& servers);
+
+
+        /**
+         * Read the cached addresses from a file.
+         *
+         * @param fileName  The name of the file.
+         * @param servers   Output parameter: the cached addresses, per server.
+         * @return          Good if the file was read, bad if it doesn't exist or is invalid.
+         */
+        static uaf::Status read(const std::string& fileName, std::vector<Server>& servers);
+
+
+    private:
+
+
+        /** The format version of the file. */
+        static const uint32_t VERSION = 1;
+
+        /** The byte order mark (to detect files written on a host with another byte order). */
+        static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    };
+
+}
+
+
+#endif /* UAF_ADDRESSCACHEFILE_H_ */
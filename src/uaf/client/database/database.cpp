@@ -32,6 +32,7 @@ namespace uaf
     : createMonitoredDataRequestStore   (loggerFactory, "MonDataReqStore"),
       createMonitoredEventsRequestStore (loggerFactory, "MonEvtsReqStore"),
       addressCache                      (loggerFactory),
+      preparedAddressStore              (loggerFactory),
       clientConnectionId_(0),
       clientSubscriptionHandle_(0),
       clientHandle_(0)
@@ -30,6 +30,7 @@
 #include "uaf/client/clientservices.h"
 #include "uaf/client/database/requeststore.h"
 #include "uaf/client/database/addresscache.h"
+#include "uaf/client/database/preparedaddressstore.h"
 #include "uaf/client/settings/clientsettings.h"
 
 
@@ -69,6 +70,9 @@ namespace uaf
         /** The cache used by the resolver. */
         uaf::AddressCache addressCache;
 
+        /** The addresses that were prepared by the client. */
+        uaf::PreparedAddressStore preparedAddressStore;
+
         /** A vector storing all the client handles that were ever assigned. */
         std::vector<uaf::ClientHandle> allClientHandles;
 
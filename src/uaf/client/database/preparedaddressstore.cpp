@@ -0,0 +1,164 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/database/preparedaddressstore.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::map;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    PreparedAddressStore::Item::Item(
+            PreparedAddressesHandle handle,
+            const vector<Address>&  addresses)
+    : handle(handle),
+      addresses(addresses),
+      boundAddresses(addresses.size()),
+      statuses(addresses.size()),
+      isBound(false),
+      acquiredCount_(0),
+      isRemoved_(false)
+    {}
+
+
+    // Constructor
+    // =============================================================================================
+    PreparedAddressStore::PreparedAddressStore(LoggerFactory* loggerFactory)
+    : currentHandle_(0)
+    {
+        logger_ = new Logger(loggerFactory, "PreparedAddrStore");
+        logger_->debug("The prepared address store has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    PreparedAddressStore::~PreparedAddressStore()
+    {
+        logger_->debug("Destructing the prepared address store");
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            for (map<PreparedAddressesHandle, Item*>::iterator it = items_.begin();
+                 it != items_.end();
+                 ++it)
+            {
+                delete it->second;
+            }
+            items_.clear();
+        }
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Add an item
+    // =============================================================================================
+    PreparedAddressesHandle PreparedAddressStore::add(const vector<Address>& addresses)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        currentHandle_++;
+        items_[currentHandle_] = new Item(currentHandle_, addresses);
+
+        logger_->debug("%d addresses have been stored as prepared addresses %d",
+                       addresses.size(), currentHandle_);
+
+        return currentHandle_;
+    }
+
+
+    // Acquire an item
+    // =============================================================================================
+    Status PreparedAddressStore::acquire(PreparedAddressesHandle handle, Item*& item)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        map<PreparedAddressesHandle, Item*>::iterator it = items_.find(handle);
+
+        if (it == items_.end())
+        {
+            item = 0;
+            logger_->error("No prepared addresses with handle %d are known", handle);
+            return ItemNotFoundForTheGivenHandleError();
+        }
+
+        item = it->second;
+        item->acquiredCount_++;
+
+        return statuscodes::Good;
+    }
+
+
+    // Release an item
+    // =============================================================================================
+    void PreparedAddressStore::release(Item*& item)
+    {
+        if (item == 0)
+            return;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        item->acquiredCount_--;
+
+        // the item was removed while it was acquired, so it can only be deleted now
+        if (item->isRemoved_ && item->acquiredCount_ == 0)
+        {
+            logger_->debug("Deleting the removed prepared addresses %d", item->handle);
+            delete item;
+        }
+
+        item = 0;
+    }
+
+
+    // Remove an item
+    // =============================================================================================
+    Status PreparedAddressStore::remove(PreparedAddressesHandle handle)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        map<PreparedAddressesHandle, Item*>::iterator it = items_.find(handle);
+
+        if (it == items_.end())
+            return ItemNotFoundForTheGivenHandleError();
+
+        Item* item = it->second;
+        items_.erase(it);
+
+        if (item->acquiredCount_ == 0)
+            delete item;
+        else
+            item->isRemoved_ = true;
+
+        logger_->debug("The prepared addresses %d have been removed", handle);
+
+        return statuscodes::Good;
+    }
+
+}
@@ -0,0 +1,185 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_PREPAREDADDRESSSTORE_H_
+#define UAF_PREPAREDADDRESSSTORE_H_
+
+
+// STD
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/status.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/address.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/resolution/preparedaddresses.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::PreparedAddressStore holds the addresses that were prepared by the client (see
+    * uaf::Client::prepare()), together with their bound (i.e. resolved) addresses.
+    *
+    * The items are acquired and released (just like sessions are acquired and released from the
+    * uaf::SessionFactory), so that an item that is removed while it is being used, is only
+    * deleted when it's released.
+    *
+    * @ingroup ClientDatabase
+    ***********************************************************************************************/
+    class UAF_EXPORT PreparedAddressStore
+    {
+    public:
+
+
+        /***************************************************************************************//**
+         * A stored item holds the original addresses and their bound addresses.
+         *
+         * The bound addresses, statuses and generations may only be used or updated while the
+         * mutex of the item is locked.
+        *******************************************************************************************/
+        class UAF_EXPORT Item
+        {
+        public:
+
+            /**
+             * Construct an item for the given addresses (which are not bound yet).
+             */
+            Item(uaf::PreparedAddressesHandle handle, const std::vector<uaf::Address>& addresses);
+
+            /** The handle of the item. */
+            const uaf::PreparedAddressesHandle handle;
+
+            /** The prepared addresses, as they were given. */
+            const std::vector<uaf::Address> addresses;
+
+            /** The bound addresses: the resolved ExpandedNodeIds of the addresses (with their
+             *  namespace indexes, if the namespace array of their server is known). */
+            std::vector<uaf::Address> boundAddresses;
+
+            /** The statuses of the binding (only the addresses with a good status are bound). */
+            std::vector<uaf::Status> statuses;
+
+            /** The generation of the address cache at which the addresses of each server (as
+             *  identified by its server URI) have been bound. */
+            std::map<std::string, uint64_t> generations;
+
+            /** True if the addresses have been bound at least once. */
+            bool isBound;
+
+            /** The mutex to lock while the bound addresses are (re)bound or used. */
+            UaMutex mutex;
+
+        private:
+
+            DISALLOW_COPY_AND_ASSIGN(Item);
+
+            friend class PreparedAddressStore;
+
+            // the number of times the item has been acquired (and not released yet)
+            std::size_t acquiredCount_;
+            // true if the item has been removed from the store
+            bool        isRemoved_;
+        };
+
+
+        /**
+         * Construct an empty store.
+         *
+         * @param loggerFactory Logger factory to log all messages to.
+         */
+        PreparedAddressStore(uaf::LoggerFactory* loggerFactory);
+
+
+        /**
+         * Destruct the store and all of its items.
+         */
+        virtual ~PreparedAddressStore();
+
+
+        /**
+         * Add an item for the given addresses.
+         *
+         * @param addresses The addresses to prepare.
+         * @return          The (unique) handle of the new item.
+         */
+        uaf::PreparedAddressesHandle add(const std::vector<uaf::Address>& addresses);
+
+
+        /**
+         * Acquire the item with the given handle.
+         *
+         * The item can be used safely until it is released.
+         *
+         * @param handle    The handle of the item.
+         * @param item      Output parameter: the acquired item.
+         * @return          Good if the item was acquired, ItemNotFoundForTheGivenHandleError if
+         *                  there is no such item.
+         */
+        uaf::Status acquire(uaf::PreparedAddressesHandle handle, Item*& item);
+
+
+        /**
+         * Release an acquired item (the pointer will be set to 0).
+         *
+         * @param item  The item to release.
+         */
+        void release(Item*& item);
+
+
+        /**
+         * Remove the item with the given handle (it will be deleted as soon as it's not
+         * acquired anymore).
+         *
+         * @param handle    The handle of the item.
+         * @return          Good if the item was removed, ItemNotFoundForTheGivenHandleError if
+         *                  there is no such item.
+         */
+        uaf::Status remove(uaf::PreparedAddressesHandle handle);
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(PreparedAddressStore);
+
+
+        // the logger of the store
+        uaf::Logger*                                    logger_;
+        // the stored items
+        std::map<uaf::PreparedAddressesHandle, Item*>   items_;
+        // the handle of the last item that was added
+        uaf::PreparedAddressesHandle                    currentHandle_;
+        // the mutex to safely manipulate the items and the handle
+        UaMutex                                         mutex_;
+    };
+
+}
+
+
+#endif /* UAF_PREPAREDADDRESSSTORE_H_ */
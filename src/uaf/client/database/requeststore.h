@@ -226,6 +226,10 @@ namespace uaf
     template <typename _Service>
     void RequestStore<_Service>::logCurrentState()
     {
+        // don't build the string representations of all items if they would be thrown away
+        if (!logger_->isDebugEnabled())
+            return;
+
         logger_->debug("Current state:");
         UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
 
@@ -279,8 +283,9 @@ namespace uaf
     {
         uaf::Status ret;
 
-        logger_->debug("Setting the status of request %d target %d to %s",
-                       requestHandle, targetRank, status.toString().c_str());
+        if (logger_->isDebugEnabled())
+            logger_->debug("Setting the status of request %d target %d to %s",
+                           requestHandle, targetRank, status.toString().c_str());
 
         UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
 
@@ -373,8 +378,9 @@ namespace uaf
             const ResultType&   result,
             const uaf::Mask&    mask)
     {
-        logger_->debug("Now updating the result with RequestHandle %d (mask: %s)",
-                       result.requestHandle, mask.toString().c_str());
+        if (logger_->isDebugEnabled())
+            logger_->debug("Now updating the result with RequestHandle %d (mask: %s)",
+                           result.requestHandle, mask.toString().c_str());
 
         uaf::Status ret;
 
@@ -37,6 +37,7 @@ namespace uaf
       findServersBusy_(false)
     {
         logger_ = new Logger(loggerFactory, "Discoverer");
+        findServersPool_ = new InvocationPool(loggerFactory);
         logger_->info("The discoverer has been constructed");
     }
 
@@ -47,6 +48,9 @@ namespace uaf
     {
         logger_->debug("Destructing the discoverer");
 
+        delete findServersPool_;
+        findServersPool_ = 0;
+
         delete logger_;
         logger_ = 0;
     }
@@ -84,66 +88,64 @@ namespace uaf
         {
             if (database_->clientSettings.discoveryUrls.size() > 0)
             {
-                // store the results in a temporary variable, and copy this temporary variable to the
-                // serverDescriptions_ member when finished
-                vector<ApplicationDescription> serverDescriptions;
-
                 // set the call timeout
                 UaClientSdk::ServiceSettings serviceSettings;
                 serviceSettings.callTimeout = int32_t(
                         database_->clientSettings.discoveryFindServersTimeoutSec * 1000);
 
-                UaClientSdk::ClientSecurityInfo clientSecurityInfo;
-
                 // create a copy of the URLs
                 vector<string> discoveryUrls = database_->clientSettings.discoveryUrls;
 
-                // store the statuses and the number of failures
-                size_t noOfErrors = 0;
-                vector<SdkStatus> sdkStatuses;
-                sdkStatuses.reserve(discoveryUrls.size());
-                // loop through the URLs
+                // forget the servers of the URLs that are not configured anymore, but keep the
+                // others until their FindServers call has finished
+                DiscoveryUrlsMap changes;
+                {
+                    UaMutexLocker locker(&serverDescriptionsMutex_);
+
+                    map<string, vector<ApplicationDescription> > serversPerUrl;
+                    for (vector<string>::const_iterator iter = discoveryUrls.begin();
+                         iter != discoveryUrls.end();
+                         ++iter)
+                    {
+                        if (serversPerUrl_.find(*iter) != serversPerUrl_.end())
+                            serversPerUrl[*iter] = serversPerUrl_[*iter];
+                    }
+
+                    serversPerUrl_.swap(serversPerUrl);
+                    discoveryUrls_ = discoveryUrls;
+                    updateServerDescriptions(changes);
+                }
+                notifyListeners(changes);
+
+                // invoke the FindServers service on all URLs concurrently, so that a discovery
+                // server that doesn't respond doesn't delay the others
+                vector<InvocationJob*> jobs;
                 for (vector<string>::const_iterator iter = discoveryUrls.begin();
                      iter != discoveryUrls.end();
                      ++iter)
                 {
-                    string url(*iter);
-
-                    logger_->debug("Finding the servers for URL '%s' (timeout %dms)",
-                                   url.c_str(),
-                                   serviceSettings.callTimeout);
+                    jobs.push_back(new FindServersJob(this, *iter, serviceSettings));
+                }
 
-                    // invoke the FindServers service for the current URL
-                    UaApplicationDescriptions desc;
-                    SdkStatus discoveryStatus = uaDiscovery_.findServers(
-                            serviceSettings,
-                            UaString(url.c_str()),
-                            clientSecurityInfo, // ToDo replace
-                            desc);
+                findServersPool_->executeAll(
+                        jobs,
+                        database_->clientSettings.discoveryMaxParallelFindServers);
 
-                    // store the status
+                // store the statuses and the number of failures
+                size_t noOfErrors = 0;
+                vector<SdkStatus> sdkStatuses;
+                sdkStatuses.reserve(jobs.size());
+                for (size_t i = 0; i < jobs.size(); i++)
+                {
+                    SdkStatus discoveryStatus = static_cast<FindServersJob*>(jobs[i])->status();
                     sdkStatuses.push_back(discoveryStatus);
 
-                    // if the service call went OK, process the result
-                    if (discoveryStatus.isGood())
-                    {
-                        // loop through the results
-                        for (uint32_t i=0; i<desc.length(); i++)
-                        {
-                            // create an UAF::ApplicationDescription from the SDK ApplicationDescription
-                            ApplicationDescription applicationDescription(desc[i]);
-                            serverDescriptions.push_back(applicationDescription);
-
-                            logger_->debug("Found server at URL '%s':", url.c_str());
-                            logger_->debug(applicationDescription.toString());
-                        }
-                    }
-                    else
-                    {
+                    if (discoveryStatus.isNotGood())
                         noOfErrors++;
-                        logger_->error(discoveryStatus.toString());
-                    }
+
+                    delete jobs[i];
                 }
+                jobs.clear();
 
                 if (noOfErrors > 0)
                 {
@@ -155,16 +157,20 @@ namespace uaf
                     ret = statuscodes::Good;
                     logger_->debug("The FindServers service was successfully invoked on all URLs");
                 }
-
-                // copy the temporary application descriptions to the class member
-                serverDescriptions_ = serverDescriptions;
             }
             else
             {
                 logger_->warning("Nothing to do: no discoveryUrls specified in the ClientConfig");
 
                 // clear the server descriptions
-                serverDescriptions_.clear();
+                DiscoveryUrlsMap changes;
+                {
+                    UaMutexLocker locker(&serverDescriptionsMutex_);
+                    serversPerUrl_.clear();
+                    discoveryUrls_.clear();
+                    updateServerDescriptions(changes);
+                }
+                notifyListeners(changes);
 
                 // all done
                 ret = statuscodes::Good;
@@ -180,32 +186,190 @@ namespace uaf
     }
 
 
-    // Get the discovery URL for a given server URI
+    // Invoke the FindServers service on a single URL
     // =============================================================================================
-    Status Discoverer::getDiscoveryUrls(const string& serverUri, vector<string>& discoveryUrls)
+    SdkStatus Discoverer::findServers(
+            const string&                       discoveryUrl,
+            const UaClientSdk::ServiceSettings& serviceSettings)
     {
-        Status ret;
+        logger_->debug("Finding the servers for URL '%s' (timeout %dms)",
+                       discoveryUrl.c_str(),
+                       serviceSettings.callTimeout);
+
+        // use a UaDiscovery instance per call, since multiple calls may run concurrently
+        UaClientSdk::UaDiscovery uaDiscovery;
+        UaClientSdk::ServiceSettings uaServiceSettings(serviceSettings);
+        UaClientSdk::ClientSecurityInfo clientSecurityInfo; // ToDo replace
+
+        // invoke the FindServers service for the URL
+        UaApplicationDescriptions desc;
+        SdkStatus discoveryStatus = uaDiscovery.findServers(
+                uaServiceSettings,
+                UaString(discoveryUrl.c_str()),
+                clientSecurityInfo,
+                desc);
+
+        // the servers of a URL that failed are not available anymore
+        vector<ApplicationDescription> serverDescriptions;
+
+        // if the service call went OK, process the result
+        if (discoveryStatus.isGood())
+        {
+            // loop through the results
+            for (uint32_t i=0; i<desc.length(); i++)
+            {
+                // create an UAF::ApplicationDescription from the SDK ApplicationDescription
+                ApplicationDescription applicationDescription(desc[i]);
+                serverDescriptions.push_back(applicationDescription);
+
+                logger_->debug("Found server at URL '%s':", discoveryUrl.c_str());
+                logger_->debug(applicationDescription.toString());
+            }
+        }
+        else
+        {
+            logger_->error(discoveryStatus.toString());
+        }
+
+        // merge the result immediately, so that it can be used before the other URLs are done
+        DiscoveryUrlsMap changes;
+        {
+            UaMutexLocker locker(&serverDescriptionsMutex_);
+            serversPerUrl_[discoveryUrl] = serverDescriptions;
+            updateServerDescriptions(changes);
+        }
+        notifyListeners(changes);
+
+        return discoveryStatus;
+    }
+
+
+    // Rebuild the server descriptions
+    // =============================================================================================
+    void Discoverer::updateServerDescriptions(DiscoveryUrlsMap& changes)
+    {
+        vector<ApplicationDescription> serverDescriptions;
+
+        for (vector<string>::const_iterator iter = discoveryUrls_.begin();
+             iter != discoveryUrls_.end();
+             ++iter)
+        {
+            map<string, vector<ApplicationDescription> >::const_iterator found;
+            found = serversPerUrl_.find(*iter);
+
+            if (found != serversPerUrl_.end())
+                serverDescriptions.insert(serverDescriptions.end(),
+                                          found->second.begin(),
+                                          found->second.end());
+        }
 
-        std::vector<std::string> knownServerUris;
+        serverDescriptions_.swap(serverDescriptions);
 
-        std::vector<uaf::ApplicationDescription>::const_iterator it;
-        for (it = serverDescriptions_.begin(); it != serverDescriptions_.end(); ++it)
+        // rebuild the index (if a server was found more than once, the last one counts, just
+        // like before)
+        DiscoveryUrlsMap discoveryUrlsMap;
+        for (vector<ApplicationDescription>::const_iterator iter = serverDescriptions_.begin();
+             iter != serverDescriptions_.end();
+             ++iter)
         {
-            knownServerUris.push_back(it->applicationUri);
-            if (it->applicationUri == serverUri)
+            discoveryUrlsMap[iter->applicationUri] = iter->discoveryUrls;
+        }
+
+        // find the servers that were added, changed, or removed
+        for (DiscoveryUrlsMap::const_iterator iter = discoveryUrlsMap.begin();
+             iter != discoveryUrlsMap.end();
+             ++iter)
+        {
+            DiscoveryUrlsMap::const_iterator old = discoveryUrlsMap_.find(iter->first);
+            if (old == discoveryUrlsMap_.end() || old->second != iter->second)
+                changes[iter->first] = iter->second;
+        }
+        for (DiscoveryUrlsMap::const_iterator old = discoveryUrlsMap_.begin();
+             old != discoveryUrlsMap_.end();
+             ++old)
+        {
+            if (discoveryUrlsMap.find(old->first) == discoveryUrlsMap.end())
+                changes[old->first] = vector<string>();
+        }
+
+        discoveryUrlsMap_.swap(discoveryUrlsMap);
+    }
+
+
+    // Notify the listeners
+    // =============================================================================================
+    void Discoverer::notifyListeners(const DiscoveryUrlsMap& changes)
+    {
+        if (changes.empty())
+            return;
+
+        UaMutexLocker locker(&listenersMutex_); // unlocks when locker goes out of scope
+
+        for (DiscoveryUrlsMap::const_iterator iter = changes.begin();
+             iter != changes.end();
+             ++iter)
+        {
+            logger_->debug("The discovery URLs of server %s have changed (%d URLs)",
+                           iter->first.c_str(), iter->second.size());
+
+            for (vector<DiscoveryListener*>::const_iterator listener = listeners_.begin();
+                 listener != listeners_.end();
+                 ++listener)
             {
-                discoveryUrls = it->discoveryUrls;
-                ret = statuscodes::Good;
+                (*listener)->discoveryUrlsChanged(iter->first, iter->second);
             }
         }
+    }
+
+
+    // Add a listener
+    // =============================================================================================
+    void Discoverer::addListener(DiscoveryListener* listener)
+    {
+        UaMutexLocker locker(&listenersMutex_); // unlocks when locker goes out of scope
+        listeners_.push_back(listener);
+    }
+
+
+    // Remove a listener
+    // =============================================================================================
+    void Discoverer::removeListener(DiscoveryListener* listener)
+    {
+        UaMutexLocker locker(&listenersMutex_); // unlocks when locker goes out of scope
+        listeners_.erase(std::remove(listeners_.begin(), listeners_.end(), listener),
+                         listeners_.end());
+    }
+
+
+    // Get the discovery URL for a given server URI
+    // =============================================================================================
+    Status Discoverer::getDiscoveryUrls(const string& serverUri, vector<string>& discoveryUrls)
+    {
+        Status ret;
+
+        UaMutexLocker locker(&serverDescriptionsMutex_);
+
+        DiscoveryUrlsMap::const_iterator found = discoveryUrlsMap_.find(serverUri);
 
-        if (ret.isNotGood())
+        if (found == discoveryUrlsMap_.end())
         {
+            // only build the list of known servers if we need to report an error
+            std::vector<std::string> knownServerUris;
+
+            std::vector<uaf::ApplicationDescription>::const_iterator it;
+            for (it = serverDescriptions_.begin(); it != serverDescriptions_.end(); ++it)
+                knownServerUris.push_back(it->applicationUri);
+
             ret = UnknownServerError(serverUri, knownServerUris);
         }
-        else if (discoveryUrls.size() == 0)
+        else
         {
-            ret = NoDiscoveryUrlsExposedByServerError(serverUri);
+            discoveryUrls = found->second;
+
+            if (discoveryUrls.size() == 0)
+                ret = NoDiscoveryUrlsExposedByServerError(serverUri);
+            else
+                ret = statuscodes::Good;
         }
 
         return ret;
@@ -214,15 +378,99 @@ namespace uaf
 
     // Get all servers found
     // =============================================================================================
-    const vector<ApplicationDescription>& Discoverer::serversFound() const
+    vector<ApplicationDescription> Discoverer::serversFound() const
     {
+        UaMutexLocker locker(&serverDescriptionsMutex_);
         return serverDescriptions_;
     }
 
 
-    // Update the endpoint descriptions
+    // Get the endpoint descriptions
+    // =============================================================================================
+    Status Discoverer::getEndpoints(
+            const string&                   discoveryUrl,
+            vector<EndpointDescription>&    endpointDescriptions)
+    {
+        bool fromCache;
+        return getEndpoints(discoveryUrl, endpointDescriptions, fromCache);
+    }
+
+
+    // Get the endpoint descriptions (from the cache if possible)
     // =============================================================================================
     Status Discoverer::getEndpoints(
+            const string&                   discoveryUrl,
+            vector<EndpointDescription>&    endpointDescriptions,
+            bool&                           fromCache)
+    {
+        fromCache = false;
+
+        double cacheTimeMs = database_->clientSettings.discoveryEndpointsCacheTimeSec * 1000.0;
+
+        if (cacheTimeMs > 0)
+        {
+            UaMutexLocker locker(&endpointCacheMutex_); // unlocks when locker goes out of scope
+
+            EndpointCache::const_iterator iter = endpointCache_.find(discoveryUrl);
+            if (iter != endpointCache_.end())
+            {
+                double ageMs = iter->second.fetchTime.msecsTo(UaDateTime::now());
+
+                // don't trust the cache if the clock was set back
+                if (ageMs >= 0 && ageMs < cacheTimeMs)
+                {
+                    const vector<EndpointDescription>& cached = iter->second.endpointDescriptions;
+                    endpointDescriptions.insert(endpointDescriptions.end(),
+                                                cached.begin(),
+                                                cached.end());
+                    fromCache = true;
+
+                    logger_->debug("Using the %d cached endpoints of '%s' (age %.1fs)",
+                                   cached.size(), discoveryUrl.c_str(), ageMs / 1000.0);
+
+                    return statuscodes::Good;
+                }
+            }
+        }
+
+        // fetch the endpoints (without locking the cache, since this may take a while)
+        vector<EndpointDescription> fetched;
+        UaDateTime fetchTime = UaDateTime::now();
+        Status ret = fetchEndpoints(discoveryUrl, fetched);
+
+        if (ret.isGood())
+        {
+            endpointDescriptions.insert(endpointDescriptions.end(), fetched.begin(), fetched.end());
+
+            if (cacheTimeMs > 0)
+            {
+                UaMutexLocker locker(&endpointCacheMutex_); // unlocks when locker goes out of scope
+
+                CachedEndpoints& entry = endpointCache_[discoveryUrl];
+                entry.endpointDescriptions = fetched;
+                entry.fetchTime            = fetchTime;
+            }
+        }
+
+        return ret;
+    }
+
+
+    // Invalidate the cached endpoints
+    // =============================================================================================
+    void Discoverer::invalidateEndpoints(const string& discoveryUrl)
+    {
+        UaMutexLocker locker(&endpointCacheMutex_); // unlocks when locker goes out of scope
+
+        if (endpointCache_.erase(discoveryUrl) > 0)
+            logger_->debug("The cached endpoints of '%s' have been invalidated",
+                           discoveryUrl.c_str());
+    }
+
+
+    // Fetch the endpoint descriptions
+    // =============================================================================================
+    Status Discoverer::fetchEndpoints(
             const string&                   discoveryUrl,
             vector<EndpointDescription>&    endpointDescriptions)
     {
@@ -239,7 +487,9 @@ namespace uaf
         }
         else
         {
-            // create the SDK variables
+            // create the SDK variables (a UaDiscovery instance per call, since multiple sessions
+            // may be connecting at the same time)
+            UaClientSdk::UaDiscovery uaDiscovery;
             UaEndpointDescriptions uaEndpointDescriptions;
             UaClientSdk::ServiceSettings serviceSettings;
             UaClientSdk::ClientSecurityInfo clientSecurityInfo; // ToDo replace
@@ -251,7 +501,7 @@ namespace uaf
             logger_->debug("Now invoking the GetEndpoints service");
 
             // perform the service call
-            SdkStatus sdkStatus = uaDiscovery_.getEndpoints(
+            SdkStatus sdkStatus = uaDiscovery.getEndpoints(
                     serviceSettings,
                     UaString(discoveryUrl.c_str()),
                     clientSecurityInfo,
@@ -25,8 +25,12 @@
 // STD
 #include <vector>
 #include <string>
+#include <map>
 #include <ctime>
+#include <algorithm>
 // SDK
+#include "uabase/uamutex.h"
+#include "uabase/uadatetime.h"
 #include "uaclient/uaclientsdk.h"
 #include "uaclient/uadiscovery.h"
 // UAF
@@ -37,12 +41,44 @@
 #include "uaf/util/endpointdescription.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/database/database.h"
+#include "uaf/client/sessions/invocationpool.h"
 
 
 namespace uaf
 {
 
 
+    /*******************************************************************************************//**
+    * An uaf::DiscoveryListener is notified by an uaf::Discoverer whenever the discovery URLs of a
+    * server have changed.
+    *
+    * @ingroup ClientDiscovery
+    ***********************************************************************************************/
+    class UAF_EXPORT DiscoveryListener
+    {
+    public:
+
+        /**
+         * Destruct the listener.
+         */
+        virtual ~DiscoveryListener() {}
+
+
+        /**
+         * Called (from a discovery thread) when a server was discovered with other discovery URLs
+         * than before, when a server was discovered for the first time, or when a server is not
+         * discovered anymore.
+         *
+         * @param serverUri     The URI of the server.
+         * @param discoveryUrls The new discovery URLs of the server (empty if the server is not
+         *                      discovered anymore).
+         */
+        virtual void discoveryUrlsChanged(
+                const std::string&              serverUri,
+                const std::vector<std::string>& discoveryUrls) = 0;
+    };
+
+
     /*******************************************************************************************//**
     * An uaf::Discoverer can discover OPC UA servers in the system.
     *
@@ -69,6 +105,10 @@ namespace uaf
         /**
          * Update the server descriptions by calling the OPC UA FindServers service
          * on all configured discovery servers.
+         *
+         * The discovery servers are contacted concurrently (see
+         * ClientSettings::discoveryMaxParallelFindServers), and the servers found via each
+         * discovery URL are made available as soon as its FindServers call has finished.
          */
         uaf::Status findServers();
 
@@ -91,6 +131,9 @@ namespace uaf
          * Get the endpoint descriptions for a given server by calling the OPC UA
          * GetEndpoints service on the given URL.
          *
+         * The endpoints are taken from the endpoint cache if they were fetched less than
+         * ClientSettings::discoveryEndpointsCacheTimeSec seconds ago.
+         *
          * @param discoveryUrl          URL of the server to discover.
          * @param endpointDescriptions  Endpoint descriptions that will be fetched.
          * @return                      Status of the service call.
@@ -101,11 +144,51 @@ namespace uaf
 
 
         /**
-         * Get a const reference to the servers that were found.
+         * Get the endpoint descriptions for a given server, and tell whether they were taken
+         * from the endpoint cache.
+         *
+         * @param discoveryUrl          URL of the server to discover.
+         * @param endpointDescriptions  Endpoint descriptions that will be fetched.
+         * @param fromCache             Output parameter: true if the endpoints were cached.
+         * @return                      Status of the service call.
+         */
+        uaf::Status getEndpoints(
+                const std::string&                      discoveryUrl,
+                std::vector<uaf::EndpointDescription>&  endpointDescriptions,
+                bool&                                   fromCache);
+
+
+        /**
+         * Remove the cached endpoints of the given URL, e.g. because they don't seem to match
+         * the security configuration of the server anymore.
+         *
+         * @param discoveryUrl  URL of which the endpoints should be fetched again next time.
+         */
+        void invalidateEndpoints(const std::string& discoveryUrl);
+
+
+        /**
+         * Register a listener, to be notified when the discovery URLs of a server change.
+         *
+         * @param listener  The listener (not owned by the discoverer).
+         */
+        void addListener(uaf::DiscoveryListener* listener);
+
+
+        /**
+         * Unregister a listener.
+         *
+         * @param listener  The listener that was registered before.
+         */
+        void removeListener(uaf::DiscoveryListener* listener);
+
+
+        /**
+         * Get a snapshot of the servers that were found.
          *
-         * @return  A vector of the application descriptions that were discovered.
+         * @return  A copy of the application descriptions that were discovered.
          */
-        const std::vector<uaf::ApplicationDescription>& serversFound() const;
+        std::vector<uaf::ApplicationDescription> serversFound() const;
 
 
     private:
@@ -114,6 +197,79 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(Discoverer);
 
 
+        /**
+         * A job that invokes the FindServers service on a single discovery URL.
+         */
+        class FindServersJob : public uaf::InvocationJob
+        {
+        public:
+            FindServersJob(
+                    uaf::Discoverer*                        discoverer,
+                    const std::string&                      discoveryUrl,
+                    const UaClientSdk::ServiceSettings&     serviceSettings)
+            : discoverer_(discoverer),
+              discoveryUrl_(discoveryUrl),
+              serviceSettings_(serviceSettings)
+            {}
+
+            void execute()
+            { status_ = discoverer_->findServers(discoveryUrl_, serviceSettings_); }
+
+            uaf::SdkStatus status() const { return status_; }
+
+        private:
+            uaf::Discoverer*                discoverer_;
+            std::string                     discoveryUrl_;
+            UaClientSdk::ServiceSettings    serviceSettings_;
+            uaf::SdkStatus                  status_;
+        };
+        friend class FindServersJob;
+
+
+        /**
+         * Invoke the FindServers service on a single discovery URL, and store the result.
+         */
+        uaf::SdkStatus findServers(
+                const std::string&                  discoveryUrl,
+                const UaClientSdk::ServiceSettings& serviceSettings);
+
+
+        // the discovery URLs per server URI
+        typedef std::map<std::string, std::vector<std::string> > DiscoveryUrlsMap;
+
+
+        /**
+         * Rebuild the serverDescriptions_ and discoveryUrlsMap_ from the serversPerUrl_
+         * (the mutex must be locked!).
+         *
+         * @param changes   Output parameter: the servers of which the discovery URLs changed.
+         */
+        void updateServerDescriptions(DiscoveryUrlsMap& changes);
+
+
+        /**
+         * Notify the listeners of the given changes (the mutex must not be locked!).
+         */
+        void notifyListeners(const DiscoveryUrlsMap& changes);
+
+
+        /**
+         * Fetch the endpoint descriptions by invoking the GetEndpoints service (no caching).
+         */
+        uaf::Status fetchEndpoints(
+                const std::string&                      discoveryUrl,
+                std::vector<uaf::EndpointDescription>&  endpointDescriptions);
+
+
+        // the endpoints that were fetched for a discovery URL, and the time they were fetched
+        struct CachedEndpoints
+        {
+            std::vector<uaf::EndpointDescription>   endpointDescriptions;
+            UaDateTime                              fetchTime;
+        };
+        typedef std::map<std::string, CachedEndpoints> EndpointCache;
+
+
         // the logger of the discoverer
         uaf::Logger* logger_;
         // a pointer to the shared database
@@ -124,8 +280,25 @@ namespace uaf
         UaMutex findServersBusyMutex_;
         // the latest application descriptions
         std::vector<uaf::ApplicationDescription> serverDescriptions_;
-        // UaDiscovery instance
-        UaClientSdk::UaDiscovery uaDiscovery_;
+        // the latest application descriptions per discovery URL
+        std::map<std::string, std::vector<uaf::ApplicationDescription> > serversPerUrl_;
+        // the discovery URLs of the latest findServers() call (in the configured order)
+        std::vector<std::string> discoveryUrls_;
+        // the discovery URLs of the discovered servers, indexed by their application URI
+        DiscoveryUrlsMap discoveryUrlsMap_;
+        // mutex to safely manipulate the serverDescriptions_, serversPerUrl_, discoveryUrls_
+        // and discoveryUrlsMap_
+        mutable UaMutex serverDescriptionsMutex_;
+        // the listeners to notify when the discovery URLs of a server change
+        std::vector<uaf::DiscoveryListener*> listeners_;
+        // mutex to safely manipulate the listeners_
+        UaMutex listenersMutex_;
+        // the pool to invoke the FindServers service on multiple URLs concurrently
+        uaf::InvocationPool* findServersPool_;
+        // the cached endpoints, per discovery URL
+        EndpointCache endpointCache_;
+        // mutex to safely manipulate the endpoint cache
+        UaMutex endpointCacheMutex_;
     };
 
 
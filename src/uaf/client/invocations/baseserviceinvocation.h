@@ -26,6 +26,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <algorithm>
 // SDK
 // UAF
 #include "uaf/util/status.h"
@@ -35,6 +36,9 @@
 #include "uaf/util/constants.h"
 #include "uaf/client/clientexport.h"
 #include "uaf/client/sessions/sessioninformation.h"
+#include "uaf/client/sessions/operationlimits.h"
+#include "uaf/client/sessions/chunkpipeline.h"
+#include "uaf/client/sessions/registerednodes.h"
 #include "uaf/client/subscriptions/subscriptioninformation.h"
 #include "uaf/client/requests/requests.h"
 #include "uaf/client/results/results.h"
@@ -90,7 +94,10 @@ namespace uaf
         : asynchronous_(async),
           transactionId_(0),
           requestHandle_(requestHandle),
-          invocationLevel_(uaf::SessionLevel)
+          invocationLevel_(uaf::SessionLevel),
+          chunkOffset_(0),
+          chunkPipeline_(0),
+          maxChunksInFlight_(1)
         {}
 
 
@@ -135,6 +142,12 @@ namespace uaf
         /** Get the level at which the service should be invoked. */
         uaf::InvocationLevel               invocationLevel()       const { return invocationLevel_; }
 
+        /** Get the index of the first target of the chunk that is currently being invoked. */
+        std::size_t                         chunkOffset()           const { return chunkOffset_; }
+
+        /** Get the registered nodes that may be used by the service invocation. */
+        const uaf::RegisteredNodes&         registeredNodes()       const { return registeredNodes_; }
+
 
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
@@ -202,6 +215,52 @@ namespace uaf
         }
 
 
+        /** Provide the operation limits of the server. */
+        void setOperationLimits(const uaf::OperationLimits& operationLimits)
+        {
+            operationLimits_ = operationLimits;
+        }
+
+
+        /** Provide the pipeline that delivers the responses to pipelined chunks. */
+        void setChunkPipeline(uaf::ChunkPipeline* chunkPipeline)
+        {
+            chunkPipeline_ = chunkPipeline;
+        }
+
+
+        /** Set the maximum number of chunks that may be in flight at the same time. */
+        void setMaxChunksInFlight(uint32_t maxChunksInFlight)
+        {
+            maxChunksInFlight_ = maxChunksInFlight;
+        }
+
+
+        /**
+         * Provide the registered nodes of the session (only stored if the service uses them).
+         *
+         * The registered nodes are not copied, the invocation shares a snapshot of them.
+         */
+        void setRegisteredNodes(const uaf::RegisteredNodes& registeredNodes)
+        {
+            if (supportsRegisteredNodes())
+                registeredNodes_ = registeredNodes;
+        }
+
+
+        /**
+         * Update the registered nodes of the session, after the service has been invoked
+         * successfully.
+         *
+         * This is a virtual function, meant to be overwritten by the concrete services that
+         * register or unregister nodes.
+         *
+         * @param registeredNodes   The registered nodes of the session, to be updated.
+         */
+        virtual void updateRegisteredNodes(uaf::RegisteredNodes& registeredNodes) const
+        {}
+
+
 
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
@@ -230,13 +289,19 @@ namespace uaf
 
             logger->debug("Invoking the service at the session level");
 
+            // use a private copy of the namespace array for this invocation, so the namespace
+            // URIs of the targets can be memoized (without locking) and only need to be looked
+            // up once per distinct URI
+            uaf::NamespaceArray memoizingNameSpaceArray(nameSpaceArray);
+            memoizingNameSpaceArray.setMemoizing(true);
+
             if (asynchronous_)
             {
                 logger->debug("Copying the data from the asynchronous UAF request to the SDK level");
                 ret = fromAsyncUafToSdk(
                         requestTargets_,
                         serviceSettings_,
-                        nameSpaceArray,
+                        memoizingNameSpaceArray,
                         serverArray);
 
                 if (ret.isGood())
@@ -245,26 +310,13 @@ namespace uaf
                     ret = invokeAsyncSdkService(uaSession, transactionId_);
                 }
             }
+            else if (pipelined())
+            {
+                ret = invokePipelined(uaSession, memoizingNameSpaceArray, serverArray, logger);
+            }
             else
             {
-                logger->debug("Copying the data from the synchronous UAF request to the SDK level");
-                ret = fromSyncUafToSdk(
-                        requestTargets_,
-                        serviceSettings_,
-                        nameSpaceArray,
-                        serverArray);
-
-                if (ret.isGood())
-                {
-                    logger->debug("Invoking the synchronous request at the SDK level");
-                    ret = invokeSyncSdkService(uaSession);
-                }
-
-                if (ret.isGood())
-                {
-                    logger->debug("Copying the data from SDK level to the UAF result");
-                    ret = fromSyncSdkToUaf(nameSpaceArray, serverArray, resultTargets_);
-                }
+                ret = invokeSync(uaSession, memoizingNameSpaceArray, serverArray, logger);
             }
 
             if (ret.isGood())
@@ -298,13 +350,17 @@ namespace uaf
 
             logger->debug("Invoking the service at the subscription level");
 
+            // use a private copy of the namespace array for this invocation (see above)
+            uaf::NamespaceArray memoizingNameSpaceArray(nameSpaceArray);
+            memoizingNameSpaceArray.setMemoizing(true);
+
             if (this->asynchronous())
             {
                 logger->debug("Copying the data from the asynchronous UAF request to the SDK level");
                 ret = this->fromAsyncUafToSdk(
                         this->requestTargets(),
                         this->serviceSettings(),
-                        nameSpaceArray,
+                        memoizingNameSpaceArray,
                         serverArray);
 
                 if (ret.isGood())
@@ -315,24 +371,8 @@ namespace uaf
             }
             else
             {
-                logger->debug("Copying the data from the synchronous UAF request to the SDK level");
-                ret = this->fromSyncUafToSdk(
-                        this->requestTargets(),
-                        this->serviceSettings(),
-                        nameSpaceArray,
-                        serverArray);
-
-                if (ret.isGood())
-                {
-                    logger->debug("Invoking the synchronous request at the SDK level");
-                    ret = this->invokeSyncSdkService(uaSubscription);
-                }
-
-                if (ret.isGood())
-                {
-                    logger->debug("Copying the data from SDK level to the UAF result");
-                    ret = this->fromSyncSdkToUaf(nameSpaceArray, serverArray, this->resultTargets());
-                }
+                ret = this->invokeSync(
+                        uaSubscription, memoizingNameSpaceArray, serverArray, logger);
             }
 
             return ret;
@@ -527,6 +567,250 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(BaseServiceInvocation);
 
 
+        /**
+         * Get the maximum number of targets that may be sent to the server in a single call.
+         *
+         * @return  The limit of the service settings if it was set, otherwise the limit of the
+         *          server for this particular service (0 means unlimited).
+         */
+        std::size_t maxTargetsPerCall() const
+        {
+            if (serviceSettings_.maxOperationsPerCall > 0)
+                return serviceSettings_.maxOperationsPerCall;
+            else
+                return serverOperationLimit(operationLimits_);
+        }
+
+
+        /**
+         * Check if the synchronous request must be invoked by pipelining its chunks.
+         *
+         * @return  True if the request needs more than one chunk, and if the service and the
+         *          session allow several chunks to be in flight at the same time.
+         */
+        bool pipelined() const
+        {
+            std::size_t chunkSize = maxTargetsPerCall();
+
+            return chunkPipeline_ != 0
+                && maxChunksInFlight_ > 1
+                && supportsPipelining()
+                && chunkSize > 0
+                && requestTargets_.size() > chunkSize;
+        }
+
+
+        /**
+         * Invoke the synchronous request at the session level, by sending its chunks as
+         * asynchronous calls, and keeping up to maxChunksInFlight_ of them in flight at once.
+         *
+         * The responses are converted when all of them have been received, and the results
+         * are stored in the (preallocated) resultTargets_ at the position of their chunk.
+         *
+         * @param uaSession         Pointer to the SDK session object.
+         * @param nameSpaceArray    The namespace array of the session.
+         * @param serverArray       The server array of the session.
+         * @param logger            Pointer to a logger.
+         * @return                  Bad if the service could not be invoked.
+         */
+        uaf::Status invokePipelined(
+                UaClientSdk::UaSession*     uaSession,
+                const uaf::NamespaceArray&  nameSpaceArray,
+                const uaf::ServerArray&     serverArray,
+                uaf::Logger*                logger)
+        {
+            uaf::Status ret(uaf::statuscodes::Good);
+
+            std::size_t noOfTargets = requestTargets_.size();
+            std::size_t chunkSize   = maxTargetsPerCall();
+            std::size_t noOfChunks  = (noOfTargets + chunkSize - 1) / chunkSize;
+
+            // the SDK reports a timeout itself when a call takes longer than the call timeout,
+            // so we only stop waiting if it doesn't even do that
+            uint32_t timeoutMs = uint32_t(serviceSettings_.callTimeoutSec * 1000) + 5000;
+
+            logger->debug("Pipelining %d chunks of maximum %d targets (maximum %d in flight)",
+                          noOfChunks, chunkSize, maxChunksInFlight_);
+
+            resultTargets_.resize(noOfTargets);
+
+            uaf::ChunkWindow window(requestHandle_, noOfChunks);
+            std::size_t sent     = 0;
+            std::size_t received = 0;
+
+            while (received < sent || (sent < noOfChunks && ret.isGood()))
+            {
+                if (sent < noOfChunks && ret.isGood() && sent - received < maxChunksInFlight_)
+                {
+                    std::size_t chunkStart = sent * chunkSize;
+                    std::size_t chunkEnd   = std::min(chunkStart + chunkSize, noOfTargets);
+
+                    std::vector<_RequestTarget> chunkRequestTargets(
+                            requestTargets_.begin() + chunkStart,
+                            requestTargets_.begin() + chunkEnd);
+
+                    ret = fromSyncUafToSdk(
+                            chunkRequestTargets,
+                            serviceSettings_,
+                            nameSpaceArray,
+                            serverArray);
+
+                    if (ret.isGood())
+                    {
+                        uaf::TransactionId transactionId = chunkPipeline_->expect(window, sent);
+
+                        logger->debug("Sending chunk %d (targets %d to %d) as transaction %d",
+                                      sent, chunkStart, chunkEnd - 1, transactionId);
+
+                        ret = invokeAsyncSdkService(uaSession, transactionId);
+                    }
+
+                    if (ret.isGood())
+                        sent++;
+                }
+                else if (window.waitForResponse(timeoutMs))
+                {
+                    received++;
+                }
+                else
+                {
+                    ret = uaf::UnexpectedError("No response was received for a pipelined chunk");
+                    break;
+                }
+            }
+
+            // make sure that responses that may still arrive are not stored in the window
+            if (received < sent || ret.isNotGood())
+                chunkPipeline_->cancel(window);
+
+            for (std::size_t chunk = 0; chunk < noOfChunks && ret.isGood(); chunk++)
+            {
+                std::size_t chunkStart = chunk * chunkSize;
+                std::size_t chunkEnd   = std::min(chunkStart + chunkSize, noOfTargets);
+
+                std::vector<_ResultTarget> chunkResultTargets(
+                        resultTargets_.begin() + chunkStart,
+                        resultTargets_.begin() + chunkEnd);
+
+                ret = fromPipelinedSdkToUaf(
+                        window.response(chunk),
+                        chunkEnd - chunkStart,
+                        nameSpaceArray,
+                        serverArray,
+                        chunkResultTargets);
+
+                if (ret.isGood())
+                    std::copy(chunkResultTargets.begin(),
+                              chunkResultTargets.end(),
+                              resultTargets_.begin() + chunkStart);
+            }
+
+            return ret;
+        }
+
+
+        /**
+         * Invoke the synchronous request, at the session or subscription level.
+         *
+         * If the request has more targets than allowed by maxTargetsPerCall(), then the service
+         * is invoked once for every chunk of targets, and the results of all chunks are merged
+         * into the resultTargets_ (so that the caller doesn't notice the difference).
+         *
+         * @param sdkObject         Pointer to the SDK session or subscription object.
+         * @param nameSpaceArray    The namespace array of the session.
+         * @param serverArray       The server array of the session.
+         * @param logger            Pointer to a logger.
+         * @return                  Bad if the service could not be invoked.
+         */
+        template<typename _SdkObject>
+        uaf::Status invokeSync(
+                _SdkObject*                 sdkObject,
+                const uaf::NamespaceArray&  nameSpaceArray,
+                const uaf::ServerArray&     serverArray,
+                uaf::Logger*                logger)
+        {
+            uaf::Status ret;
+
+            std::size_t noOfTargets = requestTargets_.size();
+            std::size_t chunkSize   = maxTargetsPerCall();
+
+            if (chunkSize == 0 || noOfTargets <= chunkSize)
+            {
+                logger->debug("Copying the data from the synchronous UAF request to the SDK level");
+                ret = fromSyncUafToSdk(
+                        requestTargets_,
+                        serviceSettings_,
+                        nameSpaceArray,
+                        serverArray);
+
+                if (ret.isGood())
+                {
+                    logger->debug("Invoking the synchronous request at the SDK level");
+                    ret = invokeSyncSdkService(sdkObject);
+                }
+
+                if (ret.isGood())
+                {
+                    logger->debug("Copying the data from SDK level to the UAF result");
+                    ret = fromSyncSdkToUaf(nameSpaceArray, serverArray, resultTargets_);
+                }
+            }
+            else
+            {
+                logger->debug("Splitting the %d targets into chunks of maximum %d targets",
+                              noOfTargets, chunkSize);
+
+                resultTargets_.resize(noOfTargets);
+
+                ret = uaf::statuscodes::Good;
+
+                for (chunkOffset_ = 0;
+                     chunkOffset_ < noOfTargets && ret.isGood();
+                     chunkOffset_ += chunkSize)
+                {
+                    std::size_t chunkEnd = std::min(chunkOffset_ + chunkSize, noOfTargets);
+
+                    std::vector<_RequestTarget> chunkRequestTargets(
+                            requestTargets_.begin() + chunkOffset_,
+                            requestTargets_.begin() + chunkEnd);
+                    std::vector<_ResultTarget> chunkResultTargets(
+                            resultTargets_.begin() + chunkOffset_,
+                            resultTargets_.begin() + chunkEnd);
+
+                    logger->debug("Invoking the synchronous request for targets %d to %d",
+                                  chunkOffset_, chunkEnd - 1);
+
+                    ret = fromSyncUafToSdk(
+                            chunkRequestTargets,
+                            serviceSettings_,
+                            nameSpaceArray,
+                            serverArray);
+
+                    if (ret.isGood())
+                        ret = invokeSyncSdkService(sdkObject);
+
+                    if (ret.isGood())
+                        ret = fromSyncSdkToUaf(nameSpaceArray, serverArray, chunkResultTargets);
+
+                    if (ret.isGood() && chunkResultTargets.size() != chunkEnd - chunkOffset_)
+                        ret = uaf::UnexpectedError(
+                                uaf::format("Bug in BaseServiceInvocation: number of results (%d) "
+                                            "!= number of targets (%d) of chunk",
+                                            chunkResultTargets.size(), chunkEnd - chunkOffset_));
+
+                    if (ret.isGood())
+                        std::copy(chunkResultTargets.begin(),
+                                  chunkResultTargets.end(),
+                                  resultTargets_.begin() + chunkOffset_);
+                }
+
+                chunkOffset_ = 0;
+            }
+
+            return ret;
+        }
+
+
 
         /**
          * Copy the synchronous request data from the UAF objects to the SDK objects.
@@ -691,6 +975,75 @@ namespace uaf
         }
 
 
+        /**
+         * Get the maximum number of targets per call that the server allows for this service.
+         *
+         * This is a virtual function, meant to be overwritten by the concrete services for which
+         * the server exposes an operation limit.
+         *
+         * @param operationLimits   The operation limits of the server.
+         * @return                  The maximum number of targets per call (0 means unlimited).
+         */
+        virtual std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        {
+            return 0;
+        }
+
+
+        /**
+         * Check if the service can pipeline the chunks of a synchronous request.
+         *
+         * This is a virtual function, meant to be overwritten by the concrete services that
+         * implement fromPipelinedSdkToUaf().
+         *
+         * @return  True if the chunks can be sent as asynchronous calls.
+         */
+        virtual bool supportsPipelining() const
+        {
+            return false;
+        }
+
+
+        /**
+         * Check if the service addresses its nodes by their registered NodeIds (if any).
+         *
+         * This is a virtual function, meant to be overwritten by the concrete services that
+         * use registeredNodes() to fill their SDK NodeIds.
+         *
+         * @return  True if the registered nodes of the session should be provided.
+         */
+        virtual bool supportsRegisteredNodes() const
+        {
+            return false;
+        }
+
+
+        /**
+         * Copy the response to a pipelined chunk from the SDK to the UAF objects.
+         *
+         * This is a virtual function, meant to be overwritten by the concrete services that
+         * support pipelining.
+         *
+         * @param response          The response to the chunk.
+         * @param noOfTargets       The number of targets of the chunk.
+         * @param nameSpaceArray    The namespace array of the server that was used for the
+         *                          service invocation.
+         * @param serverArray       The server array of the server that was used for the
+         *                          service invocation.
+         * @param targets           Output parameter: the targets of the chunk to be updated.
+         * @return                  Good if the data could be copied, bad if not.
+         */
+        virtual uaf::Status fromPipelinedSdkToUaf(
+                const uaf::ChunkResponse&       response,
+                std::size_t                     noOfTargets,
+                const uaf::NamespaceArray&      nameSpaceArray,
+                const uaf::ServerArray&         serverArray,
+                std::vector<_ResultTarget>&     targets)
+        {
+            return uaf::Status(uaf::UnexpectedError("Method is not supposed to be called!"));
+        }
+
+
         // should the service be invoked asynchronously, or not?
         bool                        asynchronous_;
         // the transactionId of the service call, if it is asynchronous
@@ -713,6 +1066,16 @@ namespace uaf
         uaf::SubscriptionInformation subscriptionInformation_;
         // the level at which the service should be invoked
         uaf::InvocationLevel       invocationLevel_;
+        // the operation limits of the server
+        uaf::OperationLimits       operationLimits_;
+        // the index of the first target of the chunk that is currently being invoked
+        std::size_t                chunkOffset_;
+        // the pipeline that delivers the responses to pipelined chunks (may be NULL)
+        uaf::ChunkPipeline*        chunkPipeline_;
+        // the maximum number of chunks that may be in flight at the same time
+        uint32_t                   maxChunksInFlight_;
+        // the registered nodes of the session (only provided if the service uses them)
+        uaf::RegisteredNodes       registeredNodes_;
 
     };
 
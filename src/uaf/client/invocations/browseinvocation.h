@@ -108,6 +108,13 @@ namespace uaf
                 std::vector<uaf::BrowseResultTarget>& targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxNodesPerBrowse; }
+
+
         // private data members used during the invocation
         uint32_t                        uaMaxReferencesToReturn_;
         OpcUa_ViewDescription           uaViewDescription_;
@@ -95,6 +95,13 @@ namespace uaf
                 std::vector<uaf::BrowseNextResultTarget>&  targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxNodesPerBrowse; }
+
+
         // private data members used during the invocation
         UaClientSdk::ServiceSettings    uaServiceSettings_;
         OpcUa_Boolean                   uaReleaseContinuationPoint_;
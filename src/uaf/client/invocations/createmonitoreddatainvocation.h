@@ -117,6 +117,13 @@ namespace uaf
                 std::vector<uaf::CreateMonitoredDataResultTarget>& targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxMonitoredItemsPerCall; }
+
+
         // private data members used during the invocation
         OpcUa_TimestampsToReturn        uaTimeStamps_;
         ClientHandles                   clientHandles_;
@@ -48,11 +48,14 @@ namespace uaf
         // declare the number of targets
         size_t noOfTargets = targets.size();
 
-        // resize the number of requests
+        // resize the number of requests (clear them first, since they may still contain the
+        // requests of a previous chunk)
+        uaCreateRequests_.clear();
         uaCreateRequests_.resize(noOfTargets);
 
         // check if the client handles have been set correctly
-        if (clientHandles_.size() == noOfTargets)
+        // (the targets may be a chunk of all targets, starting at chunkOffset())
+        if (chunkOffset() + noOfTargets <= clientHandles_.size())
             ret = statuscodes::Good;
         else
             ret = UnexpectedError("Handles have not been set correctly!");
@@ -75,7 +78,8 @@ namespace uaf
                 // set the other properties
                 uaCreateRequests_[i].ItemToMonitor.AttributeId = OpcUa_Attributes_EventNotifier;
                 uaCreateRequests_[i].MonitoringMode = mode;
-                uaCreateRequests_[i].RequestedParameters.ClientHandle = clientHandles_[i];
+                uaCreateRequests_[i].RequestedParameters.ClientHandle
+                    = clientHandles_[chunkOffset() + i];
                 uaCreateRequests_[i].RequestedParameters.SamplingInterval = samplingInterval;
                 uaCreateRequests_[i].RequestedParameters.DiscardOldest = discardOldest;
                 uaCreateRequests_[i].RequestedParameters.QueueSize = targets[i].queueSize;
@@ -208,7 +212,8 @@ namespace uaf
         targets.resize(noOfResults);
 
         // check if the number of results is correct
-        if (noOfResults == clientHandles_.size())
+        if (noOfResults == uaCreateRequests_.length()
+            && chunkOffset() + noOfResults <= clientHandles_.size())
             ret = statuscodes::Good;
         else
             ret = UnexpectedError("Mismatch between number of results and number of client handles");
@@ -218,7 +223,7 @@ namespace uaf
         {
             for (uint32_t i = 0; i < noOfResults; i++)
             {
-                targets[i].clientHandle = clientHandles_[i];
+                targets[i].clientHandle = clientHandles_[chunkOffset() + i];
                 targets[i].monitoredItemId = uaCreateResults_[i].MonitoredItemId;
                 targets[i].revisedQueueSize = uaCreateResults_[i].RevisedQueueSize;
                 targets[i].revisedSamplingIntervalSec
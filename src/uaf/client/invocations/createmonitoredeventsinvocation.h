@@ -116,6 +116,13 @@ namespace uaf
                 std::vector<uaf::CreateMonitoredEventsResultTarget>& targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxMonitoredItemsPerCall; }
+
+
         // private data members used during the invocation
         OpcUa_TimestampsToReturn        uaTimeStamps_;
         ClientHandles                   clientHandles_;
@@ -34,6 +34,8 @@
 #include "uaf/client/invocations/browseinvocation.h"
 #include "uaf/client/invocations/browsenextinvocation.h"
 #include "uaf/client/invocations/historyreadrawmodifiedinvocation.h"
+#include "uaf/client/invocations/registernodesinvocation.h"
+#include "uaf/client/invocations/unregisternodesinvocation.h"
 
 
 // no declarations, just an #include for each invocation
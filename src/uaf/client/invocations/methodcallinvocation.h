@@ -96,6 +96,13 @@ namespace uaf
                 std::vector<uaf::MethodCallResultTarget>&  targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxNodesPerMethodCall; }
+
+
         // private data members used during the invocation
         UaClientSdk::ServiceSettings    uaServiceSettings_;
         UaClientSdk::CallIn             uaCallIn_;
@@ -26,6 +26,7 @@ namespace uaf
     using std::string;
     using std::stringstream;
     using std::vector;
+    using std::size_t;
 
 
     // Fill the synchronous SDK members
@@ -59,8 +60,11 @@ namespace uaf
         // loop through the targets
         for (size_t i = 0; i < noOfTargets && ret.isGood(); i++)
         {
-            // update the node id of the target
-            ret = nameSpaceArray.fillOpcUaNodeId(targets[i].address, uaReadValueIds_[i].NodeId);
+            // update the node id of the target (or its alias, if it has been registered)
+            ret = registeredNodes().fillOpcUaNodeId(
+                    targets[i].address,
+                    nameSpaceArray,
+                    uaReadValueIds_[i].NodeId);
 
             // only update the rest of the SDK variables if no error has occurred yet
             if (ret.isGood())
@@ -148,28 +152,67 @@ namespace uaf
             const NamespaceArray&       nameSpaceArray,
             const ServerArray&          serverArray,
             vector<ReadResultTarget>&   targets)
+    {
+        return copyDataValues(
+                uaDataValues_,
+                uaReadValueIds_.length(),
+                nameSpaceArray,
+                serverArray,
+                targets);
+    }
+
+
+    // Fill the UAF members of a pipelined chunk
+    // =============================================================================================
+    Status ReadInvocation::fromPipelinedSdkToUaf(
+            const ChunkResponse&        response,
+            size_t                      noOfTargets,
+            const NamespaceArray&       nameSpaceArray,
+            const ServerArray&          serverArray,
+            vector<ReadResultTarget>&   targets)
+    {
+        if (response.status.isBad())
+            return ReadInvocationError(SdkStatus(response.status));
+
+        return copyDataValues(
+                response.dataValues,
+                noOfTargets,
+                nameSpaceArray,
+                serverArray,
+                targets);
+    }
+
+
+    // Copy the data values to the targets
+    // =============================================================================================
+    Status ReadInvocation::copyDataValues(
+            const UaDataValues&         uaDataValues,
+            size_t                      noOfTargets,
+            const NamespaceArray&       nameSpaceArray,
+            const ServerArray&          serverArray,
+            vector<ReadResultTarget>&   targets)
     {
         // declare the return Status
         Status ret;
 
-        // declare the number of targets, and resize the output parameter accordingly
-        uint32_t noOfTargets = uaDataValues_.length();
-        targets.resize(noOfTargets);
+        // declare the number of results, and resize the output parameter accordingly
+        uint32_t noOfResults = uaDataValues.length();
+        targets.resize(noOfResults);
 
         // check the number of targets
-        if (noOfTargets == uaReadValueIds_.length())
+        if (noOfResults == noOfTargets)
         {
-            for (uint32_t i=0; i<noOfTargets ; i++)
+            for (uint32_t i=0; i<noOfResults ; i++)
             {
-                targets[i].fromSdk(UaDataValue(uaDataValues_[i]));
+                targets[i].fromSdk(UaDataValue(uaDataValues[i]));
                 nameSpaceArray.fillVariant(targets[i].data);
                 serverArray.fillVariant(targets[i].data);
 
                 // update the status
-                if (OpcUa_IsGood(uaDataValues_[i].StatusCode))
+                if (OpcUa_IsGood(uaDataValues[i].StatusCode))
                     targets[i].status = statuscodes::Good;
                 else
-                    targets[i].status = ServerCouldNotReadError(SdkStatus(uaDataValues_[i].StatusCode));
+                    targets[i].status = ServerCouldNotReadError(SdkStatus(uaDataValues[i].StatusCode));
             }
 
             ret = statuscodes::Good;
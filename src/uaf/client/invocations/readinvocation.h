@@ -94,6 +94,54 @@ namespace uaf
                 std::vector<uaf::ReadResultTarget>& targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        bool supportsPipelining() const { return true; }
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        bool supportsRegisteredNodes() const { return true; }
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        uaf::Status fromPipelinedSdkToUaf(
+                const uaf::ChunkResponse&            response,
+                std::size_t                          noOfTargets,
+                const uaf::NamespaceArray&           nameSpaceArray,
+                const uaf::ServerArray&              serverArray,
+                std::vector<uaf::ReadResultTarget>& targets);
+
+
+        /**
+         * Copy the data values of a Read call to the given targets.
+         *
+         * @param uaDataValues      The data values as received from the SDK.
+         * @param noOfTargets       The number of targets that were read.
+         * @param nameSpaceArray    The namespace array of the server.
+         * @param serverArray       The server array of the server.
+         * @param targets           Output parameter: the targets to be updated.
+         * @return                  Good if the data values could be copied, bad if not.
+         */
+        static uaf::Status copyDataValues(
+                const UaDataValues&                  uaDataValues,
+                std::size_t                          noOfTargets,
+                const uaf::NamespaceArray&           nameSpaceArray,
+                const uaf::ServerArray&              serverArray,
+                std::vector<uaf::ReadResultTarget>& targets);
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxNodesPerRead; }
+
+
         // private data members used during the invocation
         OpcUa_Double                    uaMaxAge_;
         OpcUa_TimestampsToReturn        uaTimestampsToReturn_;
@@ -0,0 +1,144 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "uaf/client/invocations/registernodesinvocation.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::pair;
+    using std::size_t;
+
+
+    // Fill the synchronous SDK members
+    // =============================================================================================
+    Status RegisterNodesInvocation::fromSyncUafToSdk(
+            const vector<RegisterNodesRequestTarget>&   targets,
+            const RegisterNodesSettings&                settings,
+            const NamespaceArray&                       nameSpaceArray,
+            const ServerArray&                          serverArray)
+    {
+        Status ret;
+
+        // update the uaServiceSettings_
+        ret = settings.toSdk(uaServiceSettings_);
+
+        // declare the number of targets
+        size_t noOfTargets = targets.size();
+
+        // resize the number of uaNodesToRegister_
+        uaNodesToRegister_.create(noOfTargets);
+        nodeIds_.clear();
+
+        // loop through the targets
+        for (size_t i = 0; i < noOfTargets && ret.isGood(); i++)
+        {
+            // update the node id of the target
+            ret = nameSpaceArray.fillOpcUaNodeId(targets[i].address, uaNodesToRegister_[i]);
+
+            // remember the node (with its namespace URI), so the session can store its alias
+            // (a null NodeId means that the node can't be stored)
+            NodeId nodeId;
+            if (ret.isGood())
+                RegisteredNodes::findKey(targets[i].address, nameSpaceArray, nodeId);
+            nodeIds_.push_back(nodeId);
+        }
+
+        return ret;
+    }
+
+
+    // Invoke the service synchronously
+    // =============================================================================================
+    Status RegisterNodesInvocation::invokeSyncSdkService(UaClientSdk::UaSession* uaSession)
+    {
+        Status ret;
+
+        UaStatus sdkStatus = uaSession->registerNodes(
+                uaServiceSettings_,
+                uaNodesToRegister_,
+                uaRegisteredNodeIds_);
+
+        if (sdkStatus.isGood())
+            ret = uaf::statuscodes::Good;
+        else
+            ret = RegisterNodesInvocationError(sdkStatus);
+
+        return ret;
+    }
+
+
+    // Fill the UAF members
+    // =============================================================================================
+    Status RegisterNodesInvocation::fromSyncSdkToUaf(
+            const NamespaceArray&               nameSpaceArray,
+            const ServerArray&                  serverArray,
+            vector<RegisterNodesResultTarget>&  targets)
+    {
+        // declare the return Status
+        Status ret;
+
+        // declare the number of results, and resize the output parameter accordingly
+        uint32_t noOfResults = uaRegisteredNodeIds_.length();
+        targets.resize(noOfResults);
+
+        // check the number of targets
+        if (noOfResults == uaNodesToRegister_.length())
+        {
+            for (uint32_t i = 0; i < noOfResults; i++)
+            {
+                nameSpaceArray.fillNodeId(uaRegisteredNodeIds_[i], targets[i].registeredNodeId);
+                targets[i].status = statuscodes::Good;
+
+                // remember the alias exactly as it is known by the server (i.e. with its
+                // namespace index, without namespace URI)
+                if (i < nodeIds_.size() && !nodeIds_[i].isNull())
+                {
+                    NodeId registeredNodeId;
+                    registeredNodeId.fromSdk(uaRegisteredNodeIds_[i]);
+                    registered_.push_back(pair<NodeId, NodeId>(nodeIds_[i], registeredNodeId));
+                }
+            }
+
+            ret = statuscodes::Good;
+        }
+        else
+        {
+            ret = UnexpectedError("Number of results does not match number of targets");
+        }
+
+        return ret;
+    }
+
+
+    // Update the registered nodes of the session
+    // =============================================================================================
+    void RegisterNodesInvocation::updateRegisteredNodes(RegisteredNodes& registeredNodes) const
+    {
+        for (size_t i = 0; i < registered_.size(); i++)
+            registeredNodes.add(registered_[i].first, registered_[i].second);
+    }
+
+
+}
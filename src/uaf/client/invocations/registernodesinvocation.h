@@ -0,0 +1,113 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef UAF_REGISTERNODESINVOCATION_H_
+#define UAF_REGISTERNODESINVOCATION_H_
+
+
+// STD
+#include <vector>
+#include <string>
+#include <map>
+#include <utility>
+// SDK
+#include "uaclient/uaclientsdk.h"
+// UAF
+#include "uaf/client/clientexport.h"
+#include "uaf/client/requests/requests.h"
+#include "uaf/client/results/results.h"
+#include "uaf/client/invocations/baseserviceinvocation.h"
+
+namespace uaf
+{
+
+    /*******************************************************************************************//**
+    * An uaf::RegisterNodesInvocation wraps the functional SDK code to invoke the RegisterNodes
+    * service.
+    *
+    * @ingroup ClientInvocations
+    ***********************************************************************************************/
+    class UAF_EXPORT RegisterNodesInvocation
+    : public uaf::BaseServiceInvocation< uaf::RegisterNodesSettings,
+                                          uaf::RegisterNodesRequestTarget,
+                                          uaf::RegisterNodesResultTarget >
+    {
+    public:
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        void updateRegisteredNodes(uaf::RegisteredNodes& registeredNodes) const;
+
+
+    private:
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        uaf::Status fromSyncUafToSdk(
+                const std::vector<uaf::RegisterNodesRequestTarget>&  targets,
+                const uaf::RegisterNodesSettings&                    settings,
+                const uaf::NamespaceArray&                           nameSpaceArray,
+                const uaf::ServerArray&                              serverArray);
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        uaf::Status invokeSyncSdkService(UaClientSdk::UaSession* uaSession);
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        uaf::Status fromSyncSdkToUaf(
+                const uaf::NamespaceArray&                    nameSpaceArray,
+                const uaf::ServerArray&                       serverArray,
+                std::vector<uaf::RegisterNodesResultTarget>&  targets);
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxNodesPerRegisterNodes; }
+
+
+        // private data members used during the invocation
+        UaClientSdk::ServiceSettings    uaServiceSettings_;
+        UaNodeIdArray                   uaNodesToRegister_;
+        UaNodeIdArray                   uaRegisteredNodeIds_;
+        // the nodes (with namespace URI) of the chunk that is being registered
+        std::vector<uaf::NodeId>        nodeIds_;
+        // the nodes (with namespace URI) and their aliases that were registered
+        std::vector< std::pair<uaf::NodeId, uaf::NodeId> > registered_;
+
+    };
+
+}
+
+
+
+#endif /* UAF_REGISTERNODESINVOCATION_H_ */
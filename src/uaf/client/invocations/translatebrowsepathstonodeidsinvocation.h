@@ -97,6 +97,13 @@ namespace uaf
                 std::vector<uaf::TranslateBrowsePathsToNodeIdsResultTarget>&   targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxNodesPerTranslateBrowsePathsToNodeIds; }
+
+
         // private data members used during the invocation
         UaClientSdk::ServiceSettings    uaServiceSettings_;
         UaBrowsePaths                   uaBrowsePaths_;
@@ -0,0 +1,119 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "uaf/client/invocations/unregisternodesinvocation.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::size_t;
+
+
+    // Fill the synchronous SDK members
+    // =============================================================================================
+    Status UnregisterNodesInvocation::fromSyncUafToSdk(
+            const vector<UnregisterNodesRequestTarget>& targets,
+            const UnregisterNodesSettings&              settings,
+            const NamespaceArray&                       nameSpaceArray,
+            const ServerArray&                          serverArray)
+    {
+        Status ret;
+
+        // update the uaServiceSettings_
+        ret = settings.toSdk(uaServiceSettings_);
+
+        // declare the number of targets
+        size_t noOfTargets = targets.size();
+
+        // resize the number of uaNodesToUnregister_
+        uaNodesToUnregister_.create(noOfTargets);
+
+        // loop through the targets
+        for (size_t i = 0; i < noOfTargets && ret.isGood(); i++)
+        {
+            // the server expects the aliases that it has assigned to the registered nodes
+            ret = registeredNodes().fillOpcUaNodeId(
+                    targets[i].address,
+                    nameSpaceArray,
+                    uaNodesToUnregister_[i]);
+
+            // remember the original node (with its namespace URI), so it can be forgotten
+            // by the session once it has been unregistered
+            NodeId nodeId;
+            if (ret.isGood()
+                    && RegisteredNodes::findKey(targets[i].address, nameSpaceArray, nodeId))
+                unregistered_.push_back(nodeId);
+        }
+
+        return ret;
+    }
+
+
+    // Invoke the service synchronously
+    // =============================================================================================
+    Status UnregisterNodesInvocation::invokeSyncSdkService(UaClientSdk::UaSession* uaSession)
+    {
+        Status ret;
+
+        UaStatus sdkStatus = uaSession->unregisterNodes(
+                uaServiceSettings_,
+                uaNodesToUnregister_);
+
+        if (sdkStatus.isGood())
+            ret = uaf::statuscodes::Good;
+        else
+            ret = UnregisterNodesInvocationError(sdkStatus);
+
+        return ret;
+    }
+
+
+    // Fill the UAF members
+    // =============================================================================================
+    Status UnregisterNodesInvocation::fromSyncSdkToUaf(
+            const NamespaceArray&                   nameSpaceArray,
+            const ServerArray&                      serverArray,
+            vector<UnregisterNodesResultTarget>&    targets)
+    {
+        // the UnregisterNodes service has no results per node: if the service call succeeded,
+        // all nodes have been unregistered
+        targets.resize(uaNodesToUnregister_.length());
+
+        for (size_t i = 0; i < targets.size(); i++)
+            targets[i].status = statuscodes::Good;
+
+        return statuscodes::Good;
+    }
+
+
+    // Update the registered nodes of the session
+    // =============================================================================================
+    void UnregisterNodesInvocation::updateRegisteredNodes(RegisteredNodes& registeredNodes) const
+    {
+        for (size_t i = 0; i < unregistered_.size(); i++)
+            registeredNodes.remove(unregistered_[i]);
+    }
+
+
+}
@@ -26,6 +26,7 @@ namespace uaf
     using std::string;
     using std::stringstream;
     using std::vector;
+    using std::size_t;
 
 
     // Fill the synchronous SDK members
@@ -51,7 +52,10 @@ namespace uaf
         for (size_t i = 0; i < noOfTargets && ret.isGood(); i++)
         {
             // update the node id of the target
-            ret = nameSpaceArray.fillOpcUaNodeId(targets[i].address, uaWriteValues_[i].NodeId);
+            ret = registeredNodes().fillOpcUaNodeId(
+                    targets[i].address,
+                    nameSpaceArray,
+                    uaWriteValues_[i].NodeId);
 
             // only update the rest of the SDK variables if no error has occurred yet
             if (ret.isGood())
@@ -143,28 +147,55 @@ namespace uaf
             const NamespaceArray&       nameSpaceArray,
             const ServerArray&          serverArray,
             vector<WriteResultTarget>&  targets)
+    {
+        return copyStatusCodes(uaStatusCodes_, uaWriteValues_.length(), targets);
+    }
+
+
+    // Fill the UAF members of a pipelined chunk
+    // =============================================================================================
+    Status WriteInvocation::fromPipelinedSdkToUaf(
+            const ChunkResponse&        response,
+            size_t                      noOfTargets,
+            const NamespaceArray&       nameSpaceArray,
+            const ServerArray&          serverArray,
+            vector<WriteResultTarget>&  targets)
+    {
+        if (response.status.isBad())
+            return WriteInvocationError(SdkStatus(response.status));
+
+        return copyStatusCodes(response.statusCodes, noOfTargets, targets);
+    }
+
+
+    // Copy the status codes to the targets
+    // =============================================================================================
+    Status WriteInvocation::copyStatusCodes(
+            const UaStatusCodeArray&    uaStatusCodes,
+            size_t                      noOfTargets,
+            vector<WriteResultTarget>&  targets)
     {
         // declare the return Status
         Status ret;
 
-        // declare the number of targets, and resize the output parameter accordingly
-        uint32_t noOfTargets = uaStatusCodes_.length();
-        targets.resize(noOfTargets);
+        // declare the number of results, and resize the output parameter accordingly
+        uint32_t noOfResults = uaStatusCodes.length();
+        targets.resize(noOfResults);
 
         // check the number of targets
-        if (noOfTargets == uaWriteValues_.length())
+        if (noOfResults == noOfTargets)
         {
 
-            for (uint32_t i=0; i<noOfTargets ; i++)
+            for (uint32_t i=0; i<noOfResults ; i++)
             {
                 // update the status
-                if (OpcUa_IsGood(uaStatusCodes_[i]))
+                if (OpcUa_IsGood(uaStatusCodes[i]))
                     targets[i].status = statuscodes::Good;
                 else
-                    targets[i].status = ServerCouldNotWriteError(SdkStatus(uaStatusCodes_[i]));
+                    targets[i].status = ServerCouldNotWriteError(SdkStatus(uaStatusCodes[i]));
 
                 // update the status code
-                targets[i].opcUaStatusCode = uaStatusCodes_[i];
+                targets[i].opcUaStatusCode = uaStatusCodes[i];
             }
 
             ret = uaf::statuscodes::Good;
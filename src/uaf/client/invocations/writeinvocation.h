@@ -96,6 +96,50 @@ namespace uaf
                 std::vector<uaf::WriteResultTarget>&   targets);
 
 
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        bool supportsPipelining() const { return true; }
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        bool supportsRegisteredNodes() const { return true; }
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        uaf::Status fromPipelinedSdkToUaf(
+                const uaf::ChunkResponse&               response,
+                std::size_t                             noOfTargets,
+                const uaf::NamespaceArray&              nameSpaceArray,
+                const uaf::ServerArray&                 serverArray,
+                std::vector<uaf::WriteResultTarget>&   targets);
+
+
+        /**
+         * Copy the status codes of a Write call to the given targets.
+         *
+         * @param uaStatusCodes     The status codes as received from the SDK.
+         * @param noOfTargets       The number of targets that were written.
+         * @param targets           Output parameter: the targets to be updated.
+         * @return                  Good if the status codes could be copied, bad if not.
+         */
+        static uaf::Status copyStatusCodes(
+                const UaStatusCodeArray&                uaStatusCodes,
+                std::size_t                             noOfTargets,
+                std::vector<uaf::WriteResultTarget>&   targets);
+
+
+        /**
+         * Overridden function from uaf::BaseServiceInvocation.
+         */
+        std::size_t serverOperationLimit(const uaf::OperationLimits& operationLimits) const
+        { return operationLimits.maxNodesPerWrite; }
+
+
         // private data members used during the invocation
         UaClientSdk::ServiceSettings    uaServiceSettings_;
         UaWriteValues                   uaWriteValues_;
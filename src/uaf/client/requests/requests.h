@@ -37,6 +37,8 @@
 #include "uaf/client/requests/browserequesttarget.h"
 #include "uaf/client/requests/browsenextrequesttarget.h"
 #include "uaf/client/requests/historyreadrawmodifiedrequesttarget.h"
+#include "uaf/client/requests/registernodesrequesttarget.h"
+#include "uaf/client/requests/unregisternodesrequesttarget.h"
 
 
 
@@ -72,6 +74,8 @@ namespace uaf
     DEFINE_SYNC_SESSIONREQUEST(Browse)
     DEFINE_SYNC_SESSIONREQUEST(BrowseNext)
     DEFINE_SYNC_SESSIONREQUEST(HistoryReadRawModified)
+    DEFINE_SYNC_SESSIONREQUEST(RegisterNodes)
+    DEFINE_SYNC_SESSIONREQUEST(UnregisterNodes)
     DEFINE_SYNC_SUBSCRIPTIONREQUEST(CreateMonitoredData)
     DEFINE_SYNC_SUBSCRIPTIONREQUEST(CreateMonitoredEvents)
 
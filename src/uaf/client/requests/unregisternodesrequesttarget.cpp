@@ -0,0 +1,124 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/requests/unregisternodesrequesttarget.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+
+
+
+    // Constructor
+    // =============================================================================================
+    UnregisterNodesRequestTarget::UnregisterNodesRequestTarget()
+    {}
+
+
+    // Constructor
+    // =============================================================================================
+    UnregisterNodesRequestTarget::UnregisterNodesRequestTarget(const Address& address)
+    : address(address)
+    {}
+
+
+    // Get a string representation
+    // =============================================================================================
+    string UnregisterNodesRequestTarget::toString(const string& indent, std::size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - address\n";
+        ss << address.toString(indent + "   ", colon);
+
+        return ss.str();
+    }
+
+    // operator==
+    // =============================================================================================
+    bool operator==(const UnregisterNodesRequestTarget& object1, const UnregisterNodesRequestTarget& object2)
+    {
+        return object1.address == object2.address;
+    }
+
+    // operator!=
+    // =============================================================================================
+    bool operator!=(const UnregisterNodesRequestTarget& object1, const UnregisterNodesRequestTarget& object2)
+    {
+        return !(object1 == object2);
+    }
+
+    // operator<
+    // =============================================================================================
+    bool operator<(const UnregisterNodesRequestTarget& object1, const UnregisterNodesRequestTarget& object2)
+    {
+        return object1.address < object2.address;
+    }
+
+
+    // Get the resolvable items
+    // =============================================================================================
+    vector<Address> UnregisterNodesRequestTarget::getResolvableItems() const
+    {
+        vector<Address> ret;
+        ret.push_back(address);
+        return ret;
+    }
+
+
+    // Set the resolved items
+    // =============================================================================================
+    Status UnregisterNodesRequestTarget::setResolvedItems(
+            const vector<ExpandedNodeId>& expandedNodeIds,
+            const vector<Status>&         resolutionStatuses)
+    {
+        Status ret;
+
+        if (   expandedNodeIds.size()    == resolvableItemsCount()
+            && resolutionStatuses.size() == resolvableItemsCount())
+        {
+            if (resolutionStatuses[0].isGood())
+                address = Address(expandedNodeIds[0]);
+
+            ret = statuscodes::Good;
+        }
+        else
+        {
+            ret = UnexpectedError("Could not set the resolved items");
+        }
+
+        return ret;
+    }
+
+
+    // Get the server URI
+    // =============================================================================================
+    Status UnregisterNodesRequestTarget::getServerUri(string& serverUri) const
+    {
+        return extractServerUri(address, serverUri);
+    }
+
+
+
+}
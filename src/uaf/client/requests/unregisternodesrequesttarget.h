@@ -0,0 +1,136 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_UNREGISTERNODESREQUESTTARGET_H_
+#define UAF_UNREGISTERNODESREQUESTTARGET_H_
+
+
+
+// STD
+// SDK
+// UAF
+#include "uaf/util/address.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/requests/basesessionrequesttarget.h"
+#include "uaf/client/settings/allsettings.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * A uaf::UnregisterNodesRequestTarget is the part of a uaf::UnregisterNodesRequest that
+    * specifies a node to be unregistered.
+    *
+    * The address is the (original) address of a node that was registered before by a
+    * uaf::RegisterNodesRequest: the session will unregister its alias.
+    *
+    * @ingroup ClientRequests
+    ***********************************************************************************************/
+    class UAF_EXPORT UnregisterNodesRequestTarget : public uaf::BaseSessionRequestTarget
+    {
+    public:
+
+        /**
+         * Construct an empty target.
+         */
+        UnregisterNodesRequestTarget();
+
+
+        /**
+         * Construct a target for a given address.
+         *
+         * @param address   Address of the node to be unregistered.
+         */
+        UnregisterNodesRequestTarget(const uaf::Address& address);
+
+
+        /**
+         * Virtual destructor.
+         */
+        virtual ~UnregisterNodesRequestTarget() {}
+
+
+        /** The address of the node to be unregistered. */
+        uaf::Address address;
+
+
+        /**
+         * Get the server URI to which the service should be invoked for this target.
+         *
+         * @param serverUri The server URI as an output parameter.
+         * @return          A good status if a server URI could be synthesized, a bad one if not.
+         */
+        uaf::Status getServerUri(std::string& serverUri) const;
+
+
+        /**
+         * Get a string representation of the target.
+         *
+         * @return  String representation
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=22) const;
+
+
+        // comparison operators
+        friend bool UAF_EXPORT operator==(const UnregisterNodesRequestTarget& object1, const UnregisterNodesRequestTarget& object2);
+        friend bool UAF_EXPORT operator!=(const UnregisterNodesRequestTarget& object1, const UnregisterNodesRequestTarget& object2);
+        friend bool UAF_EXPORT operator<(const UnregisterNodesRequestTarget& object1, const UnregisterNodesRequestTarget& object2);
+
+
+
+    private:
+
+        // the Resolver can see all private members
+        friend class Resolver;
+
+
+        /**
+         * Get the resolvable items from the target as a "flat" list of Addresses.
+         */
+        std::vector<uaf::Address> getResolvableItems() const;
+
+
+        /**
+         * Get the number of resolvable items of this target.
+         */
+        std::size_t resolvableItemsCount() const { return 1; }
+
+
+        /**
+         * Set the resolved items as a "flat" list of ExpandedNodeIds and Statuses.
+         */
+        uaf::Status setResolvedItems(
+                const std::vector<uaf::ExpandedNodeId>& expandedNodeIds,
+                const std::vector<uaf::Status>&         resolutionStatuses);
+
+
+
+    };
+
+
+
+
+}
+
+
+#endif /* UAF_UNREGISTERNODESREQUESTTARGET_H_ */
@@ -0,0 +1,119 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/resolution/browsepathtrie.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::vector;
+    using std::map;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    BrowsePathTrie::BrowsePathTrie()
+    {}
+
+
+    // Add a browse path
+    // =============================================================================================
+    size_t BrowsePathTrie::add(const BrowsePath& browsePath)
+    {
+        // get (or create) the root node of the starting ExpandedNodeId
+        size_t current;
+        map<ExpandedNodeId, size_t>::const_iterator rootIter = roots_.find(
+                browsePath.startingExpandedNodeId);
+        if (rootIter != roots_.end())
+        {
+            current = rootIter->second;
+        }
+        else
+        {
+            current = nodes_.size();
+            nodes_.push_back(Node());
+            roots_[browsePath.startingExpandedNodeId] = current;
+        }
+
+        // walk (or create) the nodes of the relative path elements
+        vector<size_t> path;
+        path.reserve(browsePath.relativePath.size());
+        for (size_t i = 0; i < browsePath.relativePath.size(); i++)
+        {
+            const RelativePathElement& element = browsePath.relativePath[i];
+            map<RelativePathElement, size_t>::const_iterator childIter
+                = nodes_[current].children.find(element);
+
+            if (childIter != nodes_[current].children.end())
+            {
+                current = childIter->second;
+            }
+            else
+            {
+                // don't keep a reference to nodes_[current] here, push_back may reallocate!
+                size_t child = nodes_.size();
+                nodes_.push_back(Node());
+                nodes_[current].children[element] = child;
+                current = child;
+            }
+
+            nodes_[current].count++;
+            path.push_back(current);
+        }
+
+        paths_.push_back(path);
+        return paths_.size() - 1;
+    }
+
+
+    // Find the longest shared prefix of a browse path
+    // =============================================================================================
+    bool BrowsePathTrie::findSharedPrefix(
+            size_t  pathId,
+            size_t& prefixNode,
+            size_t& prefixLength,
+            size_t  minCount) const
+    {
+        if (pathId >= paths_.size())
+            return false;
+
+        // a prefix is only shared if at least one other browse path has it
+        if (minCount < 2)
+            minCount = 2;
+
+        const vector<size_t>& path = paths_[pathId];
+
+        // walk back from the parent of the last element, the first node that is shared with
+        // enough other browse paths is the longest shared prefix
+        for (size_t length = path.size() - 1; length > 0 && length < path.size(); length--)
+        {
+            if (nodes_[path[length - 1]].count >= minCount)
+            {
+                prefixNode   = path[length - 1];
+                prefixLength = length;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+}
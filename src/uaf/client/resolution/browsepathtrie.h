@@ -0,0 +1,126 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_BROWSEPATHTRIE_H_
+#define UAF_BROWSEPATHTRIE_H_
+
+
+// STD
+#include <vector>
+#include <map>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/browsepath.h"
+#include "uaf/util/expandednodeid.h"
+#include "uaf/util/relativepathelement.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::BrowsePathTrie stores a number of browse paths as a prefix tree, so that the
+    * prefixes that are shared by several browse paths can be found.
+    *
+    * The roots of the tree are the starting ExpandedNodeIds of the browse paths, and every node
+    * below them corresponds to a relative path element. Each node counts the number of browse
+    * paths that pass through it.
+    *
+    * The uaf::Resolver uses it to translate a shared prefix only once, instead of letting the
+    * server walk the same prefix again for every browse path.
+    *
+    * @ingroup ClientResolution
+    ***********************************************************************************************/
+    class UAF_EXPORT BrowsePathTrie
+    {
+    public:
+
+
+        /**
+         * Construct an empty trie.
+         */
+        BrowsePathTrie();
+
+
+        /**
+         * Add a browse path to the trie.
+         *
+         * @param browsePath    The browse path to add.
+         * @return              The id of the browse path within the trie (0 for the first browse
+         *                      path that was added, 1 for the second, and so on).
+         */
+        std::size_t add(const uaf::BrowsePath& browsePath);
+
+
+        /**
+         * Find the longest prefix of a browse path that is shared by a minimum number of
+         * browse paths of the trie (including the browse path itself).
+         *
+         * Only proper prefixes (i.e. with at least one element, but less elements than the
+         * browse path itself) are considered, since a prefix is only useful if a suffix remains.
+         *
+         * @param pathId        The id of the browse path, as returned by add().
+         * @param prefixNode    Output parameter: an id of the prefix, which is the same for all
+         *                      browse paths that share the same prefix.
+         * @param prefixLength  Output parameter: the number of elements of the prefix.
+         * @param minCount      The minimum number of browse paths that must share the prefix.
+         * @return              True if a shared prefix was found, false if not.
+         */
+        bool findSharedPrefix(
+                std::size_t     pathId,
+                std::size_t&    prefixNode,
+                std::size_t&    prefixLength,
+                std::size_t     minCount = 2) const;
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(BrowsePathTrie);
+
+
+        /**
+         * A node of the trie.
+         */
+        struct Node
+        {
+            Node() : count(0) {}
+            // the child nodes, per relative path element
+            std::map<uaf::RelativePathElement, std::size_t> children;
+            // the number of browse paths that pass through this node
+            std::size_t count;
+        };
+
+
+        // the nodes of the trie
+        std::vector<Node> nodes_;
+        // the root nodes, per starting ExpandedNodeId
+        std::map<uaf::ExpandedNodeId, std::size_t> roots_;
+        // the nodes of every added browse path (the element nodes only, without the root)
+        std::vector< std::vector<std::size_t> > paths_;
+    };
+
+}
+
+
+#endif /* UAF_BROWSEPATHTRIE_H_ */
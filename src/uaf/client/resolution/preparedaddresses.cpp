@@ -0,0 +1,69 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/resolution/preparedaddresses.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    PreparedAddresses::PreparedAddresses()
+    : handle(0)
+    {}
+
+
+    // Get a string representation
+    // =============================================================================================
+    string PreparedAddresses::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - handle";
+        ss << fillToPos(ss, colon);
+        ss << ": " << handle << "\n";
+
+        ss << indent << " - statuses[]";
+        if (statuses.size() == 0)
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []\n";
+        }
+        else
+        {
+            ss << "\n";
+            for (size_t i = 0; i < statuses.size(); i++)
+            {
+                ss << indent << "    - statuses[" << i << "]";
+                ss << fillToPos(ss, colon);
+                ss << ": " << statuses[i].toString() << "\n";
+            }
+        }
+
+        return ss.str();
+    }
+
+}
@@ -0,0 +1,101 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_PREPAREDADDRESSES_H_
+#define UAF_PREPAREDADDRESSES_H_
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/status.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /**
+     * A PreparedAddressesHandle identifies a set of addresses that were prepared by a client.
+     *
+     * @ingroup ClientResolution
+     */
+    typedef uint64_t PreparedAddressesHandle;
+
+
+    /*******************************************************************************************//**
+    * An uaf::PreparedAddresses instance is an opaque handle to a number of addresses that were
+    * prepared by uaf::Client::prepare().
+    *
+    * The client resolves the prepared addresses once, and keeps their resolved node ids (with
+    * the namespace indexes of their servers) for all following read, write and
+    * createMonitoredData calls. They are resolved again automatically when the cached addresses
+    * of their server are cleared or invalidated (e.g. because the session was reconnected, or
+    * the address space has changed), or when the namespace array of their server has changed.
+    *
+    * @ingroup ClientResolution
+    ***********************************************************************************************/
+    class UAF_EXPORT PreparedAddresses
+    {
+    public:
+
+
+        /**
+         * Construct an empty (i.e. unprepared) instance.
+         */
+        PreparedAddresses();
+
+
+        /** The handle of the prepared addresses (only meaningful for the client that prepared
+         *  them). */
+        uaf::PreparedAddressesHandle handle;
+
+        /** The statuses of the resolution of the addresses, at the time they were prepared
+         *  (one status per address). */
+        std::vector<uaf::Status> statuses;
+
+
+        /**
+         * Get the number of prepared addresses.
+         *
+         * @return  The number of addresses.
+         */
+        std::size_t size() const { return statuses.size(); }
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return string representation
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=20) const;
+    };
+
+}
+
+
+#endif /* UAF_PREPAREDADDRESSES_H_ */
@@ -26,6 +26,7 @@ namespace uaf
     using std::string;
     using std::vector;
     using std::map;
+    using std::set;
     using std::size_t;
 
 
@@ -36,7 +37,8 @@ namespace uaf
             SessionFactory* sessionFactory,
             Database*       database)
     : sessionFactory_(sessionFactory),
-      database_(database)
+      database_(database),
+      unresolvableTimeToLiveMs_(0)
     {
         logger_ = new Logger(loggerFactory, "Resolver");
         logger_->debug("The resolver has been constructed");
@@ -73,12 +75,14 @@ namespace uaf
         expandedNodeIdMask.resize(noOfAddresses);
         relativePathMask.resize(noOfAddresses);
 
+        // look up all addresses at once
+        Mask foundMask;
+        database_->addressCache.find(addresses, expandedNodeIds, foundMask);
+
         // loop through the addresses
         for (size_t i=0; i<noOfAddresses; i++)
         {
-            logger_->debug("Trying to find address %d in the cache", i);
-
-            if (database_->addressCache.find(addresses[i], expandedNodeIds[i]))
+            if (foundMask.isSet(i))
             {
                 statuses[i] = statuscodes::Good;
                 logger_->debug("Address %d was already cached", i);
@@ -104,10 +108,134 @@ namespace uaf
             }
         }
 
+        // the relative paths that could not be resolved recently, are not resolved again
+        if (ret.isGood() && relativePathMask.setCount() > 0)
+        {
+            size_t noOfFound = findUnresolvable(addresses, relativePathMask, statuses);
+            if (noOfFound > 0)
+                logger_->debug("%d relative paths are known to be unresolvable", noOfFound);
+        }
+
         return ret;
     }
 
 
+    // Set the time to live of the unresolvable relative paths
+    //==============================================================================================
+    void Resolver::setUnresolvableTimeToLive(double timeToLiveSec)
+    {
+        UaMutexLocker locker(&unresolvableMutex_); // unlocks when locker goes out of scope
+
+        unresolvableTimeToLiveMs_ = timeToLiveSec > 0.0 ? int64_t(timeToLiveSec * 1000.0) : 0;
+
+        // forget them all if they shouldn't be remembered anymore
+        if (unresolvableTimeToLiveMs_ == 0)
+            unresolvables_.clear();
+
+        logger_->debug("Unresolvable relative paths are now remembered for %.3f seconds",
+                       unresolvableTimeToLiveMs_ / 1000.0);
+    }
+
+
+    // Look up the relative paths that are remembered as unresolvable
+    //==============================================================================================
+    size_t Resolver::findUnresolvable(
+            const vector<Address>&  addresses,
+            Mask&                   relativePathMask,
+            vector<Status>&         statuses)
+    {
+        size_t noOfFound = 0;
+
+        UaMutexLocker locker(&unresolvableMutex_); // unlocks when locker goes out of scope
+
+        if (unresolvables_.empty())
+            return noOfFound;
+
+        int64_t now = int64_t(UaDateTime::now());
+
+        for (size_t i = 0; i < addresses.size(); i++)
+        {
+            if (relativePathMask.isUnset(i))
+                continue;
+
+            UnresolvableMap::iterator it = unresolvables_.find(addresses[i]);
+
+            if (it == unresolvables_.end())
+                continue;
+
+            // forget the failure if it has expired, or if the cached addresses of the server
+            // have been cleared or invalidated (or its namespace array has changed) since then
+            if (   now >= it->second.expiryTime
+                || database_->addressCache.generation(it->second.serverUri) > it->second.generation)
+            {
+                unresolvables_.erase(it);
+            }
+            else
+            {
+                statuses[i] = it->second.status;
+                relativePathMask.unset(i);
+                noOfFound++;
+            }
+        }
+
+        return noOfFound;
+    }
+
+
+    // Remember the relative paths that could not be resolved
+    //==============================================================================================
+    void Resolver::addUnresolvable(
+            const vector<Address>&  addresses,
+            const Mask&             relativePathMask,
+            const vector<Status>&   statuses,
+            uint64_t                generation)
+    {
+        UaMutexLocker locker(&unresolvableMutex_); // unlocks when locker goes out of scope
+
+        if (unresolvableTimeToLiveMs_ == 0)
+            return;
+
+        int64_t now = int64_t(UaDateTime::now());
+
+        // forget the expired failures first, so that they don't pile up
+        for (UnresolvableMap::iterator it = unresolvables_.begin(); it != unresolvables_.end();)
+        {
+            if (now >= it->second.expiryTime)
+                unresolvables_.erase(it++);
+            else
+                ++it;
+        }
+
+        for (size_t i = 0; i < addresses.size(); i++)
+        {
+            // an unknown server is not remembered, since it may be discovered at any time
+            if (relativePathMask.isSet(i)
+                    && statuses[i].isBad()
+                    && statuses[i].statusCode != statuscodes::UnknownServerError)
+            {
+                Unresolvable& unresolvable = unresolvables_[addresses[i]];
+                unresolvable.status     = statuses[i];
+                unresolvable.serverUri  = firstServerUri(addresses[i]);
+                unresolvable.generation = generation;
+                unresolvable.expiryTime = now + unresolvableTimeToLiveMs_ * 10000; // 100 ns ticks
+            }
+        }
+    }
+
+
+    // Get the server URI of the first starting address of a relative path
+    //==============================================================================================
+    string Resolver::firstServerUri(const Address& address)
+    {
+        const Address* current = &address;
+
+        while (current->isRelativePath())
+            current = current->getStartingAddress();
+
+        return current->getExpandedNodeId().serverUri();
+    }
+
+
 
     // Resolve some addresses
     //==============================================================================================
@@ -125,11 +253,14 @@ namespace uaf
         size_t noOfAddresses = addresses.size();
 
         // log a nice message
-        logger_->debug("Resolving the following addresses:");
-        for (size_t i=0; i<noOfAddresses; i++)
+        if (logger_->isDebugEnabled())
         {
-            logger_->debug(" - Address %d", i);
-            logger_->debug(addresses[i].toString("   ", 28));
+            logger_->debug("Resolving the following addresses:");
+            for (size_t i=0; i<noOfAddresses; i++)
+            {
+                logger_->debug(" - Address %d", i);
+                logger_->debug(addresses[i].toString("   ", 28));
+            }
         }
 
         // prepare the output parameters by resizing them
@@ -171,6 +302,129 @@ namespace uaf
 
 
 
+    // Find the namespace index of a namespace URI, in the current namespace array of a server
+    //==============================================================================================
+    bool Resolver::findNamespaceIndex(
+            const string&                   serverUri,
+            const string&                   namespaceUri,
+            map<string, NamespaceArray>&    namespaceArrays,
+            NameSpaceIndex&                 namespaceIndex)
+    {
+        map<string, NamespaceArray>::iterator it = namespaceArrays.find(serverUri);
+
+        // get the namespace array from the cache, only once per server (it remains empty if the
+        // server has not been connected yet)
+        if (it == namespaceArrays.end())
+        {
+            it = namespaceArrays.insert(std::make_pair(serverUri, NamespaceArray())).first;
+            database_->addressCache.findNamespaceArray(serverUri, it->second);
+            it->second.setMemoizing(true);
+        }
+
+        return it->second.findNamespaceIndex(namespaceUri, namespaceIndex);
+    }
+
+
+    // Bind the addresses of a prepared item
+    //==============================================================================================
+    Status Resolver::bind(PreparedAddressStore::Item& item)
+    {
+        // declare the return status
+        Status ret(statuscodes::Good);
+
+        // declare the number of addresses
+        size_t noOfAddresses = item.addresses.size();
+
+        // find the servers of which the bound addresses may be outdated
+        set<string> changedServers;
+        for (map<string, uint64_t>::const_iterator it = item.generations.begin();
+             it != item.generations.end();
+             ++it)
+        {
+            if (database_->addressCache.generation(it->first) > it->second)
+                changedServers.insert(it->first);
+        }
+
+        // mark the addresses that need to be (re)bound
+        Mask mask(noOfAddresses, false);
+        for (size_t i = 0; i < noOfAddresses; i++)
+        {
+            if (!item.isBound || item.statuses[i].isNotGood())
+                mask.set(i);
+            else if (!changedServers.empty())
+            {
+                const string& serverUri = item.boundAddresses[i].getExpandedNodeId().serverUri();
+                if (changedServers.count(serverUri) > 0)
+                    mask.set(i);
+            }
+        }
+
+        if (mask.setCount() == 0)
+            return ret;
+
+        logger_->debug("Binding %d of the %d prepared addresses %d",
+                       mask.setCount(), noOfAddresses, item.handle);
+
+        // any change of the cache after this point will be noticed the next time
+        uint64_t generation = database_->addressCache.generation();
+
+        // resolve the marked addresses
+        vector<Address> addresses;
+        addresses.reserve(mask.setCount());
+        for (size_t i = 0; i < noOfAddresses; i++)
+        {
+            if (mask.isSet(i))
+                addresses.push_back(item.addresses[i]);
+        }
+
+        vector<ExpandedNodeId>  expandedNodeIds;
+        vector<Status>          statuses;
+        ret = resolve(addresses, expandedNodeIds, statuses);
+
+        if (ret.isNotGood())
+            return ret;
+
+        // bind the resolved addresses, using the current namespace arrays of their servers
+        map<string, NamespaceArray> namespaceArrays;
+        for (size_t i = 0, j = 0; i < noOfAddresses; i++)
+        {
+            if (mask.isUnset(i))
+                continue;
+
+            item.statuses[i] = statuses[j];
+
+            if (statuses[j].isGood())
+            {
+                ExpandedNodeId& expandedNodeId = expandedNodeIds[j];
+                string serverUri = expandedNodeId.serverUri();
+                NodeId nodeId = expandedNodeId.nodeId();
+
+                // if the namespace index can't be found (e.g. because the server has not been
+                // connected yet), the namespace URI is kept
+                NameSpaceIndex nameSpaceIndex;
+                if (   nodeId.hasNameSpaceUri()
+                    && findNamespaceIndex(serverUri,
+                                          nodeId.nameSpaceUri(),
+                                          namespaceArrays,
+                                          nameSpaceIndex))
+                {
+                    expandedNodeId.setNodeId(NodeId(nodeId.identifier(), nameSpaceIndex));
+                }
+
+                item.boundAddresses[i] = Address(expandedNodeId);
+                item.generations[serverUri] = generation;
+            }
+
+            j++;
+        }
+
+        item.isBound = true;
+
+        return ret;
+    }
+
+
+
     Status Resolver::verifyExpandedNodeIds(
             const vector<Address>&  addresses,
             const Mask&             mask,
@@ -231,6 +485,10 @@ namespace uaf
         // declare a mask that will indicate which browse paths still need to be translated
         Mask remainingMask = mask;
 
+        // any change of the cache after this point makes the failures of this resolution
+        // outdated
+        uint64_t generation = database_->addressCache.generation();
+
         // first try to resolve the starting addresses (all at once!)
         // the 'remainingMask', 'browsePaths' and 'statuses' will be updated!
         ret = resolveRelativePathsStartingAddresses(
@@ -239,11 +497,25 @@ namespace uaf
                 browsePaths,
                 statuses);
 
+        // resolve the prefixes that are shared by many browse paths only once
+        // the 'browsePaths' will be updated!
+        if (ret.isGood())
+            ret = resolveSharedPrefixes(addresses, remainingMask, browsePaths);
+
         // now try to resolve the relative paths (essentially browse paths since their starting
-        // addresses have been resolved)
+        // addresses (or shared prefixes) have been resolved)
         if (ret.isGood())
             ret = resolveBrowsePaths(browsePaths, remainingMask, results, statuses);
 
+        // an unknown server makes the translation of all browse paths fail, so we find out
+        // which browse paths can't be resolved by translating them per server
+        if (ret.statusCode == statuscodes::UnknownServerError)
+        {
+            Status failure(ret);
+            ret = resolveBrowsePathsPerServer(
+                    browsePaths, remainingMask, results, statuses, failure);
+        }
+
         // add the resolved addresses to the cache
         for (size_t i = 0; i < addresses.size() && ret.isGood(); i++)
         {
@@ -253,6 +525,10 @@ namespace uaf
             }
         }
 
+        // remember the addresses that could not be resolved
+        if (ret.isGood())
+            addUnresolvable(addresses, mask, statuses, generation);
+
         return ret;
     }
 
@@ -314,6 +590,111 @@ namespace uaf
 
 
 
+    // Resolve the prefixes that are shared by several browse paths
+    //==============================================================================================
+    Status Resolver::resolveSharedPrefixes(
+            const vector<Address>&  relativePathAddresses,
+            const Mask&             mask,
+            vector<BrowsePath>&     browsePaths)
+    {
+        // declare the return status
+        Status ret(statuscodes::Good);
+
+        // declare the number of browse paths
+        size_t noOfBrowsePaths = browsePaths.size();
+
+        // a prefix can't be shared by enough browse paths if there aren't enough browse paths
+        if (mask.setCount() < MIN_PATHS_PER_SHARED_PREFIX)
+            return ret;
+
+        // build a trie of the browse paths that still need to be translated
+        BrowsePathTrie trie;
+        vector<size_t> pathIds(noOfBrowsePaths, 0);
+        for (size_t i = 0; i < noOfBrowsePaths; i++)
+        {
+            if (mask.isSet(i))
+                pathIds[i] = trie.add(browsePaths[i]);
+        }
+
+        // create a relative path address for every distinct prefix that is shared by enough
+        // browse paths to pay for the extra round-trip
+        vector<Address>     prefixAddresses;
+        map<size_t, size_t> prefixNodes;                    // prefix node --> prefix address
+        vector<size_t>      prefixLengths(noOfBrowsePaths, 0);
+        vector<size_t>      prefixRanks(noOfBrowsePaths, 0);
+        for (size_t i = 0; i < noOfBrowsePaths; i++)
+        {
+            size_t prefixNode, prefixLength;
+            if (mask.isSet(i)
+                    && trie.findSharedPrefix(
+                            pathIds[i], prefixNode, prefixLength, MIN_PATHS_PER_SHARED_PREFIX))
+            {
+                map<size_t, size_t>::const_iterator iter = prefixNodes.find(prefixNode);
+                if (iter != prefixNodes.end())
+                {
+                    prefixRanks[i] = iter->second;
+                }
+                else
+                {
+                    vector<RelativePathElement> prefix(
+                            browsePaths[i].relativePath.begin(),
+                            browsePaths[i].relativePath.begin() + prefixLength);
+
+                    prefixRanks[i] = prefixAddresses.size();
+                    prefixNodes[prefixNode] = prefixRanks[i];
+                    prefixAddresses.push_back(
+                            Address(relativePathAddresses[i].getStartingAddress(), prefix));
+                }
+                prefixLengths[i] = prefixLength;
+            }
+        }
+
+        if (prefixAddresses.size() == 0)
+        {
+            logger_->debug("The browse paths don't share enough prefixes");
+            return ret;
+        }
+
+        logger_->debug("The browse paths share %d distinct prefixes, resolving them first",
+                       prefixAddresses.size());
+
+        // resolve the prefixes (recursively!), which also adds them to the cache
+        vector<ExpandedNodeId>  prefixResults;
+        vector<Status>          prefixStatuses;
+        Status prefixStatus = resolve(prefixAddresses, prefixResults, prefixStatuses);
+
+        if (prefixStatus.isNotGood())
+        {
+            logger_->debug("The shared prefixes could not be resolved (%s), so the browse paths "
+                           "will be translated in full", prefixStatus.toString().c_str());
+            return ret;
+        }
+
+        // only the suffixes remain to be translated
+        for (size_t i = 0; i < noOfBrowsePaths; i++)
+        {
+            if (mask.isSet(i) && prefixLengths[i] > 0)
+            {
+                size_t rank = prefixRanks[i];
+
+                // if the prefix could not be resolved (e.g. because it is ambiguous), the
+                // browse path is translated in full, since it may still be unique
+                if (prefixStatuses[rank].isGood())
+                {
+                    vector<RelativePathElement> suffix(
+                            browsePaths[i].relativePath.begin() + prefixLengths[i],
+                            browsePaths[i].relativePath.end());
+
+                    browsePaths[i] = BrowsePath(prefixResults[rank], suffix);
+                }
+            }
+        }
+
+        return ret;
+    }
+
+
+
     // Resolve a relative path (which may span over multiple server address spaces!)
     //==============================================================================================
     Status Resolver::resolveBrowsePaths(
@@ -387,6 +768,74 @@ namespace uaf
 
 
 
+    // Resolve the browse paths of each server separately
+    //==============================================================================================
+    Status Resolver::resolveBrowsePathsPerServer(
+            vector<BrowsePath>&     browsePaths,
+            Mask&                   mask,
+            vector<ExpandedNodeId>& results,
+            vector<Status>&         statuses,
+            const Status&           failure)
+    {
+        // declare the return status
+        Status ret(statuscodes::Good);
+
+        // group the browse paths per server URI of their starting node
+        typedef map<string, vector<size_t> > ServerRanksMap;
+        ServerRanksMap serverRanks;
+        for (size_t i = 0; i < browsePaths.size(); i++)
+        {
+            if (mask.isSet(i))
+                serverRanks[browsePaths[i].startingExpandedNodeId.serverUri()].push_back(i);
+        }
+
+        for (ServerRanksMap::const_iterator it = serverRanks.begin();
+             it != serverRanks.end() && ret.isGood();
+             ++it)
+        {
+            const vector<size_t>& ranks = it->second;
+
+            // if all browse paths start at the same server, we know it is the unknown one
+            if (serverRanks.size() == 1)
+            {
+                logger_->error("The %d browse paths starting at ServerUri '%s' cannot be "
+                               "resolved", ranks.size(), it->first.c_str());
+
+                for (size_t j = 0; j < ranks.size(); j++)
+                {
+                    statuses[ranks[j]] = failure;
+                    mask.unset(ranks[j]);
+                }
+            }
+            else
+            {
+                logger_->debug("Resolving the %d browse paths starting at ServerUri '%s' "
+                               "separately", ranks.size(), it->first.c_str());
+
+                Mask serverMask(browsePaths.size(), false);
+                for (size_t j = 0; j < ranks.size(); j++)
+                    serverMask.set(ranks[j]);
+
+                ret = resolveBrowsePaths(browsePaths, serverMask, results, statuses);
+
+                // the remaining browse paths may continue at different servers (recursively!)
+                if (ret.statusCode == statuscodes::UnknownServerError)
+                {
+                    Status serverFailure(ret);
+                    ret = resolveBrowsePathsPerServer(
+                            browsePaths, serverMask, results, statuses, serverFailure);
+                }
+
+                for (size_t j = 0; j < ranks.size(); j++)
+                    mask.unset(ranks[j]);
+            }
+        }
+
+        return ret;
+    }
+
+
+
     void Resolver::processBrowsePathsResolutionResultTarget(
             const TranslateBrowsePathsToNodeIdsResultTarget&    target,
             size_t                                              rank,
@@ -433,8 +882,11 @@ namespace uaf
                     results[rank]  = target.expandedNodeIds[0];
                     statuses[rank] = statuses[0];
 
-                    logger_->debug("Target %d was successfully resolved to:", rank);
-                    logger_->debug(results[rank].toString());
+                    if (logger_->isDebugEnabled())
+                    {
+                        logger_->debug("Target %d was successfully resolved to:", rank);
+                        logger_->debug(results[rank].toString());
+                    }
 
                     // we're finished with this target, so unset the mask item
                     mask.unset(rank);
@@ -475,7 +927,9 @@ namespace uaf
                         // set the new browse path based on the just created elements
                         browsePaths[rank] = BrowsePath(target.expandedNodeIds[0], newElements);
 
-                        logger_->debug("New browse path: %s", browsePaths[rank].toString().c_str());
+                        if (logger_->isDebugEnabled())
+                            logger_->debug("New browse path: %s",
+                                           browsePaths[rank].toString().c_str());
 
                         // we're not finished with this target, so leave the mask item 'set'
                     }
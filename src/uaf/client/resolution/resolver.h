@@ -26,8 +26,12 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
+#include <stdint.h>
 // SDK
 #include "uaclient/uaclientsdk.h"
+#include "uabase/uamutex.h"
+#include "uabase/uadatetime.h"
 // UAF
 #include "uaf/util/logger.h"
 #include "uaf/util/status.h"
@@ -38,6 +42,7 @@
 #include "uaf/client/sessions/sessionfactory.h"
 #include "uaf/client/database/database.h"
 #include "uaf/client/requests/requests.h"
+#include "uaf/client/resolution/browsepathtrie.h"
 
 
 namespace uaf
@@ -50,6 +55,10 @@ namespace uaf
     * The uaf::Resolver uses the TranslateBrowsePathsToNodeIds service to resolve the relative
     * addresses, and uses the uaf::AddressCache to cache the resolution results.
     *
+    * Relative paths that share a common prefix (e.g. many variables below the same object) are
+    * not translated as a whole: the shared prefix is resolved (and cached) only once, and only
+    * the remaining suffixes are translated, starting from the node of the prefix.
+    *
     * @ingroup ClientResolution
     ***********************************************************************************************/
     class UAF_EXPORT Resolver
@@ -90,6 +99,36 @@ namespace uaf
                 std::vector<uaf::Status>&           statuses);
 
 
+        /**
+         * (Re)bind the addresses of a prepared item, as far as needed.
+         *
+         * The addresses are resolved (again) if they have not been bound yet, if they could not
+         * be resolved the previous time, or if the generation of their server (see
+         * uaf::AddressCache::generation()) has changed since they were bound. The namespace URIs
+         * of the resolved NodeIds are replaced by the namespace indexes of the current namespace
+         * array of their server (if it is known), so that the NodeIds don't need to be looked up
+         * in the namespace array anymore when they are used.
+         *
+         * The mutex of the item must be locked!
+         *
+         * @param item  The prepared item.
+         * @return      Good if there were no errors on the client side (e.g. malformed
+         *              addresses), Bad otherwise.
+         */
+        uaf::Status bind(uaf::PreparedAddressStore::Item& item);
+
+
+        /**
+         * Set the time during which relative paths that could not be resolved are remembered
+         * as unresolvable.
+         *
+         * The time to live only applies to the failures that are remembered afterwards.
+         *
+         * @param timeToLiveSec The time in seconds (0 or less to always resolve them again).
+         */
+        void setUnresolvableTimeToLive(double timeToLiveSec);
+
+
         /**
          * Resolve the masked targets of the given request.
          *
@@ -175,6 +214,72 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(Resolver);
 
 
+        /**
+         * The minimum number of browse paths that must share a prefix before the prefix is
+         * resolved on its own, since this costs an extra (sequential) round-trip to the server.
+         */
+        static const std::size_t MIN_PATHS_PER_SHARED_PREFIX = 8;
+
+
+        /** An address that could not be resolved, and the reason why. */
+        struct Unresolvable
+        {
+            /** The status of the failed resolution. */
+            uaf::Status status;
+            /** The server URI of the (first) starting address of the relative path. */
+            std::string serverUri;
+            /** The generation of the address cache before the resolution was started. */
+            uint64_t    generation;
+            /** The time when the failure is forgotten, in 100 nanosecond ticks. */
+            int64_t     expiryTime;
+        };
+
+        /** The addresses that could not be resolved. */
+        typedef std::map<uaf::Address, Unresolvable> UnresolvableMap;
+
+
+        /**
+         * Look up the relative paths that are remembered as unresolvable.
+         *
+         * @param addresses         The addresses.
+         * @param relativePathMask  In-out parameter: the mask indicating the relative paths to
+         *                          look up. The found ones will be 'unset' in the mask.
+         * @param statuses          In-out parameter: the statuses of the found relative paths
+         *                          are updated to the status of their failed resolution.
+         * @return                  The number of addresses that were found.
+         */
+        std::size_t findUnresolvable(
+                const std::vector<uaf::Address>&    addresses,
+                uaf::Mask&                          relativePathMask,
+                std::vector<uaf::Status>&           statuses);
+
+
+        /**
+         * Remember the relative paths that could not be resolved.
+         *
+         * @param addresses         The addresses.
+         * @param relativePathMask  The mask indicating the relative paths that were resolved.
+         * @param statuses          The statuses of the resolution (only the bad ones are
+         *                          remembered, except for unknown servers).
+         * @param generation        The generation of the address cache before the resolution
+         *                          was started.
+         */
+        void addUnresolvable(
+                const std::vector<uaf::Address>&    addresses,
+                const uaf::Mask&                    relativePathMask,
+                const std::vector<uaf::Status>&     statuses,
+                uint64_t                            generation);
+
+
+        /**
+         * Get the server URI of the (first) starting address of a relative path.
+         *
+         * @param address   A relative path address.
+         * @return          The server URI of its first starting address.
+         */
+        static std::string firstServerUri(const uaf::Address& address);
+
+
         /**
          * Resolve an address by only checking the cache.
          *
@@ -237,6 +342,32 @@ namespace uaf
                 std::vector<uaf::Status>&           statuses);
 
 
+        /**
+         * Resolve the prefixes that are shared by several browse paths, and shorten the browse
+         * paths accordingly.
+         *
+         * Only prefixes shared by at least MIN_PATHS_PER_SHARED_PREFIX browse paths are
+         * considered. They are resolved (recursively!) as relative path addresses, so they
+         * end up in the cache, and prefixes shared by the prefixes themselves are also resolved
+         * only once.
+         *
+         * If a prefix cannot be resolved (e.g. because it matches more than one node), the
+         * browse paths that share it are left untouched, so they are translated in full.
+         *
+         * @param relativePathAddresses The addresses that contain relative paths.
+         * @param mask                  The mask indicating the browse paths that still need to
+         *                              be translated.
+         * @param browsePaths           In-out parameter: the browse paths, of which the shared
+         *                              prefixes will be replaced by the resolved prefix nodes.
+         * @return                      Always Good, since the browse paths can always be
+         *                              translated in full.
+         */
+        uaf::Status resolveSharedPrefixes(
+                const std::vector<uaf::Address>&    relativePathAddresses,
+                const uaf::Mask&                    mask,
+                std::vector<uaf::BrowsePath>&       browsePaths);
+
+
         /**
          * Resolve relative paths.
          *
@@ -254,6 +385,24 @@ namespace uaf
                 std::vector<uaf::Status>&           statuses);
 
 
+        /**
+         * Find the namespace index of a namespace URI, in the current namespace array of a
+         * server (as known by the address cache).
+         *
+         * @param serverUri         The server URI.
+         * @param namespaceUri      The namespace URI to look up.
+         * @param namespaceArrays   In-out parameter: the namespace arrays that were already
+         *                          fetched from the address cache, per server URI.
+         * @param namespaceIndex    Output parameter: the namespace index.
+         * @return                  True if the namespace index was found, false if not.
+         */
+        bool findNamespaceIndex(
+                const std::string&                              serverUri,
+                const std::string&                              namespaceUri,
+                std::map<std::string, uaf::NamespaceArray>&     namespaceArrays,
+                uaf::NameSpaceIndex&                            namespaceIndex);
+
+
         /**
          * Resolve BrowsePaths.
          *
@@ -272,6 +421,30 @@ namespace uaf
                 std::vector<uaf::Status>&           statuses);
 
 
+        /**
+         * Resolve the BrowsePaths of each server separately, after the translation of the
+         * BrowsePaths of several servers at once has failed because one of them is unknown.
+         *
+         * The BrowsePaths of the unknown server(s) get the failure as their status, the other
+         * BrowsePaths are resolved normally.
+         *
+         * @param browsePaths   The browse paths of which those indicated by the mask, will
+         *                      be resolved.
+         * @param mask          The mask that indicates the browse paths that will be resolved.
+         * @param results       The resulting ExpandedNodeIds.
+         * @param statuses      The resulting resolution statuses.
+         * @param failure       The status of the failed translation.
+         * @return              Good if there were no errors on the client side (e.g. malformed
+         *                      addresses), Bad otherwise.
+         */
+        uaf::Status resolveBrowsePathsPerServer(
+                std::vector<uaf::BrowsePath>&       browsePaths,
+                uaf::Mask&                          mask,
+                std::vector<uaf::ExpandedNodeId>&   results,
+                std::vector<uaf::Status>&           statuses,
+                const uaf::Status&                  failure);
+
+
         /**
          * Process the result of a browse path translation result, to see if the resolution was
          * OK, or whether the translation was not completed and additional translations are needed.
@@ -423,6 +596,12 @@ namespace uaf
         uaf::SessionFactory* sessionFactory_; // not owned!
         // pointer to the shared database
         uaf::Database* database_; // not owned!
+        // the relative paths that could not be resolved
+        UnresolvableMap unresolvables_;
+        // the time during which unresolvable relative paths are remembered, in milliseconds
+        int64_t unresolvableTimeToLiveMs_;
+        // the mutex to safely manipulate the unresolvable relative paths and their time to live
+        UaMutex unresolvableMutex_;
 
     };
 
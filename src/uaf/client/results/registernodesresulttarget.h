@@ -0,0 +1,92 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_REGISTERNODESRESULTTARGET_H_
+#define UAF_REGISTERNODESRESULTTARGET_H_
+
+
+
+// STD
+// SDK
+// UAF
+#include "uaf/util/status.h"
+#include "uaf/util/nodeid.h"
+#include "uaf/util/handles.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/results/basesessionresulttarget.h"
+
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::RegisterNodesResultTarget is the "result target" of the corresponding
+    * "request target" that specified the node to be registered.
+    *
+    * It tells you if the node was registered, and which alias the server has assigned to it.
+    *
+    * @ingroup ClientResults
+    ***********************************************************************************************/
+    class UAF_EXPORT RegisterNodesResultTarget : public uaf::BaseSessionResultTarget
+    {
+    public:
+
+
+        /**
+         * Create an empty target.
+         */
+        RegisterNodesResultTarget();
+
+
+        /** The status of the register target (good if the node could be registered, bad if
+         *  not). */
+        uaf::Status status;
+
+        /** The NodeId that the server has assigned to the registered node (i.e. its alias, which
+         *  the session will use for all following read and write requests of the node). */
+        uaf::NodeId registeredNodeId;
+
+
+        /**
+         * Get a string representation of the target.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=20) const;
+
+
+        // comparison operators
+        friend bool UAF_EXPORT operator==(
+                const RegisterNodesResultTarget& object1,
+                const RegisterNodesResultTarget& object2);
+        friend bool UAF_EXPORT operator!=(
+                const RegisterNodesResultTarget& object1,
+                const RegisterNodesResultTarget& object2);
+        friend bool UAF_EXPORT operator<(
+                const RegisterNodesResultTarget& object1,
+                const RegisterNodesResultTarget& object2);
+
+
+    };
+
+}
+
+
+#endif /* UAF_REGISTERNODESRESULTTARGET_H_ */
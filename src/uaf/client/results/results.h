@@ -37,6 +37,8 @@
 #include "uaf/client/results/browseresulttarget.h"
 #include "uaf/client/results/browsenextresulttarget.h"
 #include "uaf/client/results/historyreadrawmodifiedresulttarget.h"
+#include "uaf/client/results/registernodesresulttarget.h"
+#include "uaf/client/results/unregisternodesresulttarget.h"
 
 
 
@@ -71,6 +73,8 @@ namespace uaf
     DEFINE_SYNC_SESSIONRESULT(Browse)
     typedef UAF_EXPORT uaf::BrowseResult BrowseNextResult;
     DEFINE_SYNC_SESSIONRESULT(HistoryReadRawModified)
+    DEFINE_SYNC_SESSIONRESULT(RegisterNodes)
+    DEFINE_SYNC_SESSIONRESULT(UnregisterNodes)
 
     // synchronous subscription results
     DEFINE_SYNC_SUBSCRIPTIONRESULT(CreateMonitoredData)
@@ -0,0 +1,336 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_ASYNCRESULTASSEMBLER_H_
+#define UAF_ASYNCRESULTASSEMBLER_H_
+
+
+// STD
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <algorithm>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/status.h"
+#include "uaf/util/handles.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::AsyncResultAssembler collects the partial results of an asynchronous request that
+    * was invoked on several sessions, and stitches them together into a single result.
+    *
+    * Each invocation of such a request has its own transaction id. The assembler knows (per
+    * transaction id) which ranks of the original request are covered by the partial result, so
+    * it can put the received targets back in the order of the original request. Targets that
+    * were not invoked at all (e.g. because they could not be resolved) are not part of the
+    * assembled result, just like in the case of an asynchronous request to a single session.
+    *
+    * Transactions that were not announced to the assembler (via expect()) are passed through
+    * unchanged.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    template <typename _Result>
+    class UAF_EXPORT AsyncResultAssembler
+    {
+    public:
+
+
+        /**
+         * Construct an assembler that logs to a given logger factory and that has a given name.
+         *
+         * @param loggerFactory     Pointer to the logger factory to log all messages to.
+         * @param name              The name of the assembler (only used for logging).
+         */
+        AsyncResultAssembler(uaf::LoggerFactory* loggerFactory, const std::string& name);
+
+
+        /**
+         * Destruct the assembler.
+         */
+        virtual ~AsyncResultAssembler();
+
+
+        /**
+         * Announce the transactions of an asynchronous request that was spread over several
+         * sessions. Must be called before any of the transactions is started!
+         *
+         * @param requestHandle     The handle of the request.
+         * @param transactionIds    The transaction ids of the invocations.
+         * @param ranks             For each transaction id, the ranks of the targets (in the
+         *                          original request) that are handled by the invocation.
+         */
+        void expect(
+                uaf::RequestHandle                              requestHandle,
+                const std::vector<uaf::TransactionId>&          transactionIds,
+                const std::vector< std::vector<std::size_t> >&  ranks);
+
+
+        /**
+         * Cancel the assembly of a request, e.g. because not all invocations could be started.
+         *
+         * The partial results that were already received are discarded (the caller of the
+         * request has been informed of the failure already), and so are the partial results of
+         * the started transactions that are still received afterwards. The transactions that
+         * were not started are forgotten immediately, since their results will never arrive.
+         *
+         * @param requestHandle         The handle of the request.
+         * @param startedTransactionIds The transactions of the request that were started.
+         */
+        void cancel(
+                uaf::RequestHandle                      requestHandle,
+                const std::vector<uaf::TransactionId>&  startedTransactionIds);
+
+
+        /**
+         * Add a partial result.
+         *
+         * @param transactionId     The transaction id of the received partial result.
+         * @param result            In: the partial result as received.
+         *                          Out: the assembled result, if the return value is true.
+         * @return                  True if the result must be delivered now (because it is
+         *                          complete, or because it was not announced), false if more
+         *                          partial results are expected or if it must be discarded.
+         */
+        bool assemble(uaf::TransactionId transactionId, _Result& result);
+
+
+    private:
+
+
+        // no copying or assigning allowed
+        DISALLOW_COPY_AND_ASSIGN(AsyncResultAssembler);
+
+
+        /** The result of a request that is being assembled. */
+        struct Assembly
+        {
+            Assembly() : pendingTransactions(0) {}
+            _Result     result;
+            std::size_t pendingTransactions;
+        };
+
+
+        /** A transaction of a request that is being assembled. */
+        struct Transaction
+        {
+            Transaction() : requestHandle(0) {}
+            uaf::RequestHandle          requestHandle;
+            std::vector<std::size_t>    positions;
+        };
+
+
+        typedef std::map<uaf::RequestHandle, Assembly>     AssemblyMap;
+        typedef std::map<uaf::TransactionId, Transaction>  TransactionMap;
+
+
+        // logger of the assembler
+        uaf::Logger* logger_;
+
+        // the results that are being assembled
+        AssemblyMap assemblyMap_;
+
+        // the transactions that are expected
+        TransactionMap transactionMap_;
+
+        // mutex to safely manipulate both maps
+        UaMutex mutex_;
+    };
+
+
+
+
+    // Constructor
+    // =============================================================================================
+    template <typename _Result>
+    AsyncResultAssembler<_Result>::AsyncResultAssembler(
+            uaf::LoggerFactory* loggerFactory,
+            const std::string&  name)
+    {
+        logger_ = new uaf::Logger(loggerFactory, name);
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    template <typename _Result>
+    AsyncResultAssembler<_Result>::~AsyncResultAssembler()
+    {
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Announce the transactions of a request
+    // =============================================================================================
+    template <typename _Result>
+    void AsyncResultAssembler<_Result>::expect(
+            uaf::RequestHandle                              requestHandle,
+            const std::vector<uaf::TransactionId>&          transactionIds,
+            const std::vector< std::vector<std::size_t> >&  ranks)
+    {
+        // the assembled result contains all invoked ranks, in increasing order
+        std::set<std::size_t> allRanks;
+        for (std::size_t i = 0; i < ranks.size(); i++)
+            allRanks.insert(ranks[i].begin(), ranks[i].end());
+        std::vector<std::size_t> sortedRanks(allRanks.begin(), allRanks.end());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        Assembly& assembly = assemblyMap_[requestHandle];
+        assembly.result.requestHandle = requestHandle;
+        assembly.result.overallStatus = uaf::statuscodes::Good;
+        assembly.result.targets.resize(sortedRanks.size());
+        assembly.pendingTransactions = transactionIds.size();
+
+        for (std::size_t i = 0; i < transactionIds.size() && i < ranks.size(); i++)
+        {
+            Transaction& transaction = transactionMap_[transactionIds[i]];
+            transaction.requestHandle = requestHandle;
+            transaction.positions.resize(ranks[i].size());
+
+            for (std::size_t j = 0; j < ranks[i].size(); j++)
+                transaction.positions[j] = std::lower_bound(sortedRanks.begin(),
+                                                            sortedRanks.end(),
+                                                            ranks[i][j]) - sortedRanks.begin();
+        }
+
+        logger_->debug("Expecting %d partial results for request %d",
+                       transactionIds.size(), requestHandle);
+    }
+
+
+    // Cancel the assembly of a request
+    // =============================================================================================
+    template <typename _Result>
+    void AsyncResultAssembler<_Result>::cancel(
+            uaf::RequestHandle                      requestHandle,
+            const std::vector<uaf::TransactionId>&  startedTransactionIds)
+    {
+        std::set<uaf::TransactionId> started(startedTransactionIds.begin(),
+                                             startedTransactionIds.end());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        typename AssemblyMap::iterator assemblyIter = assemblyMap_.find(requestHandle);
+
+        // discard the partial results that were already received
+        if (assemblyIter != assemblyMap_.end())
+        {
+            logger_->debug("Discarding the partial results of request %d (%d of them were "
+                           "still pending)", requestHandle,
+                           assemblyIter->second.pendingTransactions);
+            assemblyMap_.erase(assemblyIter);
+        }
+
+        // the started transactions are removed when their (discarded) results arrive, the
+        // other ones are removed now
+        std::size_t noOfForgotten = 0;
+        for (typename TransactionMap::iterator it = transactionMap_.begin();
+             it != transactionMap_.end();)
+        {
+            if (it->second.requestHandle == requestHandle && started.count(it->first) == 0)
+            {
+                transactionMap_.erase(it++);
+                noOfForgotten++;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        logger_->debug("The assembly of request %d was cancelled (%d transactions were not "
+                       "started)", requestHandle, noOfForgotten);
+    }
+
+
+    // Add a partial result
+    // =============================================================================================
+    template <typename _Result>
+    bool AsyncResultAssembler<_Result>::assemble(
+            uaf::TransactionId  transactionId,
+            _Result&            result)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        typename TransactionMap::iterator transactionIter = transactionMap_.find(transactionId);
+
+        // results of requests that were invoked on a single session need no assembly
+        if (transactionIter == transactionMap_.end())
+            return true;
+
+        Transaction transaction = transactionIter->second;
+        transactionMap_.erase(transactionIter);
+
+        typename AssemblyMap::iterator assemblyIter = assemblyMap_.find(transaction.requestHandle);
+
+        if (assemblyIter == assemblyMap_.end())
+        {
+            logger_->debug("Discarding the partial result of transaction %d, since the assembly "
+                           "of request %d was cancelled", transactionId, transaction.requestHandle);
+            return false;
+        }
+
+        Assembly& assembly = assemblyIter->second;
+
+        // copy the received targets to their position in the assembled result
+        for (std::size_t i = 0; i < transaction.positions.size(); i++)
+        {
+            std::size_t position = transaction.positions[i];
+
+            if (i < result.targets.size())
+                assembly.result.targets[position] = result.targets[i];
+            else
+                assembly.result.targets[position].status = result.overallStatus;
+        }
+
+        // the first bad partial result determines the overall status
+        if (assembly.result.overallStatus.isGood() && result.overallStatus.isNotGood())
+            assembly.result.overallStatus = result.overallStatus;
+
+        assembly.pendingTransactions--;
+
+        logger_->debug("Received the partial result of transaction %d for request %d "
+                       "(%d more expected)",
+                       transactionId, transaction.requestHandle, assembly.pendingTransactions);
+
+        if (assembly.pendingTransactions > 0)
+            return false;
+
+        result = assembly.result;
+        assemblyMap_.erase(assemblyIter);
+        return true;
+    }
+
+}
+
+
+#endif /* UAF_ASYNCRESULTASSEMBLER_H_ */
@@ -0,0 +1,180 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/sessions/chunkpipeline.h"
+#include "uaf/client/sessions/sessionfactory.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::vector;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    ChunkWindow::ChunkWindow(RequestHandle requestHandle, size_t noOfChunks)
+    : requestHandle_(requestHandle),
+      responses_(noOfChunks),
+      responseReceived_(0)
+    {}
+
+
+    // Wait for the response to any chunk
+    // =============================================================================================
+    bool ChunkWindow::waitForResponse(uint32_t timeoutMs)
+    {
+        return responseReceived_.timedWait(timeoutMs) == OpcUa_Good;
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    ChunkPipeline::ChunkPipeline(LoggerFactory* loggerFactory, SessionFactory* sessionFactory)
+    : sessionFactory_(sessionFactory)
+    {
+        logger_ = new Logger(loggerFactory, "ChunkPipeline");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    ChunkPipeline::~ChunkPipeline()
+    {
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Expect the response of a chunk
+    // =============================================================================================
+    TransactionId ChunkPipeline::expect(ChunkWindow& window, size_t chunk)
+    {
+        TransactionId transactionId = sessionFactory_->storeTransactionId(window.requestHandle());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        Chunk& c = chunkMap_[transactionId];
+        c.window = &window;
+        c.index  = chunk;
+
+        return transactionId;
+    }
+
+
+    // Stop expecting the responses of a window
+    // =============================================================================================
+    void ChunkPipeline::cancel(ChunkWindow& window)
+    {
+        vector<TransactionId> transactionIds;
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            ChunkMap::iterator iter = chunkMap_.begin();
+            while (iter != chunkMap_.end())
+            {
+                if (iter->second.window == &window)
+                {
+                    transactionIds.push_back(iter->first);
+                    chunkMap_.erase(iter++);
+                }
+                else
+                {
+                    ++iter;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < transactionIds.size(); i++)
+            sessionFactory_->removeTransactionId(transactionIds[i]);
+
+        logger_->debug("%d pipelined chunks of request %d were cancelled",
+                       transactionIds.size(), window.requestHandle());
+    }
+
+
+    // Remove a chunk (the mutex must be locked!)
+    // =============================================================================================
+    bool ChunkPipeline::take(TransactionId transactionId, Chunk& chunk)
+    {
+        ChunkMap::iterator iter = chunkMap_.find(transactionId);
+
+        if (iter == chunkMap_.end())
+            return false;
+
+        chunk = iter->second;
+        chunkMap_.erase(iter);
+        return true;
+    }
+
+
+    // Store the response of a Read call
+    // =============================================================================================
+    bool ChunkPipeline::readComplete(
+            TransactionId       transactionId,
+            const UaStatus&     uaStatus,
+            const UaDataValues& values)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        Chunk chunk;
+        if (!take(transactionId, chunk))
+            return false;
+
+        logger_->debug("Received chunk %d of request %d (transaction %d)",
+                       chunk.index, chunk.window->requestHandle(), transactionId);
+
+        ChunkResponse& response = chunk.window->responses_[chunk.index];
+        response.status     = uaStatus;
+        response.dataValues = values;
+        chunk.window->responseReceived_.post(1);
+
+        return true;
+    }
+
+
+    // Store the response of a Write call
+    // =============================================================================================
+    bool ChunkPipeline::writeComplete(
+            TransactionId               transactionId,
+            const UaStatus&             uaStatus,
+            const UaStatusCodeArray&    results)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        Chunk chunk;
+        if (!take(transactionId, chunk))
+            return false;
+
+        logger_->debug("Received chunk %d of request %d (transaction %d)",
+                       chunk.index, chunk.window->requestHandle(), transactionId);
+
+        ChunkResponse& response = chunk.window->responses_[chunk.index];
+        response.status      = uaStatus;
+        response.statusCodes = results;
+        chunk.window->responseReceived_.post(1);
+
+        return true;
+    }
+
+
+}
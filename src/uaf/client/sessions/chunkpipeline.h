@@ -0,0 +1,236 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_CHUNKPIPELINE_H_
+#define UAF_CHUNKPIPELINE_H_
+
+
+// STD
+#include <map>
+#include <vector>
+// SDK
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+#include "uaclient/uaclientsdk.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/handles.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+    // forward declaration
+    class SessionFactory;
+
+
+    /*******************************************************************************************//**
+    * An uaf::ChunkResponse holds the SDK response to one chunk of a pipelined invocation.
+    *
+    * Only the members that belong to the invoked service are filled.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    struct UAF_EXPORT ChunkResponse
+    {
+        /** The overall status of the service call. */
+        UaStatus            status;
+        /** The results of a Read call. */
+        UaDataValues        dataValues;
+        /** The results of a Write call. */
+        UaStatusCodeArray   statusCodes;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * An uaf::ChunkWindow keeps track of the chunks of a single synchronous invocation that are
+    * sent to the server asynchronously, so that several chunks can be in flight at once.
+    *
+    * The window is owned by the invoking thread. The responses are stored in it (by the
+    * uaf::ChunkPipeline) from the thread that receives the asynchronous results.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT ChunkWindow
+    {
+    public:
+
+
+        /**
+         * Create a window for the given number of chunks.
+         *
+         * @param requestHandle The handle of the request that is being invoked.
+         * @param noOfChunks    The number of chunks of the invocation.
+         */
+        ChunkWindow(uaf::RequestHandle requestHandle, std::size_t noOfChunks);
+
+
+        /** Get the handle of the request that is being invoked. */
+        uaf::RequestHandle requestHandle() const { return requestHandle_; }
+
+
+        /** Get the number of chunks of the invocation. */
+        std::size_t noOfChunks() const { return responses_.size(); }
+
+
+        /** Get the response to the chunk with the given index. */
+        const uaf::ChunkResponse& response(std::size_t chunk) const { return responses_[chunk]; }
+
+
+        /**
+         * Wait until the response to (any) chunk has been received.
+         *
+         * @param timeoutMs The maximum time to wait, in milliseconds.
+         * @return          True if a response was received, false if the wait timed out.
+         */
+        bool waitForResponse(uint32_t timeoutMs);
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(ChunkWindow);
+
+        friend class ChunkPipeline;
+
+        // the handle of the request that is being invoked
+        uaf::RequestHandle              requestHandle_;
+        // the responses, one per chunk (preallocated, so they are not moved while in flight)
+        std::vector<uaf::ChunkResponse> responses_;
+        // semaphore that is posted once for every received response
+        UaSemaphore                     responseReceived_;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * An uaf::ChunkPipeline routes the asynchronous results of pipelined chunks (received by the
+    * uaf::SessionFactory) to the uaf::ChunkWindow of the invocation that is waiting for them.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT ChunkPipeline
+    {
+    public:
+
+
+        /**
+         * Construct a chunk pipeline.
+         *
+         * @param loggerFactory     Logger factory to log all messages to.
+         * @param sessionFactory    The session factory that receives the asynchronous results,
+         *                          and that hands out the transaction ids.
+         */
+        ChunkPipeline(uaf::LoggerFactory* loggerFactory, uaf::SessionFactory* sessionFactory);
+
+
+        /**
+         * Destruct the chunk pipeline.
+         */
+        virtual ~ChunkPipeline();
+
+
+        /**
+         * Get a new transaction id for the chunk with the given index, so that its response will
+         * be stored in the given window. Must be called before the chunk is sent!
+         *
+         * @param window    The window of the invocation.
+         * @param chunk     The index of the chunk.
+         * @return          The transaction id that must be used to send the chunk.
+         */
+        uaf::TransactionId expect(uaf::ChunkWindow& window, std::size_t chunk);
+
+
+        /**
+         * Stop expecting the responses of all chunks of the given window (e.g. because a chunk
+         * could not be sent). Responses that are still received afterwards are discarded.
+         *
+         * @param window    The window of the invocation.
+         */
+        void cancel(uaf::ChunkWindow& window);
+
+
+        /**
+         * Store the response of a pipelined Read call.
+         *
+         * @return  True if the transaction belonged to a pipelined chunk, false if not.
+         */
+        bool readComplete(
+                uaf::TransactionId          transactionId,
+                const UaStatus&             uaStatus,
+                const UaDataValues&         values);
+
+
+        /**
+         * Store the response of a pipelined Write call.
+         *
+         * @return  True if the transaction belonged to a pipelined chunk, false if not.
+         */
+        bool writeComplete(
+                uaf::TransactionId          transactionId,
+                const UaStatus&             uaStatus,
+                const UaStatusCodeArray&    results);
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(ChunkPipeline);
+
+
+        /** A chunk that is in flight. */
+        struct Chunk
+        {
+            Chunk() : window(0), index(0) {}
+            uaf::ChunkWindow*   window;
+            std::size_t         index;
+        };
+
+        typedef std::map<uaf::TransactionId, Chunk> ChunkMap;
+
+
+        /**
+         * Remove the chunk with the given transaction id (the mutex_ must be locked!).
+         *
+         * @param transactionId The transaction id of the received response.
+         * @param chunk         Output parameter: the chunk, if it was found.
+         * @return              True if the chunk was found, false if the transaction is unknown.
+         */
+        bool take(uaf::TransactionId transactionId, Chunk& chunk);
+
+
+        // logger of the pipeline
+        uaf::Logger*            logger_;
+        // the session factory that hands out the transaction ids
+        uaf::SessionFactory*    sessionFactory_;
+        // the chunks that are in flight
+        ChunkMap                chunkMap_;
+        // mutex to safely manipulate the chunkMap_ and the responses of the windows
+        UaMutex                 mutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_CHUNKPIPELINE_H_ */
@@ -0,0 +1,215 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/sessions/invocationpool.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::size_t;
+    using std::vector;
+
+
+    // Constructor
+    // =============================================================================================
+    InvocationPool::Batch::Batch(const vector<InvocationJob*>& jobs)
+    : jobs(jobs),
+      next(0),
+      helpersDone(0)
+    {}
+
+
+    // Get the next job of the batch
+    // =============================================================================================
+    InvocationJob* InvocationPool::Batch::nextJob()
+    {
+        UaMutexLocker locker(&mutex);
+        if (next < jobs.size())
+            return jobs[next++];
+        else
+            return NULL;
+    }
+
+
+    // Execute jobs of the batch until none are left
+    // =============================================================================================
+    void InvocationPool::Batch::executeJobs()
+    {
+        InvocationJob* job;
+        while ((job = nextJob()) != NULL)
+            job->execute();
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    InvocationPool::Worker::Worker(InvocationPool* pool)
+    : pool_(pool)
+    {}
+
+
+    // Thread function of a worker
+    // =============================================================================================
+    void InvocationPool::Worker::run()
+    {
+        Batch* batch;
+        while (pool_->waitForBatch(batch))
+        {
+            if (batch != NULL)
+            {
+                batch->executeJobs();
+                batch->helpersDone.post(1);
+            }
+        }
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    InvocationPool::InvocationPool(LoggerFactory* loggerFactory)
+    : stopping_(false),
+      pendingBatchesSemaphore_(0)
+    {
+        logger_ = new Logger(loggerFactory, "InvocationPool");
+        logger_->debug("The InvocationPool has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    InvocationPool::~InvocationPool()
+    {
+        logger_->debug("Destructing the InvocationPool");
+
+        UaMutexLocker workersLocker(&workersMutex_);
+
+        pendingBatchesMutex_.lock();
+        stopping_ = true;
+        pendingBatchesMutex_.unlock();
+
+        if (workers_.size() > 0)
+            pendingBatchesSemaphore_.post(workers_.size());
+
+        for (vector<Worker*>::iterator it = workers_.begin(); it != workers_.end(); ++it)
+        {
+            (*it)->wait();
+            delete *it;
+        }
+
+        logger_->debug("All %d worker threads have been stopped", workers_.size());
+        workers_.clear();
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Make sure enough workers are running
+    // =============================================================================================
+    void InvocationPool::ensureWorkers(size_t count)
+    {
+        UaMutexLocker locker(&workersMutex_);
+
+        while (workers_.size() < count)
+        {
+            Worker* worker = new Worker(this);
+            workers_.push_back(worker);
+            worker->start();
+            logger_->debug("Worker thread %d has been started", workers_.size());
+        }
+    }
+
+
+    // Wait for a batch that needs help
+    // =============================================================================================
+    bool InvocationPool::waitForBatch(Batch*& batch)
+    {
+        pendingBatchesSemaphore_.wait();
+
+        UaMutexLocker locker(&pendingBatchesMutex_);
+
+        if (stopping_)
+            return false;
+
+        // the batch may have been withdrawn already by its caller
+        if (pendingBatches_.empty())
+        {
+            batch = NULL;
+        }
+        else
+        {
+            batch = pendingBatches_.front();
+            pendingBatches_.pop_front();
+        }
+
+        return true;
+    }
+
+
+    // Execute a batch of jobs
+    // =============================================================================================
+    void InvocationPool::executeAll(const vector<InvocationJob*>& jobs, uint32_t maxParallelJobs)
+    {
+        Batch batch(jobs);
+
+        // the number of workers that may help the calling thread
+        size_t helpers = 0;
+        if (maxParallelJobs > 1 && jobs.size() > 1)
+            helpers = std::min(size_t(maxParallelJobs - 1), jobs.size() - 1);
+
+        if (helpers > 0)
+        {
+            logger_->debug("Executing %d jobs with the help of %d workers", jobs.size(), helpers);
+
+            ensureWorkers(helpers);
+
+            pendingBatchesMutex_.lock();
+            for (size_t i = 0; i < helpers; i++)
+                pendingBatches_.push_back(&batch);
+            pendingBatchesMutex_.unlock();
+
+            pendingBatchesSemaphore_.post(helpers);
+        }
+
+        // the calling thread works on its own batch too
+        batch.executeJobs();
+
+        // withdraw the requests for help that were not picked up by a worker yet
+        size_t unclaimed = 0;
+        pendingBatchesMutex_.lock();
+        for (std::deque<Batch*>::iterator it = pendingBatches_.begin(); it != pendingBatches_.end();)
+        {
+            if (*it == &batch)
+            {
+                it = pendingBatches_.erase(it);
+                unclaimed++;
+            }
+            else
+                ++it;
+        }
+        pendingBatchesMutex_.unlock();
+
+        // the batch lives on the stack, so wait until every helper has finished with it
+        for (size_t i = unclaimed; i < helpers; i++)
+            batch.helpersDone.wait();
+    }
+
+
+}
@@ -0,0 +1,184 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_INVOCATIONPOOL_H_
+#define UAF_INVOCATIONPOOL_H_
+
+// STD
+#include <vector>
+#include <deque>
+#include <algorithm>
+// SDK
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/logger.h"
+#include "uaf/client/clientexport.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::InvocationJob is a piece of work (typically: one invocation on one session) that can
+    * be executed by an uaf::InvocationPool.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT InvocationJob
+    {
+    public:
+
+        /**
+         * Destruct the job.
+         */
+        virtual ~InvocationJob() {}
+
+
+        /**
+         * Execute the job. This method may be called from any thread of the pool.
+         */
+        virtual void execute() = 0;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * An uaf::InvocationPool executes a batch of uaf::InvocationJob instances concurrently,
+    * on a bounded number of worker threads.
+    *
+    * The thread that calls executeAll() also executes jobs of its own batch, so a batch always
+    * makes progress, even if all worker threads are busy with the batches of other callers.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT InvocationPool
+    {
+    public:
+
+
+        /**
+         * Construct an invocation pool. No worker threads are started until they are needed.
+         *
+         * @param loggerFactory Logger factory to log all messages to.
+         */
+        InvocationPool(uaf::LoggerFactory* loggerFactory);
+
+
+        /**
+         * Destruct the pool, after stopping all worker threads.
+         */
+        virtual ~InvocationPool();
+
+
+        /**
+         * Execute all given jobs and return when they have all been executed.
+         *
+         * @param jobs              The jobs to execute.
+         * @param maxParallelJobs   The maximum number of jobs of this batch that may be executed
+         *                          at the same time (including the calling thread). A value of 0
+         *                          or 1 means that all jobs are executed serially by the calling
+         *                          thread.
+         */
+        void executeAll(const std::vector<uaf::InvocationJob*>& jobs, uint32_t maxParallelJobs);
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(InvocationPool);
+
+
+        /**
+         * A batch of jobs, shared by the caller of executeAll() and the workers that help it.
+         */
+        struct Batch
+        {
+            Batch(const std::vector<uaf::InvocationJob*>& jobs);
+
+            /** Get the next job to execute, or NULL if all jobs have been taken already. */
+            uaf::InvocationJob* nextJob();
+
+            /** Execute jobs until none are left. */
+            void executeJobs();
+
+            const std::vector<uaf::InvocationJob*>& jobs;
+            std::size_t                             next;
+            UaMutex                                 mutex;
+            UaSemaphore                             helpersDone;
+        };
+
+
+        /**
+         * A worker thread of the pool.
+         */
+        class Worker : public UaThread
+        {
+        public:
+            Worker(uaf::InvocationPool* pool);
+            void run();
+        private:
+            uaf::InvocationPool* pool_;
+        };
+        friend class Worker;
+
+
+        /**
+         * Make sure at least the given number of worker threads are running.
+         */
+        void ensureWorkers(std::size_t count);
+
+
+        /**
+         * Called by the worker threads: wait for a batch to help.
+         *
+         * @param batch Output parameter: the batch to help, or NULL if the batch was withdrawn
+         *              already by its caller.
+         * @return      False if the pool is stopping and the worker must exit.
+         */
+        bool waitForBatch(Batch*& batch);
+
+
+        // logger of the pool
+        uaf::Logger* logger_;
+
+        // the worker threads
+        std::vector<Worker*> workers_;
+        // mutex to safely manipulate the workers_
+        UaMutex workersMutex_;
+
+        // the batches for which help was requested (a batch may appear more than once)
+        std::deque<Batch*> pendingBatches_;
+        // true if the worker threads must stop
+        bool stopping_;
+        // mutex to safely manipulate the pendingBatches_ and stopping_
+        UaMutex pendingBatchesMutex_;
+        // semaphore that is posted once for every pending batch, and once per worker when stopping
+        UaSemaphore pendingBatchesSemaphore_;
+    };
+
+
+}
+
+
+#endif /* UAF_INVOCATIONPOOL_H_ */
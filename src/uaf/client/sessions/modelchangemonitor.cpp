@@ -0,0 +1,463 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/sessions/modelchangemonitor.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::size_t;
+
+
+    // the fields that are selected by the event filter
+    enum SelectedField
+    {
+        EventTypeField          = 0,
+        ModelChangesField       = 1,
+        SemanticChangesField    = 2,
+        NumberOfSelectedFields  = 3
+    };
+
+
+    // Create a content filter element that checks the type of an event
+    // =============================================================================================
+    static UaContentFilterElement* newOfTypeElement(OpcUa_UInt32 eventTypeId)
+    {
+        UaVariant typeId;
+        typeId.setNodeId(UaNodeId(eventTypeId));
+
+        UaLiteralOperand* operand = new UaLiteralOperand;
+        operand->setLiteralValue(typeId);
+
+        UaContentFilterElement* element = new UaContentFilterElement;
+        element->setFilterOperator(OpcUa_FilterOperator_OfType);
+        element->setFilterOperand(0, operand, 1); // the element takes ownership
+        return element;
+    }
+
+
+    // Create a content filter element that combines two other elements
+    // =============================================================================================
+    static UaContentFilterElement* newOrElement(OpcUa_UInt32 index1, OpcUa_UInt32 index2)
+    {
+        UaElementOperand* operand1 = new UaElementOperand;
+        operand1->setIndex(index1);
+        UaElementOperand* operand2 = new UaElementOperand;
+        operand2->setIndex(index2);
+
+        UaContentFilterElement* element = new UaContentFilterElement;
+        element->setFilterOperator(OpcUa_FilterOperator_Or);
+        element->setFilterOperand(0, operand1, 2); // the element takes ownership
+        element->setFilterOperand(1, operand2, 2);
+        return element;
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    ModelChangeMonitor::ModelChangeMonitor(
+            LoggerFactory*          loggerFactory,
+            ClientConnectionId      clientConnectionId,
+            UaClientSdk::UaSession* uaSession,
+            Database*               database)
+    : uaSession_(uaSession),
+      uaSubscription_(0),
+      database_(database),
+      started_(false)
+    {
+        stringstream loggerName;
+        loggerName << "ModelChangeMonitor-" << clientConnectionId;
+        logger_ = new Logger(loggerFactory, loggerName.str());
+
+        clientSubscriptionHandle_ = database_->createUniqueClientSubscriptionHandle();
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    ModelChangeMonitor::~ModelChangeMonitor()
+    {
+        stop();
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Check if the model changes are being monitored
+    // =============================================================================================
+    bool ModelChangeMonitor::isStarted() const
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return started_;
+    }
+
+
+    // Update the namespace array
+    // =============================================================================================
+    void ModelChangeMonitor::setNamespaceArray(const NamespaceArray& namespaceArray)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        namespaceArray_ = namespaceArray;
+    }
+
+
+    // Start monitoring the model changes
+    // =============================================================================================
+    Status ModelChangeMonitor::start(const string& serverUri, const NamespaceArray& namespaceArray)
+    {
+        UaMutexLocker subscriptionLocker(&subscriptionMutex_); // unlocks when out of scope
+
+        if (isStarted())
+            return statuscodes::Good;
+
+        // a subscription that was lost must be deleted first, and since we may have missed some
+        // model changes in the meantime, we can't trust the cached addresses anymore
+        if (uaSubscription_ != 0)
+        {
+            logger_->debug("The previous subscription was lost, so it will be created again");
+            deleteSubscription();
+            database_->addressCache.clear(serverUri);
+        }
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            serverUri_      = serverUri;
+            namespaceArray_ = namespaceArray;
+        }
+
+        logger_->debug("Creating a subscription to monitor the model changes of %s",
+                       serverUri.c_str());
+
+        Status ret;
+
+        UaClientSdk::ServiceSettings serviceSettings;
+        UaClientSdk::SubscriptionSettings subscriptionSettings;
+        subscriptionSettings.publishingInterval = 1000.0;
+
+        SdkStatus sdkStatus = uaSession_->createSubscription(
+                serviceSettings,
+                this,
+                clientSubscriptionHandle_,
+                subscriptionSettings,
+                OpcUa_True,
+                &uaSubscription_);
+
+        if (sdkStatus.isGood())
+            ret = createMonitoredItem();
+        else
+            ret = CreateSubscriptionError(sdkStatus);
+
+        if (ret.isGood())
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            started_ = true;
+            logger_->debug("The model changes are now being monitored");
+        }
+        else
+        {
+            logger_->error(ret);
+            deleteSubscription();
+        }
+
+        return ret;
+    }
+
+
+    // Create the monitored item of the Server object
+    // =============================================================================================
+    Status ModelChangeMonitor::createMonitoredItem()
+    {
+        Status ret;
+
+        // select the type of the event, and the changes of both kinds of model change events
+        UaEventFilter eventFilter;
+
+        UaSimpleAttributeOperand eventType;
+        eventType.setAttributeId(OpcUa_Attributes_Value);
+        eventType.setTypeId(UaNodeId(OpcUaId_BaseEventType));
+        eventType.setBrowsePathElement(0, UaQualifiedName("EventType", 0), 1);
+        eventFilter.setSelectClauseElement(EventTypeField, eventType, NumberOfSelectedFields);
+
+        UaSimpleAttributeOperand modelChanges;
+        modelChanges.setAttributeId(OpcUa_Attributes_Value);
+        modelChanges.setTypeId(UaNodeId(OpcUaId_GeneralModelChangeEventType));
+        modelChanges.setBrowsePathElement(0, UaQualifiedName("Changes", 0), 1);
+        eventFilter.setSelectClauseElement(ModelChangesField, modelChanges, NumberOfSelectedFields);
+
+        UaSimpleAttributeOperand semanticChanges;
+        semanticChanges.setAttributeId(OpcUa_Attributes_Value);
+        semanticChanges.setTypeId(UaNodeId(OpcUaId_SemanticChangeEventType));
+        semanticChanges.setBrowsePathElement(0, UaQualifiedName("Changes", 0), 1);
+        eventFilter.setSelectClauseElement(
+                SemanticChangesField, semanticChanges, NumberOfSelectedFields);
+
+        // only the model change events are needed (plus the overflow events, because then we
+        // know that we've missed some), so the other events of the Server object are filtered
+        // out by the server:
+        //   [0] = [1] OR [2]
+        //   [1] = OfType(BaseModelChangeEventType)
+        //   [2] = [3] OR [4]
+        //   [3] = OfType(SemanticChangeEventType)
+        //   [4] = OfType(EventQueueOverflowEventType)
+        UaContentFilter* whereClause = new UaContentFilter;
+        whereClause->setContentFilterElement(0, newOrElement(1, 2), 5);
+        whereClause->setContentFilterElement(
+                1, newOfTypeElement(OpcUaId_BaseModelChangeEventType), 5);
+        whereClause->setContentFilterElement(2, newOrElement(3, 4), 5);
+        whereClause->setContentFilterElement(
+                3, newOfTypeElement(OpcUaId_SemanticChangeEventType), 5);
+        whereClause->setContentFilterElement(
+                4, newOfTypeElement(OpcUaId_EventQueueOverflowEventType), 5);
+        eventFilter.setWhereClause(whereClause); // the filter takes ownership
+
+        // monitor the events of the Server object
+        UaMonitoredItemCreateRequests   uaCreateRequests;
+        UaMonitoredItemCreateResults    uaCreateResults;
+        UaClientSdk::ServiceSettings    serviceSettings;
+
+        uaCreateRequests.create(1);
+        UaNodeId(OpcUaId_Server).copyTo(&uaCreateRequests[0].ItemToMonitor.NodeId);
+        uaCreateRequests[0].ItemToMonitor.AttributeId            = OpcUa_Attributes_EventNotifier;
+        uaCreateRequests[0].MonitoringMode                       = OpcUa_MonitoringMode_Reporting;
+        uaCreateRequests[0].RequestedParameters.ClientHandle     = 0;
+        uaCreateRequests[0].RequestedParameters.SamplingInterval = 0;
+        uaCreateRequests[0].RequestedParameters.QueueSize        = 1000;
+        uaCreateRequests[0].RequestedParameters.DiscardOldest    = OpcUa_True;
+        eventFilter.detachFilter(uaCreateRequests[0].RequestedParameters.Filter);
+
+        SdkStatus sdkStatus = uaSubscription_->createMonitoredItems(
+                serviceSettings,
+                OpcUa_TimestampsToReturn_Neither,
+                uaCreateRequests,
+                uaCreateResults);
+
+        if (sdkStatus.isBad())
+            ret = CreateMonitoredItemsInvocationError(sdkStatus);
+        else if (uaCreateResults.length() != 1)
+            ret = UnexpectedError("Unexpected number of results when monitoring model changes");
+        else if (OpcUa_IsBad(uaCreateResults[0].StatusCode))
+            ret = ServerCouldNotCreateMonitoredItemsError(SdkStatus(uaCreateResults[0].StatusCode));
+        else
+            ret = statuscodes::Good;
+
+        return ret;
+    }
+
+
+    // Stop monitoring the model changes
+    // =============================================================================================
+    Status ModelChangeMonitor::stop()
+    {
+        UaMutexLocker subscriptionLocker(&subscriptionMutex_); // unlocks when out of scope
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            started_ = false;
+        }
+
+        return deleteSubscription();
+    }
+
+
+    // Delete the SDK subscription
+    // =============================================================================================
+    Status ModelChangeMonitor::deleteSubscription()
+    {
+        Status ret = statuscodes::Good;
+
+        if (uaSubscription_ != 0)
+        {
+            // if the session is not connected, the subscription object is left to the SDK
+            // session (which deletes it when the session is deleted)
+            if (uaSession_->isConnected())
+            {
+                logger_->debug("Deleting the subscription that monitors the model changes");
+
+                UaClientSdk::ServiceSettings serviceSettings;
+                SdkStatus sdkStatus = uaSession_->deleteSubscription(serviceSettings,
+                                                                     &uaSubscription_);
+                if (sdkStatus.isBad())
+                {
+                    ret = DeleteSubscriptionError(sdkStatus);
+                    logger_->error(ret);
+                }
+            }
+
+            uaSubscription_ = 0;
+        }
+
+        return ret;
+    }
+
+
+    // Get the nodes that are affected by an event
+    // =============================================================================================
+    bool ModelChangeMonitor::affectedNodes(
+            const OpcUa_EventFieldList& eventFieldList,
+            vector<NodeId>&             nodeIds)
+    {
+        if (eventFieldList.NoOfEventFields < NumberOfSelectedFields)
+            return false;
+
+        UaNodeId eventType;
+        UaVariant(eventFieldList.EventFields[EventTypeField]).toNodeId(eventType);
+
+        // the server has discarded some events, so we don't know what has changed
+        if (eventType == UaNodeId(OpcUaId_EventQueueOverflowEventType))
+            return false;
+
+        UaExtensionObjectArray uaChanges;
+
+        // the changes of a GeneralModelChangeEvent
+        UaVariant modelChanges(eventFieldList.EventFields[ModelChangesField]);
+        if (!modelChanges.isEmpty() && OpcUa_IsGood(modelChanges.toExtensionObjectArray(uaChanges)))
+        {
+            for (OpcUa_UInt32 i = 0; i < uaChanges.length(); i++)
+            {
+                ExtensionObject extensionObject;
+                extensionObject.fromSdk(uaChanges[i]);
+                nodeIds.push_back(ModelChangeStructureDataType(extensionObject).affected);
+            }
+        }
+
+        // the changes of a SemanticChangeEvent
+        UaVariant semanticChanges(eventFieldList.EventFields[SemanticChangesField]);
+        if (!semanticChanges.isEmpty()
+            && OpcUa_IsGood(semanticChanges.toExtensionObjectArray(uaChanges)))
+        {
+            for (OpcUa_UInt32 i = 0; i < uaChanges.length(); i++)
+            {
+                UaExtensionObject uaExtensionObject(uaChanges[i]);
+                UaSemanticChangeStructureDataType uaChange(uaExtensionObject);
+
+                NodeId affected;
+                affected.fromSdk(uaChange.getAffected());
+                nodeIds.push_back(affected);
+            }
+        }
+
+        // a BaseModelChangeEvent (or a GeneralModelChangeEvent without changes) only tells us
+        // that *something* has changed
+        return !nodeIds.empty();
+    }
+
+
+    // implemented from the callback interface
+    // =============================================================================================
+    void ModelChangeMonitor::newEvents(
+            OpcUa_UInt32        clientSubscriptionHandle,
+            UaEventFieldLists&  eventFieldList)
+    {
+        string serverUri;
+        NamespaceArray namespaceArray;
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            serverUri      = serverUri_;
+            namespaceArray = namespaceArray_;
+        }
+
+        logger_->debug("Received %d model change events from %s",
+                       eventFieldList.length(), serverUri.c_str());
+
+        vector<NodeId> nodeIds;
+        bool changesKnown = true;
+
+        for (OpcUa_UInt32 i = 0; i < eventFieldList.length() && changesKnown; i++)
+            changesKnown = affectedNodes(eventFieldList[i], nodeIds);
+
+        if (!changesKnown)
+        {
+            logger_->debug("The changes are unknown, so all cached addresses are cleared");
+            database_->addressCache.clear(serverUri);
+            return;
+        }
+
+        // the namespace URIs are needed to compare the nodes with the cached addresses
+        for (vector<NodeId>::iterator it = nodeIds.begin(); it != nodeIds.end(); ++it)
+        {
+            string nameSpaceUri;
+            if (namespaceArray.findNamespaceUri(it->nameSpaceIndex(), nameSpaceUri))
+                it->setNameSpaceUri(nameSpaceUri);
+        }
+
+        database_->addressCache.invalidate(serverUri, nodeIds);
+    }
+
+
+    // implemented from the callback interface
+    // =============================================================================================
+    void ModelChangeMonitor::subscriptionStatusChanged(
+            OpcUa_UInt32    clientSubscriptionHandle,
+            const UaStatus& uaStatus)
+    {
+        if (uaStatus.isBad())
+        {
+            logger_->warning("The subscription that monitors the model changes was lost: %s",
+                             uaStatus.toString().toUtf8());
+
+            // the house keeping will create the subscription again
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            started_ = false;
+        }
+    }
+
+
+    // implemented from the callback interface
+    // =============================================================================================
+    void ModelChangeMonitor::keepAlive(OpcUa_UInt32 clientSubscriptionHandle)
+    {}
+
+
+    // implemented from the callback interface
+    // =============================================================================================
+    void ModelChangeMonitor::notificationsMissing(
+            OpcUa_UInt32 clientSubscriptionHandle,
+            OpcUa_UInt32 previousSequenceNumber,
+            OpcUa_UInt32 newSequenceNumber)
+    {
+        string serverUri;
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+            serverUri = serverUri_;
+        }
+
+        logger_->warning("Model change notifications %d to %d are missing, so all cached "
+                         "addresses of %s are cleared",
+                         previousSequenceNumber + 1, newSequenceNumber - 1, serverUri.c_str());
+
+        database_->addressCache.clear(serverUri);
+    }
+
+
+    // implemented from the callback interface
+    // =============================================================================================
+    void ModelChangeMonitor::dataChange(
+            OpcUa_UInt32                clientSubscriptionHandle,
+            const UaDataNotifications&  dataNotifications,
+            const UaDiagnosticInfos&    diagnosticInfos)
+    {}
+
+
+}
@@ -0,0 +1,232 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_MODELCHANGEMONITOR_H_
+#define UAF_MODELCHANGEMONITOR_H_
+
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+// SDK
+#include "uaclient/uaclientsdk.h"
+#include "uaclient/uasession.h"
+#include "uaclient/uasubscription.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemanticchangestructuredatatype.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/status.h"
+#include "uaf/util/sdkstatus.h"
+#include "uaf/util/logger.h"
+#include "uaf/util/handles.h"
+#include "uaf/util/nodeid.h"
+#include "uaf/util/namespacearray.h"
+#include "uaf/util/extensionobject.h"
+#include "uaf/util/modelchangestructuredatatype.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/database/database.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::ModelChangeMonitor keeps the address cache of a single session correct while the
+    * address space of the server changes.
+    *
+    * It creates a subscription with a single monitored item, which receives the
+    * GeneralModelChangeEvents and SemanticChangeEvents of the Server object. For every change,
+    * the cached addresses of the affected nodes are invalidated. If the changes are unknown (e.g.
+    * because the server sends BaseModelChangeEvents without any details, or because events were
+    * lost) all cached addresses of the server are cleared instead.
+    *
+    * The subscription is not created by the SDK callbacks (which must not block), but by the
+    * house keeping of the uaf::SessionFactory.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT ModelChangeMonitor : private UaClientSdk::UaSubscriptionCallback
+    {
+    public:
+
+
+        /**
+         * Construct a monitor, without creating the subscription yet.
+         *
+         * @param loggerFactory         Logger factory to log all messages to.
+         * @param clientConnectionId    The id of the session that hosts the monitor.
+         * @param uaSession             SDK Session object that hosts the subscription.
+         * @param database              Pointer to the client database.
+         */
+        ModelChangeMonitor(
+                uaf::LoggerFactory*         loggerFactory,
+                uaf::ClientConnectionId     clientConnectionId,
+                UaClientSdk::UaSession*     uaSession,
+                uaf::Database*              database);
+
+
+        /**
+         * Destruct the monitor.
+         */
+        virtual ~ModelChangeMonitor();
+
+
+        /**
+         * Create the subscription and its monitored item, unless they exist already.
+         *
+         * If a previous subscription was lost, it is deleted first, and all cached addresses of
+         * the server are cleared (since changes may have been missed in the meantime).
+         *
+         * @param serverUri         The server URI of the session.
+         * @param namespaceArray    The namespace array of the server.
+         * @return                  Good if the model changes are being monitored.
+         */
+        uaf::Status start(const std::string& serverUri, const uaf::NamespaceArray& namespaceArray);
+
+
+        /**
+         * Delete the subscription (if it exists).
+         *
+         * @return  Good if the subscription was deleted (or didn't exist).
+         */
+        uaf::Status stop();
+
+
+        /**
+         * Check if the model changes are being monitored.
+         *
+         * @return  True if the subscription and its monitored item have been created, and the
+         *          subscription has not been lost since.
+         */
+        bool isStarted() const;
+
+
+        /**
+         * Update the namespace array that is used to interpret the received node ids (e.g.
+         * because the session has reconnected).
+         *
+         * @param namespaceArray    The namespace array of the server.
+         */
+        void setNamespaceArray(const uaf::NamespaceArray& namespaceArray);
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(ModelChangeMonitor);
+
+
+        /**
+         * Delete the SDK subscription (the subscriptionMutex_ must be locked!).
+         */
+        uaf::Status deleteSubscription();
+
+
+        /**
+         * Create the monitored item of the Server object (the subscriptionMutex_ must be locked!).
+         */
+        uaf::Status createMonitoredItem();
+
+
+        /**
+         * Get the nodes that are affected by an event (or none if the changes are unknown).
+         *
+         * @param eventFieldList    The fields of the event, as selected by the event filter.
+         * @param nodeIds           Output parameter: the affected nodes (without namespace URI).
+         * @return                  True if the affected nodes are known, false if not.
+         */
+        static bool affectedNodes(
+                const OpcUa_EventFieldList& eventFieldList,
+                std::vector<uaf::NodeId>&   nodeIds);
+
+
+        /**
+         * Called every time the subscription status has changed,
+         * overridden from UaSubscriptionCallback.
+         */
+        virtual void subscriptionStatusChanged(
+                OpcUa_UInt32    clientSubscriptionHandle,
+                const UaStatus& status);
+
+
+        /**
+         * Called every time a keep alive message is received,
+         * overridden from UaSubscriptionCallback.
+         */
+        virtual void keepAlive(OpcUa_UInt32 clientSubscriptionHandle);
+
+
+        /**
+         * Called every time notifications are missing,
+         * overridden from UaSubscriptionCallback.
+         */
+        virtual void notificationsMissing(
+                OpcUa_UInt32 clientSubscriptionHandle,
+                OpcUa_UInt32 previousSequenceNumber,
+                OpcUa_UInt32 newSequenceNumber);
+
+
+        /**
+         * Called every time a monitored item has changed (never, since only events are
+         * monitored), overridden from UaSubscriptionCallback.
+         */
+        virtual void dataChange(
+                OpcUa_UInt32 clientSubscriptionHandle,
+                const UaDataNotifications &dataNotifications,
+                const UaDiagnosticInfos &diagnosticInfos);
+
+
+        /**
+         * Called every time new events have been received,
+         * overridden from UaSubscriptionCallback.
+         */
+        virtual void newEvents(
+                OpcUa_UInt32        clientSubscriptionHandle,
+                UaEventFieldLists&  eventFieldList);
+
+
+        // the logger of the monitor
+        uaf::Logger*                    logger_;
+        // the SDK session hosting the subscription
+        UaClientSdk::UaSession*         uaSession_;
+        // the SDK subscription (0 if it doesn't exist), and the mutex to create or delete it
+        UaClientSdk::UaSubscription*    uaSubscription_;
+        UaMutex                         subscriptionMutex_;
+        // the client handle of the subscription
+        uaf::ClientSubscriptionHandle   clientSubscriptionHandle_;
+        // the shared client database
+        uaf::Database*                  database_;
+
+        // the server URI and namespace array of the session, and whether the monitor has been
+        // started (and not lost since), protected by the mutex
+        std::string                     serverUri_;
+        uaf::NamespaceArray             namespaceArray_;
+        bool                            started_;
+        mutable UaMutex                 mutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_MODELCHANGEMONITOR_H_ */
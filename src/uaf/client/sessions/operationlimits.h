@@ -0,0 +1,92 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_OPERATIONLIMITS_H_
+#define UAF_OPERATIONLIMITS_H_
+
+// STD
+#include <string>
+#include <sstream>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+namespace uaf
+{
+
+    /*******************************************************************************************//**
+    * An OperationLimits object contains the limits that a server imposes on the number of
+    * operations (i.e. targets) per service call, as exposed by the
+    * Server.ServerCapabilities.OperationLimits object of the server.
+    *
+    * A limit of 0 means that the server doesn't impose a limit (or that the limit is unknown).
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT OperationLimits
+    {
+    public:
+
+
+        /**
+         * Create an OperationLimits object without any limits.
+         */
+        OperationLimits();
+
+
+        /** The maximum number of nodes per Read service call. */
+        uint32_t maxNodesPerRead;
+
+        /** The maximum number of nodes per Write service call. */
+        uint32_t maxNodesPerWrite;
+
+        /** The maximum number of nodes per Browse (or BrowseNext) service call. */
+        uint32_t maxNodesPerBrowse;
+
+        /** The maximum number of methods per Call service call. */
+        uint32_t maxNodesPerMethodCall;
+
+        /** The maximum number of browse paths per TranslateBrowsePathsToNodeIds service call. */
+        uint32_t maxNodesPerTranslateBrowsePathsToNodeIds;
+
+        /** The maximum number of monitored items per CreateMonitoredItems service call. */
+        uint32_t maxMonitoredItemsPerCall;
+
+        /** The maximum number of nodes per RegisterNodes (or UnregisterNodes) service call. */
+        uint32_t maxNodesPerRegisterNodes;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=42) const;
+
+    };
+
+
+}
+
+
+
+#endif /* UAF_OPERATIONLIMITS_H_ */
@@ -0,0 +1,390 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/sessions/pkistore.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+
+
+    // Constructor
+    // =============================================================================================
+    PkiStore::PkiStore(LoggerFactory* loggerFactory, Database* database)
+    : database_(database),
+      pkiProviderInitialized_(false),
+      clientCertificateLoaded_(false)
+    {
+        logger_ = new Logger(loggerFactory, "PkiStore");
+        logger_->debug("The PkiStore has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    PkiStore::~PkiStore()
+    {
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Append the modification time and the size of a file or directory to a stamp
+    // =============================================================================================
+    static void appendFileStamp(stringstream& ss, const string& path)
+    {
+        // the size and the sub-second part of the time are included as well, otherwise two
+        // changes within the same second would go unnoticed
+        struct stat info;
+        if (::stat(path.c_str(), &info) == 0)
+        {
+            ss << info.st_mtime;
+#if defined(__APPLE__)
+            ss << "." << info.st_mtimespec.tv_nsec;
+#elif !defined(_WIN32)
+            ss << "." << info.st_mtim.tv_nsec;
+#endif
+            ss << "#" << info.st_size;
+        }
+        else
+        {
+            ss << "?";
+        }
+    }
+
+
+    // Get the sorted names of the entries of a directory (none if the path is no directory)
+    // =============================================================================================
+    static std::vector<string> directoryEntries(const string& path)
+    {
+        std::vector<string> entries;
+
+#ifdef _WIN32
+        WIN32_FIND_DATAA data;
+        HANDLE handle = ::FindFirstFileA((path + "\\*").c_str(), &data);
+        if (handle != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                entries.push_back(data.cFileName);
+            }
+            while (::FindNextFileA(handle, &data));
+            ::FindClose(handle);
+        }
+#else
+        DIR* dir = ::opendir(path.c_str());
+        if (dir != NULL)
+        {
+            struct dirent* entry;
+            while ((entry = ::readdir(dir)) != NULL)
+                entries.push_back(entry->d_name);
+            ::closedir(dir);
+        }
+#endif
+
+        entries.erase(std::remove(entries.begin(), entries.end(), string(".")), entries.end());
+        entries.erase(std::remove(entries.begin(), entries.end(), string("..")), entries.end());
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+
+    // Get the stamp of the current configuration
+    // =============================================================================================
+    string PkiStore::configurationStamp() const
+    {
+        const ClientSettings& settings = database_->clientSettings;
+
+        string paths[] = { settings.certificateRevocationListLocation,
+                           settings.certificateTrustListLocation,
+                           settings.issuersRevocationListLocation,
+                           settings.issuersCertificatesLocation,
+                           settings.clientCertificate,
+                           settings.clientPrivateKey };
+
+        stringstream ss;
+        ss << settings.createSecurityLocationsIfNeeded;
+
+        for (std::size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++)
+        {
+            ss << "|" << paths[i] << "@";
+            appendFileStamp(ss, paths[i]);
+
+            // adding, removing or renaming a certificate or CRL changes the time of its
+            // directory, but overwriting it in place only changes the time of the file itself
+            std::vector<string> entries = directoryEntries(paths[i]);
+            for (std::vector<string>::const_iterator it = entries.begin();
+                 it != entries.end();
+                 ++it)
+            {
+                ss << "|" << *it << "@";
+                appendFileStamp(ss, paths[i] + "/" + *it);
+            }
+        }
+
+        return ss.str();
+    }
+
+
+    // Update the given security info
+    // =============================================================================================
+    Status PkiStore::initialize(
+            UaClientSdk::SessionSecurityInfo&   uaSecurity,
+            bool                                needsClientCertificate)
+    {
+        Status ret;
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        string stamp = configurationStamp();
+
+        if (stamp != stamp_)
+        {
+            logger_->debug("The security configuration has changed, so the PKI provider must "
+                           "be initialized again");
+            stamp_                   = stamp;
+            pkiProviderInitialized_  = false;
+            clientCertificateLoaded_ = false;
+            trustedCertificates_.clear();
+        }
+
+        if (pkiProviderInitialized_)
+            ret = statuscodes::Good;
+        else
+            ret = initializePkiProvider();
+
+        if (ret.isGood() && needsClientCertificate && !clientCertificateLoaded_)
+            ret = loadClientCertificate();
+
+        if (ret.isGood())
+        {
+            if (needsClientCertificate)
+                uaSecurity = uaSecurityWithClientCertificate_;
+            else
+                uaSecurity = uaSecurity_;
+        }
+        else
+        {
+            // try again next time, even if nothing has changed
+            stamp_.clear();
+        }
+
+        return ret;
+    }
+
+
+    // Initialize the PKI provider
+    // =============================================================================================
+    Status PkiStore::initializePkiProvider()
+    {
+        Status ret;
+        logger_->debug("Initializing the PKI store");
+
+        string certificateRevocationListLocation = \
+                database_->clientSettings.certificateRevocationListLocation;
+        string certificateTrustListLocation = \
+                database_->clientSettings.certificateTrustListLocation;
+        string issuersRevocationListLocation = \
+                database_->clientSettings.issuersRevocationListLocation;
+        string issuersCertificatesLocation = \
+                database_->clientSettings.issuersCertificatesLocation;
+
+        bool checkOnly = !(database_->clientSettings.createSecurityLocationsIfNeeded);
+
+        ret = checkOrCreatePath(
+                checkOnly,
+                certificateRevocationListLocation,
+                "certificate revocation list location");
+
+        if (ret.isGood())
+            ret = checkOrCreatePath(
+                    checkOnly,
+                    certificateTrustListLocation,
+                    "certificate trust list location");
+
+        if (ret.isGood())
+            ret = checkOrCreatePath(
+                    checkOnly,
+                    issuersRevocationListLocation,
+                    "issuers revocation trust list location");
+
+        if (ret.isGood())
+            ret = checkOrCreatePath(
+                    checkOnly,
+                    issuersCertificatesLocation,
+                    "issuers certificates location");
+
+        if (ret.isGood())
+        {
+            logger_->debug("Now initializing the OpenSSL PKI store via the SDK");
+            uaSecurity_ = UaClientSdk::SessionSecurityInfo();
+            SdkStatus sdkStatus = uaSecurity_.initializePkiProviderOpenSSL(
+                    UaString(certificateRevocationListLocation.c_str()),
+                    UaString(certificateTrustListLocation.c_str()),
+                    UaString(issuersRevocationListLocation.c_str()),
+                    UaString(issuersCertificatesLocation.c_str()));
+
+            if (sdkStatus.isGood())
+                logger_->debug("The OpenSSL PKI store was initialized successfully");
+            else
+                ret = OpenSSLStoreInitializationError(sdkStatus);
+        }
+
+        // the paths may have been created, so update the stamp
+        stamp_ = configurationStamp();
+        pkiProviderInitialized_ = ret.isGood();
+
+        if (ret.isGood())
+            logger_->debug("The PKI store has been initialized");
+        else
+            logger_->error(ret.toString());
+
+        return ret;
+    }
+
+
+    // Load the client certificate from a file
+    // =============================================================================================
+    Status PkiStore::loadClientCertificate()
+    {
+        logger_->debug("Loading the client certificate and private key");
+
+        string clientCertificate = database_->clientSettings.clientCertificate;
+        string clientPrivateKey = database_->clientSettings.clientPrivateKey;
+
+        const bool checkOnly = true;
+
+        Status ret = checkOrCreatePath(checkOnly, clientCertificate, "client certificate");
+
+        if (ret.isGood())
+            ret = checkOrCreatePath(checkOnly, clientPrivateKey, "client private key");
+
+        if (ret.isGood())
+        {
+            logger_->debug("Now loading the client certificate via the SDK");
+            uaSecurityWithClientCertificate_ = uaSecurity_;
+            SdkStatus sdkStatus = uaSecurityWithClientCertificate_.loadClientCertificateOpenSSL(
+                    UaString(clientCertificate.c_str()),
+                    UaString(clientPrivateKey.c_str()));
+
+            if (sdkStatus.isGood())
+                logger_->debug("The client certificate was loaded successfully (%s)",
+                               sdkStatus.toString().c_str());
+            else
+                ret = ClientCertificateLoadingError(sdkStatus);
+        }
+
+        clientCertificateLoaded_ = ret.isGood();
+
+        if (ret.isGood())
+            logger_->debug("The client certificate and private key are loaded");
+        else
+            logger_->error(ret.toString());
+
+        return ret;
+    }
+
+
+    // Check if a server certificate was verified before
+    // =============================================================================================
+    bool PkiStore::isTrusted(const UaByteString& serverCertificate)
+    {
+        UaPkiCertificate uaCert = UaPkiCertificate::fromDER(serverCertificate);
+        string thumbprint(uaCert.thumbPrint().toHex().toUtf8());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        TrustedCertificates::iterator iter = trustedCertificates_.find(thumbprint);
+
+        if (iter == trustedCertificates_.end())
+            return false;
+
+        // an expired certificate must be verified (and rejected) again
+        if (UaDateTime::now() >= iter->second)
+        {
+            trustedCertificates_.erase(iter);
+            return false;
+        }
+
+        logger_->debug("Server certificate %s was verified before", thumbprint.c_str());
+        return true;
+    }
+
+
+    // Remember a trusted server certificate
+    // =============================================================================================
+    void PkiStore::setTrusted(const UaByteString& serverCertificate)
+    {
+        UaPkiCertificate uaCert = UaPkiCertificate::fromDER(serverCertificate);
+        string thumbprint(uaCert.thumbPrint().toHex().toUtf8());
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        // only remember the certificates that were verified by the current PKI provider
+        if (pkiProviderInitialized_)
+            trustedCertificates_[thumbprint] = uaCert.validTo();
+    }
+
+
+    // Check or create a path
+    // =============================================================================================
+    Status PkiStore::checkOrCreatePath(
+            bool checkOnly, const string& path, const string& description) const
+    {
+        Status ret;
+
+        logger_->debug("Checking %s: %s", description.c_str(), path.c_str());
+        UaDir helperDir(UaUniString(""));
+        if (helperDir.exists(UaUniString(path.c_str())))
+        {
+            ret = statuscodes::Good;
+            logger_->debug("OK, the %s exists", description.c_str());
+        }
+        else
+        {
+            if (checkOnly)
+            {
+                ret = PathNotExistsError(path, description);
+                logger_->error(ret.toString());
+            }
+            else
+            {
+                logger_->debug("The path does not exist so we try to create it");
+                if (helperDir.mkpath(UaUniString(path.c_str())))
+                {
+                    ret = statuscodes::Good;
+                    logger_->debug("The %s has been created", path.c_str());
+                }
+                else
+                {
+                    ret = PathCreationError(path, description);
+                    logger_->error(ret.toString());
+                }
+            }
+        }
+
+        return ret;
+    }
+
+
+}
@@ -0,0 +1,188 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_PKISTORE_H_
+#define UAF_PKISTORE_H_
+
+
+// STD
+#include <string>
+#include <map>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+// SDK
+#include "uabase/uamutex.h"
+#include "uabase/uadatetime.h"
+#include "uabase/uadir.h"
+#include "uaclient/uaclientsdk.h"
+#include "uapki/uapkicertificate.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/status.h"
+#include "uaf/util/sdkstatus.h"
+#include "uaf/util/logger.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/database/database.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::PkiStore holds the PKI provider that is shared by all sessions of a client.
+    *
+    * Initializing the OpenSSL PKI provider (and loading the client certificate) means reading the
+    * trust lists, the revocation lists and the certificates from disk. Instead of doing this for
+    * every connection attempt of every session, the store initializes a single SDK
+    * SessionSecurityInfo and copies it to the sessions. It is only initialized again if the
+    * security settings of the client have changed, or if the modification time of one of the
+    * configured locations has changed (e.g. because a certificate was added to the trust list).
+    *
+    * The store also remembers the thumbprints of the server certificates that have been verified
+    * successfully, so that they don't need to be verified again. This cache is cleared whenever
+    * the PKI provider is initialized again.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT PkiStore
+    {
+    public:
+
+
+        /**
+         * Construct an empty store (it is initialized when it is used for the first time).
+         *
+         * @param loggerFactory Logger factory to log all messages to.
+         * @param database      Pointer to the client database.
+         */
+        PkiStore(uaf::LoggerFactory* loggerFactory, uaf::Database* database);
+
+
+        /**
+         * Destruct the store.
+         */
+        virtual ~PkiStore();
+
+
+        /**
+         * Copy the shared PKI provider (and, if needed, the client certificate) to the given
+         * SDK SessionSecurityInfo, after (re)initializing them if needed.
+         *
+         * @param uaSecurity                Output parameter: the SDK security info to update.
+         * @param needsClientCertificate    True if the client certificate must be loaded too.
+         * @return                          Good if the security info could be updated.
+         */
+        uaf::Status initialize(
+                UaClientSdk::SessionSecurityInfo&   uaSecurity,
+                bool                                needsClientCertificate);
+
+
+        /**
+         * Check if a server certificate has been verified successfully before, by the current
+         * PKI provider.
+         *
+         * @param serverCertificate The DER encoded server certificate.
+         * @return                  True if the certificate is known to be trusted and has not
+         *                          expired yet.
+         */
+        bool isTrusted(const UaByteString& serverCertificate);
+
+
+        /**
+         * Remember that a server certificate has been verified successfully.
+         *
+         * @param serverCertificate The DER encoded server certificate.
+         */
+        void setTrusted(const UaByteString& serverCertificate);
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(PkiStore);
+
+
+        /**
+         * Get a description of the current security configuration, including the modification
+         * times (with sub-second precision, where the platform provides it) and the sizes of all
+         * locations and of the files inside them. If it differs from the previous one, the PKI
+         * provider must be initialized again.
+         */
+        std::string configurationStamp() const;
+
+
+        /**
+         * Initialize the PKI provider (the mutex must be locked!).
+         */
+        uaf::Status initializePkiProvider();
+
+
+        /**
+         * Load the client certificate (the mutex must be locked!).
+         */
+        uaf::Status loadClientCertificate();
+
+
+        /**
+         * Helper function to check if a path exists, or create the path if needed.
+         */
+        uaf::Status checkOrCreatePath(
+                bool checkOnly,
+                const std::string& path,
+                const std::string& description) const;
+
+
+        // logger of the store
+        uaf::Logger* logger_;
+        // pointer to the client database
+        uaf::Database* database_;
+
+        // the stamp of the configuration that the PKI provider was initialized with
+        std::string stamp_;
+        // true if the PKI provider has been initialized successfully
+        bool pkiProviderInitialized_;
+        // the SDK security info holding only the PKI provider
+        UaClientSdk::SessionSecurityInfo uaSecurity_;
+        // true if the client certificate has been loaded successfully
+        bool clientCertificateLoaded_;
+        // the SDK security info holding the PKI provider and the client certificate
+        UaClientSdk::SessionSecurityInfo uaSecurityWithClientCertificate_;
+
+        // the thumbprints of the trusted server certificates, and their expiration times
+        typedef std::map<std::string, UaDateTime> TrustedCertificates;
+        TrustedCertificates trustedCertificates_;
+
+        // mutex to safely manipulate the members above
+        UaMutex mutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_PKISTORE_H_ */
@@ -0,0 +1,274 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/sessions/registerednodes.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::stringstream;
+    using std::vector;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    RegisteredNodes::RegisteredNodes()
+    : shared_(NULL)
+    {}
+
+
+    // Copy constructor
+    // =============================================================================================
+    RegisteredNodes::RegisteredNodes(const RegisteredNodes& other)
+    : shared_(acquire(other.shared_))
+    {}
+
+
+    // Assignment operator
+    // =============================================================================================
+    RegisteredNodes& RegisteredNodes::operator=(const RegisteredNodes& other)
+    {
+        // acquire first, in case the other object shares the same aliases
+        Shared* shared = acquire(other.shared_);
+        release(shared_);
+        shared_ = shared;
+        return *this;
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    RegisteredNodes::~RegisteredNodes()
+    {
+        release(shared_);
+    }
+
+
+    // Start sharing aliases
+    // =============================================================================================
+    RegisteredNodes::Shared* RegisteredNodes::acquire(Shared* shared)
+    {
+        if (shared != NULL)
+        {
+            UaMutexLocker locker(&shared->mutex); // unlocks when locker goes out of scope
+            shared->referenceCount++;
+        }
+        return shared;
+    }
+
+
+    // Stop sharing aliases
+    // =============================================================================================
+    void RegisteredNodes::release(Shared* shared)
+    {
+        if (shared == NULL)
+            return;
+
+        bool unused;
+        {
+            UaMutexLocker locker(&shared->mutex); // unlocks when locker goes out of scope
+            shared->referenceCount--;
+            unused = (shared->referenceCount == 0);
+        }
+
+        if (unused)
+            delete shared;
+    }
+
+
+    // Get the aliases for modification
+    // =============================================================================================
+    RegisteredNodes::Aliases& RegisteredNodes::mutableAliases()
+    {
+        bool shared = false;
+        if (shared_ != NULL)
+        {
+            UaMutexLocker locker(&shared_->mutex); // unlocks when locker goes out of scope
+            shared = (shared_->referenceCount > 1);
+        }
+
+        // if other objects (e.g. service invocations) share the aliases, they keep their
+        // snapshot and we continue with a copy
+        if (shared_ == NULL || shared)
+        {
+            Shared* copy = new Shared();
+            copy->referenceCount = 1;
+            if (shared_ != NULL)
+                copy->aliases = shared_->aliases;
+            release(shared_);
+            shared_ = copy;
+        }
+
+        return shared_->aliases;
+    }
+
+
+    // Add a registered node
+    // =============================================================================================
+    void RegisteredNodes::add(const NodeId& nodeId, const NodeId& registeredNodeId)
+    {
+        mutableAliases()[nodeId] = registeredNodeId;
+    }
+
+
+    // Remove a registered node
+    // =============================================================================================
+    void RegisteredNodes::remove(const NodeId& nodeId)
+    {
+        if (!isEmpty())
+            mutableAliases().erase(nodeId);
+    }
+
+
+    // Remove all registered nodes
+    // =============================================================================================
+    void RegisteredNodes::clear()
+    {
+        release(shared_);
+        shared_ = NULL;
+    }
+
+
+    // Check if a node has been registered
+    // =============================================================================================
+    bool RegisteredNodes::contains(const NodeId& nodeId) const
+    {
+        return !isEmpty() && shared_->aliases.find(nodeId) != shared_->aliases.end();
+    }
+
+
+    // Get the registered nodes
+    // =============================================================================================
+    vector<NodeId> RegisteredNodes::nodeIds() const
+    {
+        vector<NodeId> ret;
+        if (shared_ == NULL)
+            return ret;
+
+        const Aliases& aliases = shared_->aliases;
+        ret.reserve(aliases.size());
+        for (Aliases::const_iterator it = aliases.begin(); it != aliases.end(); ++it)
+            ret.push_back(it->first);
+        return ret;
+    }
+
+
+    // Get the NodeId under which a node is stored
+    // =============================================================================================
+    bool RegisteredNodes::findKey(
+            const Address&          address,
+            const NamespaceArray&   nameSpaceArray,
+            NodeId&                 nodeId)
+    {
+        if (!address.isExpandedNodeId())
+            return false;
+
+        NodeId addressedNodeId = address.getExpandedNodeId().nodeId();
+
+        // the registered nodes are stored with their namespace URI (not their namespace index,
+        // since the namespace array of the server may change when the session is reconnected)
+        string nameSpaceUri;
+        if (addressedNodeId.hasNameSpaceUri())
+        {
+            nameSpaceUri = addressedNodeId.nameSpaceUri();
+        }
+        else if (addressedNodeId.hasNameSpaceIndex())
+        {
+            NameSpaceIndex nameSpaceIndex = addressedNodeId.nameSpaceIndex();
+            if (!nameSpaceArray.findNamespaceUri(nameSpaceIndex, nameSpaceUri))
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+
+        nodeId = NodeId(addressedNodeId.identifier(), nameSpaceUri);
+        return true;
+    }
+
+
+    // Find the alias of a registered node
+    // =============================================================================================
+    bool RegisteredNodes::findRegisteredNodeId(
+            const Address&          address,
+            const NamespaceArray&   nameSpaceArray,
+            NodeId&                 registeredNodeId) const
+    {
+        NodeId nodeId;
+        if (isEmpty() || !findKey(address, nameSpaceArray, nodeId))
+            return false;
+
+        Aliases::const_iterator it = shared_->aliases.find(nodeId);
+        if (it == shared_->aliases.end())
+            return false;
+
+        registeredNodeId = it->second;
+        return true;
+    }
+
+
+    // Fill an OpcUa_NodeId
+    // =============================================================================================
+    Status RegisteredNodes::fillOpcUaNodeId(
+            const Address&          address,
+            const NamespaceArray&   nameSpaceArray,
+            OpcUa_NodeId&           opcUaNodeId) const
+    {
+        NodeId registeredNodeId;
+        if (findRegisteredNodeId(address, nameSpaceArray, registeredNodeId))
+            return nameSpaceArray.fillOpcUaNodeId(registeredNodeId, opcUaNodeId);
+        else
+            return nameSpaceArray.fillOpcUaNodeId(address, opcUaNodeId);
+    }
+
+
+    // Get a string representation
+    // =============================================================================================
+    string RegisteredNodes::toString(const string& indent, size_t colon) const
+    {
+        stringstream ss;
+
+        ss << indent << " - aliases[]";
+        if (isEmpty())
+        {
+            ss << fillToPos(ss, colon);
+            ss << ": []";
+        }
+        else
+        {
+            const Aliases& aliases = shared_->aliases;
+            size_t i = 0;
+            for (Aliases::const_iterator it = aliases.begin(); it != aliases.end(); ++it, ++i)
+            {
+                ss << "\n";
+                ss << indent << "    - aliases[" << i << "]";
+                ss << fillToPos(ss, colon);
+                ss << ": " << it->first.toString() << " -> " << it->second.toString();
+            }
+        }
+
+        return ss.str();
+    }
+
+
+}
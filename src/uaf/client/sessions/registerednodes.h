@@ -0,0 +1,236 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_REGISTEREDNODES_H_
+#define UAF_REGISTEREDNODES_H_
+
+// STD
+#include <string>
+#include <sstream>
+#include <vector>
+#include <map>
+// SDK
+#include "uabase/uanodeid.h"
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/status.h"
+#include "uaf/util/address.h"
+#include "uaf/util/nodeid.h"
+#include "uaf/util/namespacearray.h"
+#include "uaf/util/stringifiable.h"
+#include "uaf/client/clientexport.h"
+
+namespace uaf
+{
+
+    /*******************************************************************************************//**
+    * A RegisteredNodes object contains the nodes that were registered within a session (by the
+    * RegisterNodes service), together with the aliases (i.e. the registered NodeIds) that the
+    * server has assigned to them.
+    *
+    * The nodes are stored with their namespace URI (so they can be registered again when the
+    * session is reconnected, even if the namespace array of the server has changed). Their aliases
+    * are stored with a namespace index, exactly as they were returned by the server.
+    *
+    * The aliases are shared (copy-on-write) between copies of a RegisteredNodes object, so a
+    * snapshot of the registered nodes can be handed to every service invocation without copying
+    * them. Copies may be used and destroyed by different threads.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT RegisteredNodes
+    {
+    public:
+
+
+        /**
+         * Create an empty RegisteredNodes object.
+         */
+        RegisteredNodes();
+
+
+        /**
+         * Create a copy that shares the aliases of another RegisteredNodes object.
+         *
+         * @param other The RegisteredNodes object to share the aliases with.
+         */
+        RegisteredNodes(const RegisteredNodes& other);
+
+
+        /**
+         * Share the aliases of another RegisteredNodes object.
+         *
+         * @param other The RegisteredNodes object to share the aliases with.
+         * @return      This object.
+         */
+        RegisteredNodes& operator=(const RegisteredNodes& other);
+
+
+        /**
+         * Destruct the RegisteredNodes object (and the aliases, if they are no longer shared).
+         */
+        ~RegisteredNodes();
+
+
+        /**
+         * Add (or replace) the alias of a registered node.
+         *
+         * @param nodeId            The node that was registered (with a namespace URI).
+         * @param registeredNodeId  The alias that the server has assigned to it (with a namespace
+         *                          index).
+         */
+        void add(const uaf::NodeId& nodeId, const uaf::NodeId& registeredNodeId);
+
+
+        /**
+         * Remove a registered node.
+         *
+         * @param nodeId    The node that was registered (with a namespace URI).
+         */
+        void remove(const uaf::NodeId& nodeId);
+
+
+        /**
+         * Remove all registered nodes.
+         */
+        void clear();
+
+
+        /**
+         * Check if any nodes have been registered.
+         *
+         * @return  True if no nodes have been registered.
+         */
+        bool isEmpty() const { return shared_ == NULL || shared_->aliases.empty(); }
+
+
+        /**
+         * Check if a node has been registered.
+         *
+         * @param nodeId    The node (with a namespace URI).
+         * @return          True if the node has been registered.
+         */
+        bool contains(const uaf::NodeId& nodeId) const;
+
+
+        /**
+         * Get the number of registered nodes.
+         *
+         * @return  The number of registered nodes.
+         */
+        std::size_t size() const { return shared_ == NULL ? 0 : shared_->aliases.size(); }
+
+
+        /**
+         * Get the registered nodes (without their aliases).
+         *
+         * @return  The nodes that were registered (with a namespace URI).
+         */
+        std::vector<uaf::NodeId> nodeIds() const;
+
+
+        /**
+         * Get the NodeId under which the node that is addressed by the given (resolved) address
+         * is stored, i.e. the NodeId with the namespace URI (and without namespace index).
+         *
+         * @param address           The address, which must be an ExpandedNodeId.
+         * @param nameSpaceArray    The namespace array of the server.
+         * @param nodeId            Output parameter: the NodeId with its namespace URI.
+         * @return                  True if the NodeId could be found, false if not.
+         */
+        static bool findKey(
+                const uaf::Address&         address,
+                const uaf::NamespaceArray&  nameSpaceArray,
+                uaf::NodeId&                nodeId);
+
+
+        /**
+         * Find the alias of the node that is addressed by the given (resolved) address.
+         *
+         * @param address           The address, which must be an ExpandedNodeId.
+         * @param nameSpaceArray    The namespace array of the server.
+         * @param registeredNodeId  Output parameter: the alias of the node.
+         * @return                  True if the node has been registered, false if not.
+         */
+        bool findRegisteredNodeId(
+                const uaf::Address&         address,
+                const uaf::NamespaceArray&  nameSpaceArray,
+                uaf::NodeId&                registeredNodeId) const;
+
+
+        /**
+         * Fill an OpcUa_NodeId from a (resolved) address, using the alias of the node if it has
+         * been registered.
+         *
+         * @param address           The address, which must be an ExpandedNodeId.
+         * @param nameSpaceArray    The namespace array of the server.
+         * @param opcUaNodeId       The OpcUa_NodeId to be updated.
+         * @return                  Good if the OpcUa_NodeId could be updated, bad if not.
+         */
+        uaf::Status fillOpcUaNodeId(
+                const uaf::Address&         address,
+                const uaf::NamespaceArray&  nameSpaceArray,
+                OpcUa_NodeId&               opcUaNodeId) const;
+
+
+        /**
+         * Get a string representation.
+         *
+         * @return String representation.
+         */
+        std::string toString(const std::string& indent="", std::size_t colon=20) const;
+
+
+    private:
+
+        // the aliases (with a namespace index) of the registered nodes (with a namespace URI)
+        typedef std::map<uaf::NodeId, uaf::NodeId> Aliases;
+
+        // the aliases, together with the number of RegisteredNodes objects that share them
+        struct Shared
+        {
+            Aliases         aliases;
+            std::size_t     referenceCount;
+            UaMutex         mutex;
+        };
+
+        // the shared aliases (NULL if no nodes have been registered)
+        Shared* shared_;
+
+
+        /** Start sharing the given aliases (which may be NULL). */
+        static Shared* acquire(Shared* shared);
+
+
+        /** Stop sharing the given aliases (which may be NULL), and delete them if needed. */
+        static void release(Shared* shared);
+
+
+        /** Get the aliases, for modification (they are copied first if they are shared). */
+        Aliases& mutableAliases();
+
+    };
+
+
+}
+
+
+
+#endif /* UAF_REGISTEREDNODES_H_ */
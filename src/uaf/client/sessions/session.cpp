@@ -40,16 +40,21 @@ namespace uaf
             UaClientSdk::UaSessionCallback* uaSessionCallback,
             ClientInterface*                clientInterface,
             Discoverer*                     discoverer,
+            PkiStore*                       pkiStore,
             Database*                       database)
     : uaSessionCallback_(uaSessionCallback),
+      registeredNodesValid_(true),
+      registeredNodesEpoch_(0),
       sessionState_(uaf::sessionstates::Disconnected),
       lastConnectionAttemptStep_(connectionsteps::NoAttemptYet),
+      connectionAttempted_(false),
       clientConnectionId_(clientConnectionId),
       serverUri_(serverUri),
       sessionSettings_(sessionSettings),
       database_(database),
       clientInterface_(clientInterface),
-      discoverer_(discoverer)
+      discoverer_(discoverer),
+      pkiStore_(pkiStore)
     {
         // build the logger name:
         stringstream loggerName;
@@ -67,6 +72,13 @@ namespace uaf
                 clientInterface_,
                 database);
 
+        // create a model change monitor (which is only started if the client settings say so)
+        modelChangeMonitor_ = new ModelChangeMonitor(
+                loggerFactory,
+                clientConnectionId,
+                uaSession_,
+                database);
+
         updateConnectionInfo(uaSessionConnectInfo_, clientConnectionId, true);
         updateConnectionInfo(uaSessionConnectInfoNoInitialRetry_, clientConnectionId, false);
 
@@ -84,6 +96,10 @@ namespace uaf
         // try to disconnect the session
         Status disconnectionStatus = disconnect();
 
+        // delete the model change monitor
+        delete modelChangeMonitor_;
+        modelChangeMonitor_ = 0;
+
         // delete the subscription factory
         delete subscriptionFactory_;
         subscriptionFactory_ = 0;
@@ -126,110 +142,6 @@ namespace uaf
     }
 
 
-    // Initialize the PKI store
-    // =============================================================================================
-    Status Session::initializePkiStore(UaClientSdk::SessionSecurityInfo& uaSecurity)
-    {
-        Status ret;
-        logger_->debug("Initializing the PKI store");
-
-        string certificateRevocationListLocation = \
-                database_->clientSettings.certificateRevocationListLocation;
-        string certificateTrustListLocation = \
-                database_->clientSettings.certificateTrustListLocation;
-        string issuersRevocationListLocation = \
-                database_->clientSettings.issuersRevocationListLocation;
-        string issuersCertificatesLocation = \
-                database_->clientSettings.issuersCertificatesLocation;
-
-        bool checkOnly = !(database_->clientSettings.createSecurityLocationsIfNeeded);
-
-        ret = checkOrCreatePath(
-                checkOnly,
-                certificateRevocationListLocation,
-                "certificate revocation list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    certificateTrustListLocation,
-                    "certificate trust list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    issuersRevocationListLocation,
-                    "issuers revocation trust list location");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(
-                    checkOnly,
-                    issuersCertificatesLocation,
-                    "issuers certificates location");
-
-        if (ret.isGood())
-        {
-            logger_->debug("Now initializing the OpenSSL PKI store via the SDK");
-            SdkStatus sdkStatus = uaSecurity.initializePkiProviderOpenSSL(
-                    UaString(certificateRevocationListLocation.c_str()),
-                    UaString(certificateTrustListLocation.c_str()),
-                    UaString(issuersRevocationListLocation.c_str()),
-                    UaString(issuersCertificatesLocation.c_str()));
-
-            if (sdkStatus.isGood())
-                logger_->debug("The OpenSSL PKI store was initialized successfully");
-            else
-                ret = OpenSSLStoreInitializationError(sdkStatus);
-        }
-
-        if (ret.isGood())
-            logger_->debug("The PKI store has been initialized");
-        else
-            logger_->error(ret.toString());
-
-        return ret;
-    }
-
-
-    // Load the client certificate from a file
-    // =============================================================================================
-    Status Session::loadClientCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity)
-    {
-        logger_->debug("Loading the client certificate and private key");
-
-        string clientCertificate = database_->clientSettings.clientCertificate;
-        string clientPrivateKey = database_->clientSettings.clientPrivateKey;
-
-        const bool checkOnly = true;
-
-        Status ret = checkOrCreatePath(checkOnly, clientCertificate, "client certificate");
-
-        if (ret.isGood())
-            ret = checkOrCreatePath(checkOnly, clientPrivateKey, "client private key");
-
-        if (ret.isGood())
-        {
-            logger_->debug("Now loading the client certificate via the SDK");
-            SdkStatus sdkStatus = uaSecurity.loadClientCertificateOpenSSL(
-                    UaString(clientCertificate.c_str()),
-                    UaString(clientPrivateKey.c_str()));
-
-            if (sdkStatus.isGood())
-                logger_->debug("The client certificate was loaded successfully (%s)",
-                               sdkStatus.toString().c_str());
-            else
-                ret = ClientCertificateLoadingError(sdkStatus);
-        }
-
-        if (ret.isGood())
-            logger_->debug("The client certificate and private key are loaded");
-        else
-            logger_->error(ret.toString());
-
-        return ret;
-    }
-
-
 //    // Load the server certificate from a file
 //    // =============================================================================================
 //    Status Session::loadServerCertificateFromFile(UaClientSdk::SessionSecurityInfo& uaSecurity)
@@ -348,12 +260,44 @@ namespace uaf
 
 
 
-    // Connect the session
+    // Initialize the PKI store
+    // =============================================================================================
+    Status Session::initializePkiStore(UaClientSdk::SessionSecurityInfo& uaSecurity)
+    {
+        logger_->debug("Initializing the PKI store");
+
+        // only load the client certificate if we need to sign or encrypt the data!
+        bool needsClientCertificate =
+                   sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_Sign
+                || sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_SignAndEncrypt;
+
+        if (!needsClientCertificate)
+            logger_->debug("Security is not needed so we don't need to load the client certificate");
+
+        Status ret = pkiStore_->initialize(uaSecurity, needsClientCertificate);
+
+        if (ret.isGood())
+            logger_->debug("The PKI store has been initialized");
+
+        return ret;
+    }
+
+
+    // Verify the server certificate
     // =============================================================================================
     Status Session::verifyServerCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity)
     {
         Status ret;
 
+        // if the same certificate was verified before by the same PKI provider, we don't need to
+        // verify it again (not even by the SDK while connecting)
+        if (pkiStore_->isTrusted(uaSecurity.serverCertificate))
+        {
+            logger_->debug("The server certificate was verified before, so it is trusted");
+            uaSecurity.doServerCertificateVerify = false;
+            return statuscodes::Good;
+        }
+
         logger_->debug("Now verifying the server certificate");
 
         SdkStatus trustStatus(uaSecurity.verifyServerCertificate());
@@ -361,6 +305,7 @@ namespace uaf
         if (trustStatus.isGood())
         {
             logger_->debug("The server certificate is trusted");
+            pkiStore_->setTrusted(uaSecurity.serverCertificate);
             ret = statuscodes::Good;
         }
         else
@@ -417,6 +362,44 @@ namespace uaf
     // Connect the session
     // =============================================================================================
     Status Session::connect()
+    {
+        // only one connection attempt at a time (this doesn't block any other session)
+        UaMutexLocker locker(&connectionMutex_); // unlocks when locker goes out of scope
+
+        connectionAttempted_ = true;
+
+        return establishConnection();
+    }
+
+
+    // Connect the session, unless this was attempted before
+    // =============================================================================================
+    Status Session::connectIfNotAttemptedYet()
+    {
+        // if another thread is connecting the session, we wait here until it has finished
+        UaMutexLocker locker(&connectionMutex_); // unlocks when locker goes out of scope
+
+        if (connectionAttempted_)
+            return statuscodes::Good;
+
+        connectionAttempted_ = true;
+
+        return establishConnection();
+    }
+
+
+    // Forget the previous connection attempt
+    // =============================================================================================
+    void Session::resetConnectionAttempt()
+    {
+        UaMutexLocker locker(&connectionMutex_); // unlocks when locker goes out of scope
+        connectionAttempted_ = false;
+    }
+
+
+    // Establish the connection (the connectionMutex_ must be locked!)
+    // =============================================================================================
+    Status Session::establishConnection()
     {
         Status ret;
         logger_->debug("Connecting the session");
@@ -436,20 +419,10 @@ namespace uaf
         ret = discoverer_->getDiscoveryUrls(serverUri_, discoveryUrls);
 
         // use the discoverer to request the endpoint URLs for the given discovery URL(s)
-        for (vector<string>::const_iterator it = discoveryUrls.begin();
-             it != discoveryUrls.end() && ret.isGood();
-             ++it)
-        {
-            vector<EndpointDescription> tmp;
-            ret = discoverer_->getEndpoints(*it, tmp);
-
-            if (ret.isGood())
-                discoveredEndpoints.insert(discoveredEndpoints.end(), tmp.begin(), tmp.end());
-        }
-
-        // in case discovery went fine, check if we found some endpoints
-        if (ret.isGood() && discoveredEndpoints.size() == 0)
-            ret = NoDiscoveryUrlsFoundError();
+        // (they may be taken from the endpoint cache of the discoverer)
+        bool fromCache = false;
+        if (ret.isGood())
+            ret = getEndpoints(discoveryUrls, discoveredEndpoints, fromCache);
 
         // declare the SDK SessionSecurityInfo
         UaClientSdk::SessionSecurityInfo uaSecurity;
@@ -461,6 +434,23 @@ namespace uaf
                   discoveredEndpoints,
                   suitableEndpoint);
 
+        // if none of the cached endpoints matches, the security configuration of the server may
+        // have changed, so we fetch the endpoints again and retry
+        if (ret.isNotGood() && fromCache)
+        {
+            logger_->debug("No suitable cached endpoint was found, so we fetch them again");
+
+            invalidateEndpoints(discoveryUrls);
+            discoveredEndpoints.clear();
+            ret = getEndpoints(discoveryUrls, discoveredEndpoints, fromCache);
+
+            if (ret.isGood())
+                ret = match(
+                      sessionSettings_.securitySettings,
+                      discoveredEndpoints,
+                      suitableEndpoint);
+        }
+
         if (ret.isGood())
         {
             logger_->debug("The following SessionSecuritySettings will be used:");
@@ -469,7 +459,8 @@ namespace uaf
             logger_->debug(suitableEndpoint.toString());
         }
 
-        // initialize the PKI store so that we can verify the server certificate
+        // get the shared PKI store (and the client certificate, if we need to sign or encrypt
+        // the data) so that we can verify the server certificate
         if (ret.isGood())
             ret = initializePkiStore(uaSecurity);
 
@@ -477,18 +468,14 @@ namespace uaf
         if (ret.isGood())
             ret = loadServerCertificateFromEndpoint(uaSecurity, suitableEndpoint);
 
-        // always verify the server certificate
+        // always verify the server certificate (if it is rejected, the server certificate
+        // in the cached endpoints may be outdated, so we don't use them anymore)
         if (ret.isGood())
+        {
             ret = verifyServerCertificate(uaSecurity);
 
-        // only load the client certificate if we need to sign or encrypt the data!
-        if (ret.isGood())
-        {
-            if (   sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_Sign
-                || sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_SignAndEncrypt)
-                ret = loadClientCertificate(uaSecurity);
-            else
-                logger_->debug("Security is not needed so we don't need to initialize the PKI store");
+            if (ret.isNotGood() && fromCache)
+                invalidateEndpoints(discoveryUrls);
         }
 
         // try to set the user identity, security policy and message security mode
@@ -520,6 +507,11 @@ namespace uaf
             else
             {
                 ret = ConnectionFailedError(suitableEndpoint.endpointUrl, sdkStatus);
+
+                // the server rejected our security settings, so the cached endpoints may be
+                // outdated
+                if (fromCache && isSecurityMismatch(sdkStatus))
+                    invalidateEndpoints(discoveryUrls);
             }
         }
 
@@ -539,10 +531,83 @@ namespace uaf
             lastConnectionAttemptStatus_ = ret;
         }
 
+        // start monitoring the model changes right away, so that the addresses that are
+        // resolved from now on are not cached while nobody is watching for changes
+        if (ret.isGood())
+            monitorModelChangesIfNeeded();
+
         return ret;
     }
 
 
+    // Get the endpoints of the given discovery URLs
+    // =============================================================================================
+    Status Session::getEndpoints(
+            const vector<string>&           discoveryUrls,
+            vector<EndpointDescription>&    endpoints,
+            bool&                           fromCache)
+    {
+        Status ret = statuscodes::Good;
+
+        fromCache = false;
+
+        for (vector<string>::const_iterator it = discoveryUrls.begin();
+             it != discoveryUrls.end() && ret.isGood();
+             ++it)
+        {
+            vector<EndpointDescription> tmp;
+            bool tmpFromCache = false;
+            ret = discoverer_->getEndpoints(*it, tmp, tmpFromCache);
+
+            if (ret.isGood())
+            {
+                endpoints.insert(endpoints.end(), tmp.begin(), tmp.end());
+                fromCache = fromCache || tmpFromCache;
+            }
+        }
+
+        // in case discovery went fine, check if we found some endpoints
+        if (ret.isGood() && endpoints.size() == 0)
+            ret = NoDiscoveryUrlsFoundError();
+
+        return ret;
+    }
+
+
+    // Invalidate the cached endpoints of the given discovery URLs
+    // =============================================================================================
+    void Session::invalidateEndpoints(const vector<string>& discoveryUrls)
+    {
+        for (vector<string>::const_iterator it = discoveryUrls.begin();
+             it != discoveryUrls.end();
+             ++it)
+        {
+            discoverer_->invalidateEndpoints(*it);
+        }
+    }
+
+
+    // Check if the server rejected the connection because of a security mismatch
+    // =============================================================================================
+    bool Session::isSecurityMismatch(const SdkStatus& sdkStatus)
+    {
+        switch (sdkStatus.statusCode)
+        {
+            case OpcUa_BadSecurityChecksFailed:
+            case OpcUa_BadSecurityPolicyRejected:
+            case OpcUa_BadSecurityModeRejected:
+            case OpcUa_BadCertificateInvalid:
+            case OpcUa_BadCertificateUntrusted:
+            case OpcUa_BadCertificateHostNameInvalid:
+            case OpcUa_BadCertificateUriInvalid:
+            case OpcUa_BadCertificateTimeInvalid:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+
     // Connect to a specific endpoint
     // =============================================================================================
     Status Session::connectToSpecificEndpoint(
@@ -551,6 +616,11 @@ namespace uaf
     {
         Status ret;
 
+        // only one connection attempt at a time (this doesn't block any other session)
+        UaMutexLocker locker(&connectionMutex_); // unlocks when locker goes out of scope
+
+        connectionAttempted_ = true;
+
         logger_->debug("Connecting the session to endpoint %s", endpointUrl.c_str());
 
 
@@ -565,7 +635,8 @@ namespace uaf
 
         // ============
 
-        // initialize the PKI store so that we can verify the server certificate
+        // get the shared PKI store (and the client certificate, if we need to sign or encrypt
+        // the data) so that we can verify the server certificate
         if (ret.isGood())
             ret = initializePkiStore(uaSecurity);
 
@@ -577,16 +648,6 @@ namespace uaf
         if (ret.isGood())
             ret = verifyServerCertificate(uaSecurity);
 
-        // only load the client certificate if we need to sign or encrypt the data!
-        if (ret.isGood())
-        {
-            if (   sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_Sign
-                || sessionSettings_.securitySettings.messageSecurityMode == messagesecuritymodes::Mode_SignAndEncrypt)
-                ret = loadClientCertificate(uaSecurity);
-            else
-                logger_->debug("Security is not needed so we don't need to initialize the PKI store");
-        }
-
         // try to set the user identity, security policy and message security mode
         if (ret.isGood())
         {
@@ -632,6 +693,10 @@ namespace uaf
             logger_->error("The session could not be connected: %s", ret.toString().c_str());
         }
 
+        // start monitoring the model changes right away (see establishConnection())
+        if (ret.isGood())
+            monitorModelChangesIfNeeded();
+
         return ret;
     }
 
@@ -648,6 +713,10 @@ namespace uaf
             logger_->debug("Now disconnecting %s and thereby deleting all subscriptions",
                            toString().c_str());
 
+            // delete the subscription of the model change monitor ourselves, since the SDK
+            // deletes the subscription objects when the session is disconnected
+            modelChangeMonitor_->stop();
+
             // try to disconnect (and delete subscriptions)
             UaClientSdk::ServiceSettings serviceSettings;
             UaStatus uaStatus = uaSession_->disconnect(serviceSettings, OpcUa_True);
@@ -701,11 +770,27 @@ namespace uaf
     }
 
 
-    // Update the server array and namespace array
+    // Get an operation limit from a read data value (0 if not available)
+    // =============================================================================================
+    uint32_t Session::operationLimit(const OpcUa_DataValue& dataValue)
+    {
+        OpcUa_UInt32 limit = 0;
+
+        if (OpcUa_IsGood(dataValue.StatusCode))
+        {
+            if (OpcUa_IsBad(UaVariant(dataValue.Value).toUInt32(limit)))
+                limit = 0;
+        }
+
+        return limit;
+    }
+
+
+    // Update the ServerArray, NamespaceArray and OperationLimits
     // =============================================================================================
     Status Session::updateArrays()
     {
-        logger_->debug("Updating the ServerArray and NamespaceArray");
+        logger_->debug("Updating the ServerArray, NamespaceArray and OperationLimits");
 
         Status ret;
 
@@ -725,14 +810,31 @@ namespace uaf
             // update the SDK service settings
             sessionSettings_.readServerInfoSettings.toSdk(uaServiceSettings);
 
-            // two values will need to be read (the server array and namespace array)
-            uaReadValueIds.create(2);
+            // nine values will need to be read (the server array, the namespace array and
+            // the seven operation limits that are relevant for the UAF)
+            uaReadValueIds.create(9);
             //  1) the server array:
             UaNodeId(OpcUaId_Server_ServerArray).copyTo(&uaReadValueIds[0].NodeId);
-            uaReadValueIds[0].AttributeId = OpcUa_Attributes_Value;
             //  2) the namespace array:
             UaNodeId(OpcUaId_Server_NamespaceArray).copyTo(&uaReadValueIds[1].NodeId);
-            uaReadValueIds[1].AttributeId = OpcUa_Attributes_Value;
+            //  3) the operation limits:
+            UaNodeId(OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerRead)
+                .copyTo(&uaReadValueIds[2].NodeId);
+            UaNodeId(OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerWrite)
+                .copyTo(&uaReadValueIds[3].NodeId);
+            UaNodeId(OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerBrowse)
+                .copyTo(&uaReadValueIds[4].NodeId);
+            UaNodeId(OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerMethodCall)
+                .copyTo(&uaReadValueIds[5].NodeId);
+            UaNodeId(
+                OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerTranslateBrowsePathsToNodeIds)
+                .copyTo(&uaReadValueIds[6].NodeId);
+            UaNodeId(OpcUaId_Server_ServerCapabilities_OperationLimits_MaxMonitoredItemsPerCall)
+                .copyTo(&uaReadValueIds[7].NodeId);
+            UaNodeId(OpcUaId_Server_ServerCapabilities_OperationLimits_MaxNodesPerRegisterNodes)
+                .copyTo(&uaReadValueIds[8].NodeId);
+            for (OpcUa_UInt32 i = 0; i < uaReadValueIds.length(); i++)
+                uaReadValueIds[i].AttributeId = OpcUa_Attributes_Value;
 
             // perform the read action
             uaReadStatus = uaSession_->read(
@@ -812,6 +914,25 @@ namespace uaf
                     logger_->debug(namespaceArray_.toString());
                 }
 
+                // 3) operation limits
+                // ------------------
+                // (optional nodes, so a server that doesn't expose them imposes no limits)
+                operationLimits_ = OperationLimits();
+                if (uaDataValues.length() == uaReadValueIds.length())
+                {
+                    operationLimits_.maxNodesPerRead          = operationLimit(uaDataValues[2]);
+                    operationLimits_.maxNodesPerWrite         = operationLimit(uaDataValues[3]);
+                    operationLimits_.maxNodesPerBrowse        = operationLimit(uaDataValues[4]);
+                    operationLimits_.maxNodesPerMethodCall    = operationLimit(uaDataValues[5]);
+                    operationLimits_.maxNodesPerTranslateBrowsePathsToNodeIds
+                                                              = operationLimit(uaDataValues[6]);
+                    operationLimits_.maxMonitoredItemsPerCall = operationLimit(uaDataValues[7]);
+                    operationLimits_.maxNodesPerRegisterNodes = operationLimit(uaDataValues[8]);
+                }
+
+                logger_->debug("OperationLimits:");
+                logger_->debug(operationLimits_.toString());
+
                 // update the return status
                 if (serverArrayStatus.isBad())
                     ret = serverArrayStatus;
@@ -913,9 +1034,25 @@ namespace uaf
         // update the session state member
         sessionState_ = sessionState;
 
+        // the server may forget the registered nodes as soon as the connection has problems,
+        // so they must be registered again by the house keeping (we can't invoke a service
+        // from this SDK callback)
+        if (sessionState != uaf::sessionstates::Connected)
+        {
+            UaMutexLocker registeredNodesLocker(&registeredNodesMutex_);
+            registeredNodesValid_ = false;
+            registeredNodesEpoch_++;
+        }
+
         // if the session became connected, update the arrays
         if (sessionState == uaf::sessionstates::Connected)
-            updateArrays();
+        {
+            // the loaded addresses that depend on the namespace array can now be validated
+            if (updateArrays().isGood())
+                database_->addressCache.setNamespaceArray(serverUri_, namespaceArray_);
+
+            modelChangeMonitor_->setNamespaceArray(namespaceArray_);
+        }
         // if the session has difficulties, we remove all references to this serverUri from
         // the address resolution cache (because maybe the node resolution is not valid anymore)
         else if (   (sessionState == uaf::sessionstates::ConnectionErrorApiReconnect)
@@ -929,6 +1066,208 @@ namespace uaf
     }
 
 
+    // Start or stop monitoring the model changes
+    // =============================================================================================
+    Status Session::monitorModelChangesIfNeeded()
+    {
+        Status ret = statuscodes::Good;
+
+        if (!database_->clientSettings.addressCacheMonitorModelChanges)
+        {
+            if (modelChangeMonitor_->isStarted())
+                ret = modelChangeMonitor_->stop();
+        }
+        else if (isConnected() && !modelChangeMonitor_->isStarted())
+        {
+            // copy the arrays, since they may be updated concurrently by setSessionState()
+            string          serverUri;
+            NamespaceArray  namespaceArray;
+            {
+                UaMutexLocker locker(&sessionMutex_); // unlocks when locker goes out of scope
+                serverUri      = serverUri_;
+                namespaceArray = namespaceArray_;
+            }
+
+            ret = modelChangeMonitor_->start(serverUri, namespaceArray);
+        }
+
+        return ret;
+    }
+
+
+    // Register the registered nodes again if needed
+    // =============================================================================================
+    Status Session::registerNodesIfNeeded()
+    {
+        Status ret = statuscodes::Good;
+
+        if (!isConnected())
+            return ret;
+
+        vector<NodeId> nodeIds;
+        uint32_t epoch;
+        {
+            UaMutexLocker locker(&registeredNodesMutex_); // unlocks when locker goes out of scope
+            if (registeredNodesValid_)
+                return ret;
+
+            if (registeredNodes_.isEmpty())
+            {
+                registeredNodesValid_ = true;
+                return ret;
+            }
+
+            nodeIds = registeredNodes_.nodeIds();
+            epoch   = registeredNodesEpoch_;
+        }
+
+        logger_->debug("Registering %d nodes again", nodeIds.size());
+
+        // copy the namespace array and the operation limits, since they may be updated
+        // concurrently by setSessionState()
+        NamespaceArray namespaceArray;
+        uint32_t maxNodesPerRegisterNodes;
+        {
+            UaMutexLocker locker(&sessionMutex_); // unlocks when locker goes out of scope
+            namespaceArray = namespaceArray_;
+            maxNodesPerRegisterNodes = operationLimits_.maxNodesPerRegisterNodes;
+        }
+
+        // register the nodes in chunks, so the operation limit of the server is respected
+        // (a limit of 0 means that there is no limit)
+        size_t chunkSize = nodeIds.size();
+        if (maxNodesPerRegisterNodes > 0 && maxNodesPerRegisterNodes < chunkSize)
+            chunkSize = maxNodesPerRegisterNodes;
+
+        UaClientSdk::ServiceSettings uaServiceSettings;
+        ret = database_->clientSettings.defaultRegisterNodesSettings.toSdk(uaServiceSettings);
+
+        // the aliases of the chunks that have been registered so far
+        vector<NodeId> registeredNodeIds;
+        registeredNodeIds.reserve(nodeIds.size());
+
+        for (size_t offset = 0; offset < nodeIds.size() && ret.isGood(); offset += chunkSize)
+        {
+            size_t noOfNodes = nodeIds.size() - offset;
+            if (noOfNodes > chunkSize)
+                noOfNodes = chunkSize;
+
+            UaNodeIdArray uaNodesToRegister;
+            UaNodeIdArray uaRegisteredNodeIds;
+            uaNodesToRegister.create(noOfNodes);
+
+            for (size_t i = 0; i < noOfNodes && ret.isGood(); i++)
+                ret = namespaceArray.fillOpcUaNodeId(nodeIds[offset + i], uaNodesToRegister[i]);
+
+            if (ret.isGood())
+            {
+                UaStatus sdkStatus = uaSession_->registerNodes(
+                        uaServiceSettings,
+                        uaNodesToRegister,
+                        uaRegisteredNodeIds);
+
+                if (!sdkStatus.isGood())
+                    ret = RegisterNodesInvocationError(sdkStatus);
+                else if (uaRegisteredNodeIds.length() != noOfNodes)
+                    ret = UnexpectedError("Number of results does not match number of targets");
+            }
+
+            for (size_t i = 0; i < noOfNodes && ret.isGood(); i++)
+            {
+                NodeId registeredNodeId;
+                registeredNodeId.fromSdk(uaRegisteredNodeIds[i]);
+                registeredNodeIds.push_back(registeredNodeId);
+            }
+        }
+
+        // the aliases that the server doesn't need to remember
+        vector<NodeId> obsoleteNodeIds;
+
+        {
+            UaMutexLocker locker(&registeredNodesMutex_); // unlocks when locker goes out of scope
+
+            if (ret.isGood() && epoch == registeredNodesEpoch_)
+            {
+                // nodes may have been unregistered meanwhile, they must not come back
+                for (size_t i = 0; i < registeredNodeIds.size(); i++)
+                {
+                    if (registeredNodes_.contains(nodeIds[i]))
+                        registeredNodes_.add(nodeIds[i], registeredNodeIds[i]);
+                    else
+                        obsoleteNodeIds.push_back(registeredNodeIds[i]);
+                }
+
+                registeredNodesValid_ = true;
+            }
+            else
+            {
+                // if a chunk failed, all nodes will be registered again during the next pass,
+                // and if the connection was lost meanwhile, the aliases may be invalid
+                obsoleteNodeIds = registeredNodeIds;
+
+                if (ret.isGood())
+                    ret = ConnectionFailedError(); // the session was reconnected meanwhile
+            }
+        }
+
+        if (!obsoleteNodeIds.empty())
+            unregisterAliases(obsoleteNodeIds, namespaceArray, chunkSize);
+
+        if (ret.isNotGood())
+        {
+            logger_->error("The nodes could not be registered again:");
+            logger_->error(ret.toString());
+        }
+
+        return ret;
+    }
+
+
+    // Unregister aliases that were registered by registerNodesIfNeeded()
+    // =============================================================================================
+    void Session::unregisterAliases(
+            const vector<NodeId>&   registeredNodeIds,
+            const NamespaceArray&   namespaceArray,
+            size_t                  chunkSize)
+    {
+        logger_->debug("Unregistering %d obsolete aliases", registeredNodeIds.size());
+
+        UaClientSdk::ServiceSettings uaServiceSettings;
+        Status ret = database_->clientSettings.defaultUnregisterNodesSettings.toSdk(
+                uaServiceSettings);
+
+        for (size_t offset = 0; offset < registeredNodeIds.size() && ret.isGood();
+             offset += chunkSize)
+        {
+            size_t noOfNodes = registeredNodeIds.size() - offset;
+            if (noOfNodes > chunkSize)
+                noOfNodes = chunkSize;
+
+            UaNodeIdArray uaNodesToUnregister;
+            uaNodesToUnregister.create(noOfNodes);
+
+            for (size_t i = 0; i < noOfNodes && ret.isGood(); i++)
+                ret = namespaceArray.fillOpcUaNodeId(
+                        registeredNodeIds[offset + i], uaNodesToUnregister[i]);
+
+            if (ret.isGood())
+            {
+                UaStatus sdkStatus = uaSession_->unregisterNodes(
+                        uaServiceSettings,
+                        uaNodesToUnregister);
+
+                if (!sdkStatus.isGood())
+                    ret = UnregisterNodesInvocationError(sdkStatus);
+            }
+        }
+
+        // not fatal: the server forgets them anyway when the session is closed
+        if (ret.isNotGood())
+            logger_->debug("The obsolete aliases could not be unregistered: %s",
+                           ret.toString().c_str());
+    }
+
+
     // Set the connection status.
     // =============================================================================================
     void Session::setConnectionStatus(
@@ -996,44 +1335,4 @@ namespace uaf
         return ret;
     }
 
-
-    // Set the publishing mode.
-    // =============================================================================================
-    Status Session::checkOrCreatePath(
-            bool checkOnly, const string& path, const string& description) const
-    {
-        Status ret;
-
-        logger_->debug("Checking %s: %s", description.c_str(), path.c_str());
-        UaDir helperDir(UaUniString(""));
-        if (helperDir.exists(UaUniString(path.c_str())))
-        {
-            ret = statuscodes::Good;
-            logger_->debug("OK, the %s exists", description.c_str());
-        }
-        else
-        {
-            if (checkOnly)
-            {
-                ret = PathNotExistsError(path, description);
-                logger_->error(ret.toString());
-            }
-            else
-            {
-                logger_->debug("The path does not exist so we try to create it");
-                if (helperDir.mkpath(UaUniString(path.c_str())))
-                {
-                    ret = statuscodes::Good;
-                    logger_->debug("The %s has been created", path.c_str());
-                }
-                else
-                {
-                    ret = PathCreationError(path, description);
-                    logger_->error(ret.toString());
-                }
-            }
-        }
-
-        return ret;
-    }
 }
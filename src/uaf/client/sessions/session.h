@@ -44,6 +44,10 @@
 #include "uaf/client/clientexport.h"
 #include "uaf/client/sessions/sessionstates.h"
 #include "uaf/client/sessions/sessioninformation.h"
+#include "uaf/client/sessions/operationlimits.h"
+#include "uaf/client/sessions/registerednodes.h"
+#include "uaf/client/sessions/pkistore.h"
+#include "uaf/client/sessions/modelchangemonitor.h"
 #include "uaf/client/settings/sessionsettings.h"
 #include "uaf/client/subscriptions/subscriptionfactory.h"
 #include "uaf/client/discovery/discoverer.h"
@@ -78,6 +82,7 @@ namespace uaf
          * @param clientInterface    Client interface to call when asynchronous
          *                           communication is received.
          * @param discoverer         The discoverer of the client.
+         * @param pkiStore           The PKI store that is shared by all sessions of the client.
          * @param database           Pointer to the client database.
          */
         Session(
@@ -88,6 +93,7 @@ namespace uaf
                 UaClientSdk::UaSessionCallback* uaSessionCallback,
                 uaf::ClientInterface*          clientInterface,
                 uaf::Discoverer*               discoverer,
+                uaf::PkiStore*                 pkiStore,
                 uaf::Database*                 database);
 
 
@@ -111,6 +117,26 @@ namespace uaf
         uaf::Status connect();
 
 
+        /**
+         * Connect the session, unless a connection attempt has been made already.
+         *
+         * If another thread is busy connecting this session, the call waits until that attempt
+         * has finished. Only the callers of this particular session are queued this way, the
+         * connection attempts of other sessions are not affected.
+         *
+         * @return  The result of the connection attempt, or Good if the session had been
+         *          connected (or tried to be connected) before.
+         */
+        uaf::Status connectIfNotAttemptedYet();
+
+
+        /**
+         * Forget that a connection attempt has been made, so that the next call of
+         * connectIfNotAttemptedYet() tries to connect the session again.
+         */
+        void resetConnectionAttempt();
+
+
         /**
          * Connect the session to a specific endpoint.
          */
@@ -284,6 +310,41 @@ namespace uaf
 
 
 
+
+        /**
+         * Start (or stop) monitoring the model changes of the server, depending on the
+         * addressCacheMonitorModelChanges setting of the client.
+         *
+         * The model changes can only be monitored while the session is connected. This method
+         * creates a subscription, so it must not be called from an SDK callback. It is called
+         * right after every successful connection attempt (so that no addresses are cached
+         * while the model changes aren't monitored yet), and periodically by the house keeping
+         * (e.g. after the SDK has reconnected the session).
+         *
+         * @return  Good if the model changes are monitored as configured (or if the session
+         *          isn't connected), bad if not.
+         */
+        uaf::Status monitorModelChangesIfNeeded();
+
+
+        /**
+         * Register the registered nodes again, if the session was reconnected since they were
+         * registered (since the server may have forgotten them, e.g. if a new session had to be
+         * created).
+         *
+         * Until they are registered again, services use the original NodeIds instead of their
+         * aliases. The nodes are registered in chunks, according to the operation limits of the
+         * server. The aliases are only kept if all chunks succeeded and the session wasn't
+         * reconnected meanwhile (otherwise they are unregistered again, and the nodes are
+         * registered again during the next call). This method invokes a service, so it must not
+         * be called from an SDK callback.
+         *
+         * @return  Good if the registered nodes are valid (or if the session isn't connected),
+         *          bad if not.
+         */
+        uaf::Status registerNodesIfNeeded();
+
+
         ///@} //////////////////////////////////////////////////////////////////////////////////////
         /**
          *  @name ServiceInvocations
@@ -304,7 +365,26 @@ namespace uaf
                                                _Service::asynchronous>& request,
                 typename _Service::Invocation& invocation)
         {
-            return invocation.invoke(uaSession_, namespaceArray_, serverArray_, logger_);
+            invocation.setOperationLimits(operationLimits_);
+            invocation.setMaxChunksInFlight(sessionSettings_.maxChunksInFlight);
+
+            // the invocation gets a snapshot of the registered nodes (which is not a copy, so
+            // it's cheap), and keeps using it even if the nodes are (un)registered meanwhile
+            {
+                UaMutexLocker locker(&registeredNodesMutex_); // unlocks when out of scope
+                if (registeredNodesValid_ && !registeredNodes_.isEmpty())
+                    invocation.setRegisteredNodes(registeredNodes_);
+            }
+
+            uaf::Status ret = invocation.invoke(uaSession_, namespaceArray_, serverArray_, logger_);
+
+            if (ret.isGood())
+            {
+                UaMutexLocker locker(&registeredNodesMutex_); // unlocks when out of scope
+                invocation.updateRegisteredNodes(registeredNodes_);
+            }
+
+            return ret;
         }
 
 
@@ -322,6 +402,7 @@ namespace uaf
                                                     _Service::asynchronous>& request,
                 typename _Service::Invocation& invocation)
         {
+            invocation.setOperationLimits(operationLimits_);
             return subscriptionFactory_->invokeService<_Service>(
                     invocation,
                     request,
@@ -374,13 +455,68 @@ namespace uaf
 
 
         /**
-         * Update the ServerArray and NamespaceArray (not locked!).
+         * Discover the server and connect the session (the connection mutex must be locked!).
+         */
+        uaf::Status establishConnection();
+
+
+        /**
+         * Get the endpoints of the given discovery URLs (possibly from the endpoint cache).
+         *
+         * @param discoveryUrls The discovery URLs of the server.
+         * @param endpoints     Output parameter: the endpoints of the server.
+         * @param fromCache     Output parameter: true if any of the endpoints were cached.
+         * @return              Good if endpoints were found, bad if not.
+         */
+        uaf::Status getEndpoints(
+                const std::vector<std::string>&         discoveryUrls,
+                std::vector<uaf::EndpointDescription>&  endpoints,
+                bool&                                   fromCache);
+
+
+        /**
+         * Remove the cached endpoints of the given discovery URLs.
+         */
+        void invalidateEndpoints(const std::vector<std::string>& discoveryUrls);
+
+
+        /**
+         * Check if the server rejected a connection because of a security mismatch.
+         */
+        static bool isSecurityMismatch(const uaf::SdkStatus& sdkStatus);
+
+
+        /**
+         * Update the ServerArray, NamespaceArray and OperationLimits (not locked!).
          *
          * @return  Good if the arrays could be fetched, false if not.
          */
         uaf::Status updateArrays();
 
 
+        /**
+         * Get an operation limit from the data value that was read from the server.
+         *
+         * @param dataValue The data value of an OperationLimits variable.
+         * @return          The limit, or 0 if the server didn't provide it.
+         */
+        static uint32_t operationLimit(const OpcUa_DataValue& dataValue);
+
+
+        /**
+         * Unregister aliases that registerNodesIfNeeded() has registered but could not keep
+         * (best effort, failures are only logged).
+         *
+         * @param registeredNodeIds The aliases to unregister (with a namespace index).
+         * @param namespaceArray    The namespace array of the server.
+         * @param chunkSize         The maximum number of aliases per service call.
+         */
+        void unregisterAliases(
+                const std::vector<uaf::NodeId>& registeredNodeIds,
+                const uaf::NamespaceArray&      namespaceArray,
+                std::size_t                     chunkSize);
+
+
         /**
          * Update the connection info.
          */
@@ -391,17 +527,12 @@ namespace uaf
 
 
         /**
-         * Initialize the PKI store
+         * Get the PKI provider (and, if the session must sign or encrypt the data, the client
+         * certificate) from the shared PKI store.
          */
         uaf::Status initializePkiStore(UaClientSdk::SessionSecurityInfo& uaSecurity);
 
 
-        /**
-         * Load the client certificate from the file specified in the ClientSettings.
-         */
-        uaf::Status loadClientCertificate(UaClientSdk::SessionSecurityInfo& uaSecurity);
-
-
         /**
          * Verify the server certificate.
          */
@@ -424,14 +555,6 @@ namespace uaf
                 UaClientSdk::SessionSecurityInfo& uaSecurity,
                 const uaf::SessionSecuritySettings& securitySettings);
 
-        /**
-         * Helper function to check if a path exists, or create the path if needed.
-         */
-        uaf::Status checkOrCreatePath(
-                bool checkOnly,
-                const std::string& path,
-                const std::string& description) const;
-
 
         // Wrapped SDK session instance and callback instance
         UaClientSdk::UaSession*             uaSession_;
@@ -441,12 +564,26 @@ namespace uaf
         uaf::ServerArray                    serverArray_;
         uaf::NamespaceArray                 namespaceArray_;
 
+        // the operation limits of the server (read together with the arrays)
+        uaf::OperationLimits                operationLimits_;
+
+        // the nodes that were registered within this session, and their aliases
+        uaf::RegisteredNodes                registeredNodes_;
+        // false if the session was reconnected since the nodes were registered
+        bool                                registeredNodesValid_;
+        // incremented every time the registered nodes become invalid
+        uint32_t                            registeredNodesEpoch_;
+        // mutex to safely manipulate the registered nodes
+        UaMutex                             registeredNodesMutex_;
+
         // the current session state:
         uaf::sessionstates::SessionState   sessionState_;
 
         // the last connection attempt information:
         uaf::connectionsteps::ConnectionStep lastConnectionAttemptStep_;
         uaf::Status                          lastConnectionAttemptStatus_;
+        // true as soon as the session has tried to connect
+        bool                                 connectionAttempted_;
 
         // fixed session properties:
         uaf::ClientConnectionId             clientConnectionId_;
@@ -464,10 +601,16 @@ namespace uaf
         UaClientSdk::SessionConnectInfo     uaSessionConnectInfoNoInitialRetry_;
         // mutex for critical sections
         UaMutex                             sessionMutex_;
+        // mutex to serialize the connection attempts of this session
+        UaMutex                             connectionMutex_;
         // the RequesterInterface to call when asynchronous messages are received
         uaf::ClientInterface*              clientInterface_;
         // the Discoverer to use
         uaf::Discoverer*                   discoverer_;
+        // the PKI store shared by all sessions
+        uaf::PkiStore*                     pkiStore_;
+        // the monitor that keeps the address cache correct when the server model changes
+        uaf::ModelChangeMonitor*           modelChangeMonitor_;
 
 
     };
@@ -25,6 +25,7 @@ namespace uaf
     using namespace uaf;
     using std::string;
     using std::vector;
+    using std::size_t;
     using std::map;
 
 
@@ -37,12 +38,23 @@ namespace uaf
             Database* database)
     : clientInterface_(clientInterface),
       discoverer_(discoverer),
-      database_(database)
+      database_(database),
+      readResultAssembler_(loggerFactory, "ReadResultAssembler"),
+      writeResultAssembler_(loggerFactory, "WriteResultAssembler"),
+      methodCallResultAssembler_(loggerFactory, "MethodCallResultAssembler")
     {
         logger_ = new Logger(loggerFactory, "SessionFactory");
 
+        invocationPool_ = new InvocationPool(loggerFactory);
+
+        chunkPipeline_ = new ChunkPipeline(loggerFactory, this);
+
+        pkiStore_ = new PkiStore(loggerFactory, database);
+
         transactionId_ = 0;
 
+        discoverer_->addListener(this);
+
         logger_->debug("The SessionFactory has been constructed");
     }
 
@@ -53,8 +65,19 @@ namespace uaf
     {
         logger_->debug("Destructing the SessionFactory");
 
+        discoverer_->removeListener(this);
+
         deleteAllSessions();
 
+        delete invocationPool_;
+        invocationPool_ = 0;
+
+        delete chunkPipeline_;
+        chunkPipeline_ = 0;
+
+        delete pkiStore_;
+        pkiStore_ = 0;
+
         delete logger_;
         logger_ = 0;
 
@@ -67,28 +90,39 @@ namespace uaf
     {
         logger_->debug("Deleting all sessions and their subscriptions and monitored items");
 
-        // lock the mutex to make sure the sessionMap is not being manipulated
-        UaMutexLocker sessionMapLocker(&sessionMapMutex_);
+        vector<Session*> sessions;
 
-        // also lock the mutex to make sure the activity cannot change anymore
-        UaMutexLocker activityMapLocker(&activityMapMutex_);
+        {
+            // lock the mutex to make sure the sessionMap is not being manipulated
+            UaMutexLocker sessionMapLocker(&sessionMapMutex_);
+
+            // also lock the mutex to make sure the activity cannot change anymore
+            UaMutexLocker activityMapLocker(&activityMapMutex_);
 
-        SessionMap::iterator iter;
-        for (iter = sessionMap_.begin(); iter != sessionMap_.end() ; ++iter)
+            SessionMap::iterator iter;
+            for (iter = sessionMap_.begin(); iter != sessionMap_.end() ; ++iter)
+                sessions.push_back(iter->second);
+
+            sessionMap_.clear();
+            activityMap_.clear();
+            sessionIndex_.clear();
+            sessionKeys_.clear();
+            unindexedSessions_.clear();
+        }
+
+        // delete the sessions without locking the maps, since they may disconnect from the server
+        for (vector<Session*>::iterator iter = sessions.begin(); iter != sessions.end(); ++iter)
         {
             logger_->debug("Now deleting session %d - %s",
-                            iter->second->clientConnectionId(),
-                            iter->second->serverUri().c_str());
+                            (*iter)->clientConnectionId(),
+                            (*iter)->serverUri().c_str());
 
-            delete iter->second;
-            iter->second = 0;
+            delete *iter;
+            *iter = 0;
 
             logger_->debug("The session has been deleted");
         }
 
-        sessionMap_.clear();
-        activityMap_.clear();
-
         logger_->debug("All sessions have been deleted");
     }
 
@@ -126,6 +160,10 @@ namespace uaf
 
         if (ret.isGood())
         {
+            // connect the session (regardless of whether the connection succeeds or fails, the
+            // session is created, so we don't change the return status)
+            session->connectIfNotAttemptedYet();
+
             clientConnectionId = session->clientConnectionId();
 
             Activity activity;
@@ -174,27 +212,40 @@ namespace uaf
             settings = *settingsPtr;
         }
 
-        // lock the mutex to make sure the sessionMap_ is not being manipulated
-        UaMutexLocker locker(&sessionMapMutex_);
+        Session* session = 0;
+
+        {
+            // lock the mutex to make sure the sessionMap_ is not being manipulated
+            UaMutexLocker locker(&sessionMapMutex_);
+
+            clientConnectionId = database_->createUniqueClientConnectionId();
+            logger_->debug("ClientConnectionId %d was assigned to the session", clientConnectionId);
 
-        clientConnectionId = database_->createUniqueClientConnectionId();
-        logger_->debug("ClientConnectionId %d was assigned to the session", clientConnectionId);
+            // create a new session instance
+            session = new Session(
+                    logger_->loggerFactory(),
+                    settings,
+                    string(), // empty string as we don't know the serverUri at this point yet!
+                    clientConnectionId,
+                    this,
+                    clientInterface_,
+                    discoverer_,
+                    pkiStore_,
+                    database_);
 
-        // create a new session instance
-        Session* session = new Session(
-                logger_->loggerFactory(),
-                settings,
-                string(), // empty string as we don't know the serverUri at this point yet!
-                clientConnectionId,
-                this,
-                clientInterface_,
-                discoverer_,
-                database_);
+            // store the new session instance in the sessionMap (and index it, so that it can be
+            // shared as soon as its server URI is known)
+            sessionMap_[clientConnectionId] = session;
+            indexSession(session, settingsRegistry_.intern(settings));
 
-        // store the new session instance in the sessionMap
-        sessionMap_[clientConnectionId] = session;
+            // create an activity count for the session
+            activityMapMutex_.lock();
+            activityMap_[clientConnectionId] = 1;
+            activityMapMutex_.unlock();
+        }
 
-        // connect to the session to the specific endpoint
+        // connect to the session to the specific endpoint (without locking the sessionMap_,
+        // so that other sessions can be used in the meantime)
         if (serverCertificatePtr != NULL)
             ret = session->connectToSpecificEndpoint(endpointUrl, *serverCertificatePtr);
         else
@@ -203,19 +254,14 @@ namespace uaf
         // add some diagnostics
         if (ret.isGood())
         {
-            // create an activity count for the session
-            activityMapMutex_.lock();
-            activityMap_[clientConnectionId] = 1;
-            logger_->debug("The requested session is created (#activities: %d)",
-                           activityMap_[clientConnectionId]);
-            activityMapMutex_.unlock();
+            logger_->debug("The requested session is created");
         }
         else
         {
-            delete session;
-            session = 0;
-            sessionMap_.erase(clientConnectionId);
             logger_->error("The requested session could not be created");
+
+            // release the disconnected session, so that it gets deleted
+            releaseSession(session);
         }
 
         return ret;
@@ -283,6 +329,17 @@ namespace uaf
                     if (tryToReconnect)
                         session->connect();
                 }
+
+                // subscribe to the model changes if needed (this is done right after a
+                // successful connection attempt, but not when the SDK reconnects the session,
+                // since this can't be done by the SDK callback that tells us that the session
+                // is connected)
+                session->monitorModelChangesIfNeeded();
+
+                // register the registered nodes again if the session was reconnected (for
+                // the same reason)
+                session->registerNodesIfNeeded();
+
                 releaseSession(session);
             }
         }
@@ -466,24 +523,30 @@ namespace uaf
     {
         Status ret;
 
-        // lock the mutex to make sure the sessionMap_ is not being manipulated
-        UaMutexLocker locker(&sessionMapMutex_);
+        // acquire the sessions, so that the service can be invoked without locking the
+        // sessionMap_
+        vector<Session*> sessions;
+        acquireAllSessions(sessions);
 
         bool subscriptionFound = false;
 
         // loop trough the sessions
-        for (SessionMap::const_iterator it = sessionMap_.begin(); it != sessionMap_.end(); ++it)
+        for (vector<Session*>::const_iterator it = sessions.begin();
+                it != sessions.end() && (!subscriptionFound);
+                ++it)
         {
-            ret = it->second->setPublishingMode(clientSubscriptionHandle,
-                                                publishingEnabled,
-                                                serviceSettings,
-                                                subscriptionFound);
-
-            if (subscriptionFound)
-                return ret;
+            ret = (*it)->setPublishingMode(clientSubscriptionHandle,
+                                           publishingEnabled,
+                                           serviceSettings,
+                                           subscriptionFound);
         }
 
-        return UnknownClientSubscriptionHandleError(clientSubscriptionHandle);
+        releaseSessions(sessions);
+
+        if (subscriptionFound)
+            return ret;
+        else
+            return UnknownClientSubscriptionHandleError(clientSubscriptionHandle);
     }
 
 
@@ -506,17 +569,21 @@ namespace uaf
         for (std::size_t i = 0; i < clientHandles.size(); i++)
             results[i] = UnknownClientHandleError(clientHandles[i]);
 
-        // lock the mutex to make sure the sessionMap_ is not being manipulated
-        UaMutexLocker locker(&sessionMapMutex_);
+        // acquire the sessions, so that the service can be invoked without locking the
+        // sessionMap_
+        vector<Session*> sessions;
+        acquireAllSessions(sessions);
 
         // loop trough the sessions and let SetMonitoringMode be called (if needed!) on each of them
-        for (SessionMap::const_iterator it = sessionMap_.begin();
-                it != sessionMap_.end() && ret.isNotBad();
+        for (vector<Session*>::const_iterator it = sessions.begin();
+                it != sessions.end() && ret.isNotBad();
                 ++it)
         {
-            ret = it->second->setMonitoringModeIfNeeded(clientHandles, monitoringMode, serviceSettings, results);
+            ret = (*it)->setMonitoringModeIfNeeded(clientHandles, monitoringMode, serviceSettings, results);
         }
 
+        releaseSessions(sessions);
+
         return ret;
     }
 
@@ -529,17 +596,20 @@ namespace uaf
     {
         Status ret;
 
-        // lock the mutex to make sure the sessionMap_ is not being manipulated
-        UaMutexLocker locker(&sessionMapMutex_);
+        // acquire the sessions, since the SDK may need to read the definition from the server
+        vector<Session*> sessions;
+        acquireAllSessions(sessions);
 
         // loop trough the sessions and let structureDefinition be called (if needed!) on each of them
-        for (SessionMap::const_iterator it = sessionMap_.begin();
-                it != sessionMap_.end() && ret.isNotGood();
+        for (vector<Session*>::const_iterator it = sessions.begin();
+                it != sessions.end() && ret.isNotGood();
                 ++it)
         {
-            ret = it->second->structureDefinition(dataTypeId, definition);
+            ret = (*it)->structureDefinition(dataTypeId, definition);
         }
 
+        releaseSessions(sessions);
+
         return ret;
     }
 
@@ -550,7 +620,8 @@ namespace uaf
     Status SessionFactory::acquireSession(
             const string&           serverUri,
             const SessionSettings&  sessionSettings,
-            Session*&               session)
+            Session*&               session,
+            Lane                    lane)
     {
         logger_->debug("Acquiring Session to %s with the following settings:", serverUri.c_str());
         logger_->debug(sessionSettings.toString());
@@ -559,6 +630,18 @@ namespace uaf
 
         session = 0;
 
+        // get the fingerprint of the settings, so that we don't need to compare them in full
+        SessionSettingsFingerprint fingerprint = settingsRegistry_.intern(sessionSettings);
+
+        // long-running services only get a dedicated session if the settings ask for it
+        bool longRunning = (lane == LongRunningLane)
+                        && sessionSettings.separateLongRunningServices;
+
+        // only the pooled lane may use more than one session
+        size_t poolSize = 1;
+        if (lane == PooledLane && sessionSettings.sessionPoolSize > 1)
+            poolSize = sessionSettings.sessionPoolSize;
+
         // lock the mutex to make sure the sessionMap_ is not being manipulated
         UaMutexLocker locker(&sessionMapMutex_);
 
@@ -569,29 +652,24 @@ namespace uaf
         }
         else
         {
-            // loop trough the sessions ...
-            for (SessionMap::const_iterator it = sessionMap_.begin(); it != sessionMap_.end(); ++it)
-            {
-                // ... until a suitable one is found
-                if (    it->second->serverUri() == serverUri
-                    &&  it->second->sessionSettings() == sessionSettings )
-                {
-                    session = it->second;
-                    logger_->debug("A suitable session (ClientConnectionId=%d) already exists",
-                                   session->clientConnectionId());
+            session = findIndexedSession(SessionKey(serverUri, fingerprint, longRunning),
+                                         lane == PrimaryLane,
+                                         poolSize);
 
-                    // get the ClientConnectionId of the session
-                    ClientConnectionId id = session->clientConnectionId();
+            if (session != 0)
+            {
+                logger_->debug("A suitable session (ClientConnectionId=%d) already exists",
+                               session->clientConnectionId());
 
-                    // increment the activity count of the session
-                    activityMapMutex_.lock();
-                    activityMap_[id] = activityMap_[id] + 1;
-                    activityMapMutex_.unlock();
+                // get the ClientConnectionId of the session
+                ClientConnectionId id = session->clientConnectionId();
 
-                    ret = statuscodes::Good;
+                // increment the activity count of the session
+                activityMapMutex_.lock();
+                activityMap_[id] = activityMap_[id] + 1;
+                activityMapMutex_.unlock();
 
-                    break;
-                }
+                ret = statuscodes::Good;
             }
         }
 
@@ -614,21 +692,21 @@ namespace uaf
                     this,
                     clientInterface_,
                     discoverer_,
+                    pkiStore_,
                     database_);
 
-            // store the new session instance in the sessionMap
+            // store the new session instance in the sessionMap, and index it
             sessionMap_[clientConnectionId] = session;
+            indexSession(session, fingerprint, longRunning);
 
             // create an activity count for the session
             activityMapMutex_.lock();
             activityMap_[clientConnectionId] = 1;
             activityMapMutex_.unlock();
 
-            // connect to the session
-            session->connect();
-
-            // regardless of whether the connection succeeded or failed, set the return status
-            // to 'good'
+            // don't connect the session here: the sessionMap_ must never be locked during
+            // network I/O, so the session is connected by the first user of it
+            // (see Session::connectIfNotAttemptedYet)
             ret = statuscodes::Good;
         }
 
@@ -650,6 +728,119 @@ namespace uaf
     }
 
 
+    // Index a session
+    // =============================================================================================
+    void SessionFactory::indexSession(
+            Session*                    session,
+            SessionSettingsFingerprint  fingerprint,
+            bool                        longRunning)
+    {
+        ClientConnectionId id = session->clientConnectionId();
+        string serverUri = session->serverUri();
+
+        if (session->sessionSettings().unique)
+        {
+            logger_->debug("Session %d is unique, so it is not indexed", id);
+        }
+        else if (serverUri.length() == 0)
+        {
+            logger_->debug("Session %d will be indexed when its serverUri is known", id);
+            unindexedSessions_[id] = longRunning;
+        }
+        else
+        {
+            SessionKey key(serverUri, fingerprint, longRunning);
+            SessionPool& pool = sessionIndex_[key];
+            pool.push_back(id);
+            sessionKeys_.insert(SessionKeyMap::value_type(id, key));
+            logger_->debug("Session %d has been indexed (fingerprint %d, pool size %d)",
+                           id, fingerprint, pool.size());
+        }
+    }
+
+
+    // Remove a session from the index
+    // =============================================================================================
+    void SessionFactory::unindexSession(ClientConnectionId clientConnectionId)
+    {
+        unindexedSessions_.erase(clientConnectionId);
+
+        SessionKeyMap::iterator iter = sessionKeys_.find(clientConnectionId);
+        if (iter != sessionKeys_.end())
+        {
+            SessionIndex::iterator found = sessionIndex_.find(iter->second);
+            if (found != sessionIndex_.end())
+            {
+                SessionPool& pool = found->second;
+                pool.erase(std::remove(pool.begin(), pool.end(), clientConnectionId), pool.end());
+                if (pool.empty())
+                    sessionIndex_.erase(found);
+            }
+            sessionKeys_.erase(iter);
+        }
+    }
+
+
+    // Find an indexed session
+    // =============================================================================================
+    Session* SessionFactory::findIndexedSession(
+            const SessionKey&   key,
+            bool                primary,
+            size_t              poolSize)
+    {
+        // index the sessions that have learned their server URI in the meantime
+        // (in the same lane as they were created for)
+        map<ClientConnectionId, bool>::iterator iter = unindexedSessions_.begin();
+        while (iter != unindexedSessions_.end())
+        {
+            Session* session = sessionMap_[iter->first];
+            bool longRunning = iter->second;
+
+            if (session->serverUri().length() > 0)
+            {
+                unindexedSessions_.erase(iter++);
+                indexSession(session,
+                             settingsRegistry_.intern(session->sessionSettings()),
+                             longRunning);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+
+        SessionIndex::const_iterator found = sessionIndex_.find(key);
+
+        if (found == sessionIndex_.end() || found->second.empty())
+            return 0;
+
+        const SessionPool& pool = found->second;
+
+        if (primary)
+            return sessionMap_[pool[0]];
+
+        // find the session with the least ongoing activities
+        UaMutexLocker activityMapLocker(&activityMapMutex_);
+
+        ClientConnectionId leastBusy = pool[0];
+        for (SessionPool::const_iterator it = pool.begin(); it != pool.end(); ++it)
+        {
+            if (activityMap_[*it] < activityMap_[leastBusy])
+                leastBusy = *it;
+        }
+
+        // if all sessions are busy, we rather add a new session to the pool (if allowed)
+        if (activityMap_[leastBusy] > 0 && pool.size() < poolSize)
+        {
+            logger_->debug("All %d sessions of the pool are busy, so a new one will be added",
+                           pool.size());
+            return 0;
+        }
+
+        return sessionMap_[leastBusy];
+    }
+
+
     // Acquire an existing session, if one is available.
     // =============================================================================================
     Status SessionFactory::acquireExistingSession(
@@ -695,6 +886,39 @@ namespace uaf
     }
 
 
+    // Acquire all sessions
+    // =============================================================================================
+    void SessionFactory::acquireAllSessions(vector<Session*>& sessions)
+    {
+        sessions.clear();
+
+        // lock the mutex to make sure the sessionMap is not being manipulated
+        UaMutexLocker sessionMapLocker(&sessionMapMutex_);
+
+        // also lock the mutex to make sure the activity cannot change in the meantime
+        UaMutexLocker activityMapLocker(&activityMapMutex_);
+
+        for (SessionMap::const_iterator it = sessionMap_.begin(); it != sessionMap_.end(); ++it)
+        {
+            activityMap_[it->first] = activityMap_[it->first] + 1;
+            sessions.push_back(it->second);
+        }
+
+        logger_->debug("All %d sessions were acquired", sessions.size());
+    }
+
+
+    // Release a number of sessions
+    // =============================================================================================
+    void SessionFactory::releaseSessions(vector<Session*>& sessions)
+    {
+        for (vector<Session*>::iterator it = sessions.begin(); it != sessions.end(); ++it)
+            releaseSession(*it);
+
+        sessions.clear();
+    }
+
+
     // Release a session
     // =============================================================================================
     Status SessionFactory::releaseSession(Session*& session, bool allowGarbageCollection)
@@ -740,6 +964,7 @@ namespace uaf
                     session = 0;
                     activityMap_.erase(id);
                     sessionMap_.erase(id);
+                    unindexSession(id);
 
                     logger_->debug("The session has been deleted");
                 }
@@ -751,6 +976,94 @@ namespace uaf
 
 
 
+    // Store a new transaction id for the given request handle
+    // =============================================================================================
+    TransactionId SessionFactory::storeTransactionId(RequestHandle requestHandle)
+    {
+        UaMutexLocker locker(&transactionMapMutex_);
+        TransactionId transactionId = getNewTransactionId();
+        transactionMap_[transactionId] = requestHandle;
+        logger_->debug("A new transaction id %d was stored for request %d",
+                       transactionId, requestHandle);
+        return transactionId;
+    }
+
+
+    // Remove a transaction id
+    // =============================================================================================
+    void SessionFactory::removeTransactionId(TransactionId transactionId)
+    {
+        UaMutexLocker locker(&transactionMapMutex_);
+        transactionMap_.erase(transactionId);
+    }
+
+
+    // Announce the partial results of an asynchronous read request
+    // =============================================================================================
+    bool SessionFactory::expectAsyncResult(
+            const AsyncReadRequest&             request,
+            const vector<TransactionId>&        transactionIds,
+            const vector< vector<size_t> >&     ranks)
+    {
+        readResultAssembler_.expect(request.requestHandle(), transactionIds, ranks);
+        return true;
+    }
+
+
+    // Announce the partial results of an asynchronous write request
+    // =============================================================================================
+    bool SessionFactory::expectAsyncResult(
+            const AsyncWriteRequest&            request,
+            const vector<TransactionId>&        transactionIds,
+            const vector< vector<size_t> >&     ranks)
+    {
+        writeResultAssembler_.expect(request.requestHandle(), transactionIds, ranks);
+        return true;
+    }
+
+
+    // Announce the partial results of an asynchronous method call request
+    // =============================================================================================
+    bool SessionFactory::expectAsyncResult(
+            const AsyncMethodCallRequest&       request,
+            const vector<TransactionId>&        transactionIds,
+            const vector< vector<size_t> >&     ranks)
+    {
+        methodCallResultAssembler_.expect(request.requestHandle(), transactionIds, ranks);
+        return true;
+    }
+
+
+    // Cancel the assembly of an asynchronous read request
+    // =============================================================================================
+    void SessionFactory::cancelAsyncResult(
+            const AsyncReadRequest&       request,
+            const vector<TransactionId>&  startedTransactionIds)
+    {
+        readResultAssembler_.cancel(request.requestHandle(), startedTransactionIds);
+    }
+
+
+    // Cancel the assembly of an asynchronous write request
+    // =============================================================================================
+    void SessionFactory::cancelAsyncResult(
+            const AsyncWriteRequest&      request,
+            const vector<TransactionId>&  startedTransactionIds)
+    {
+        writeResultAssembler_.cancel(request.requestHandle(), startedTransactionIds);
+    }
+
+
+    // Cancel the assembly of an asynchronous method call request
+    // =============================================================================================
+    void SessionFactory::cancelAsyncResult(
+            const AsyncMethodCallRequest& request,
+            const vector<TransactionId>&  startedTransactionIds)
+    {
+        methodCallResultAssembler_.cancel(request.requestHandle(), startedTransactionIds);
+    }
+
+
     // Get a new transaction id
     // =============================================================================================
     uaf::TransactionId SessionFactory::getNewTransactionId()
@@ -818,6 +1131,30 @@ namespace uaf
         return false;
     }
 
+    // Discovery URLs changed
+    // =============================================================================================
+    void SessionFactory::discoveryUrlsChanged(
+            const string&           serverUri,
+            const vector<string>&   discoveryUrls)
+    {
+        vector<Session*> sessions;
+        acquireAllSessions(sessions);
+
+        for (vector<Session*>::const_iterator it = sessions.begin(); it != sessions.end(); ++it)
+        {
+            if ((*it)->serverUri() == serverUri && !(*it)->isConnected())
+            {
+                logger_->debug("Session %d to %s will reconnect via the %d new discovery URLs",
+                               (*it)->clientConnectionId(), serverUri.c_str(),
+                               discoveryUrls.size());
+                (*it)->resetConnectionAttempt();
+            }
+        }
+
+        releaseSessions(sessions);
+    }
+
+
     // implemented from the callback interface
     // =============================================================================================
     void SessionFactory::connectionStatusChanged(
@@ -924,8 +1261,9 @@ namespace uaf
             logger_->error("Unknown transaction id received, so we cannot cache the result");
         }
 
-        // call the callback interface
-        clientInterface_->callComplete(result);
+        // call the callback interface, once all partial results have been received
+        if (methodCallResultAssembler_.assemble(transactionId, result))
+            clientInterface_->callComplete(result);
     }
 
 
@@ -940,6 +1278,14 @@ namespace uaf
     {
         logger_->debug("Read complete: transactionId %d", transactionId);
 
+        // the responses to the chunks of pipelined synchronous invocations are not reported
+        // to the client, but handed over to the invocation that is waiting for them
+        if (chunkPipeline_->readComplete(transactionId, uaStatus, values))
+        {
+            removeTransactionId(transactionId);
+            return;
+        }
+
 
         // find the request handle for the given transaction id
         RequestHandle handle = 0;
@@ -982,31 +1328,27 @@ namespace uaf
             // set the data
             result.targets[i].data = Variant(values[i].Value);
         }
-        logger_->debug("ReadResult for request %d (transaction %d):", handle, transactionId);
-        logger_->debug(result.toString());
-
-//        // if the transaction id was found, put the result in the correct cache
-//        if (transactionIdFound)
-//        {
-//            logger_->debug("Transaction id %d corresponds to the asynchronous handle %d",
-//                           transactionId, handle);
-//
-//            // add the result to the database
-//            database_->asyncMethodCallResultCache.set(handle, result);
-//
-//            // remove the transaction id : request handle pair
-//            transactionMapMutex_.lock();      // lock the map
-//            transactionMap_.erase(transactionId);         // erase the key
-//            transactionMapMutex_.unlock();    // unlock the map
-//        }
-//        // if the transaction id was not found, we cannot store the result in the cache
-//        else
-//        {
-//            logger_->error("Unknown transaction id received, so we cannot cache the result");
-//        }
-
-        // call the callback interface
-        clientInterface_->readComplete(result);
+        if (logger_->isDebugEnabled())
+        {
+            logger_->debug("ReadResult for request %d (transaction %d):", handle, transactionId);
+            logger_->debug(result.toString());
+        }
+
+        // remove the transaction id : request handle pair
+        if (transactionIdFound)
+        {
+            transactionMapMutex_.lock();            // lock the map
+            transactionMap_.erase(transactionId);   // erase the key
+            transactionMapMutex_.unlock();          // unlock the map
+        }
+        else
+        {
+            logger_->error("Unknown transaction id %d received", transactionId);
+        }
+
+        // call the callback interface, once all partial results have been received
+        if (readResultAssembler_.assemble(transactionId, result))
+            clientInterface_->readComplete(result);
     }
 
 
@@ -1021,6 +1363,14 @@ namespace uaf
     {
         logger_->debug("Write complete: transactionId %d", transactionId);
 
+        // the responses to the chunks of pipelined synchronous invocations are not reported
+        // to the client, but handed over to the invocation that is waiting for them
+        if (chunkPipeline_->writeComplete(transactionId, uaStatus, results))
+        {
+            removeTransactionId(transactionId);
+            return;
+        }
+
 
         // find the request handle for the given transaction id
         RequestHandle handle = 0;
@@ -1058,31 +1408,27 @@ namespace uaf
 
             result.targets[i].opcUaStatusCode = results[i];
         }
-        logger_->debug("WriteResult for request %d (transaction %d):", handle, transactionId);
-        logger_->debug(result.toString());
-
-//        // if the transaction id was found, put the result in the correct cache
-//        if (transactionIdFound)
-//        {
-//            logger_->debug("Transaction id %d corresponds to the asynchronous handle %d",
-//                           transactionId, handle);
-//
-//            // add the result to the database
-//            database_->asyncMethodCallResultCache.set(handle, result);
-//
-//            // remove the transaction id : request handle pair
-//            transactionMapMutex_.lock();      // lock the map
-//            transactionMap_.erase(transactionId);         // erase the key
-//            transactionMapMutex_.unlock();    // unlock the map
-//        }
-//        // if the transaction id was not found, we cannot store the result in the cache
-//        else
-//        {
-//            logger_->error("Unknown transaction id received, so we cannot cache the result");
-//        }
-
-        // call the callback interface
-        clientInterface_->writeComplete(result);
+        if (logger_->isDebugEnabled())
+        {
+            logger_->debug("WriteResult for request %d (transaction %d):", handle, transactionId);
+            logger_->debug(result.toString());
+        }
+
+        // remove the transaction id : request handle pair
+        if (transactionIdFound)
+        {
+            transactionMapMutex_.lock();            // lock the map
+            transactionMap_.erase(transactionId);   // erase the key
+            transactionMapMutex_.unlock();          // unlock the map
+        }
+        else
+        {
+            logger_->error("Unknown transaction id %d received", transactionId);
+        }
+
+        // call the callback interface, once all partial results have been received
+        if (writeResultAssembler_.assemble(transactionId, result))
+            clientInterface_->writeComplete(result);
     }
 
 }
@@ -25,6 +25,9 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <map>
+#include <set>
 // SDK
 #include "uabase/uasemaphore.h"
 #include "uaclient/uaclientsdk.h"
@@ -33,6 +36,11 @@
 #include "uaf/client/clientexport.h"
 #include "uaf/client/database/database.h"
 #include "uaf/client/sessions/session.h"
+#include "uaf/client/sessions/invocationpool.h"
+#include "uaf/client/sessions/asyncresultassembler.h"
+#include "uaf/client/sessions/chunkpipeline.h"
+#include "uaf/client/sessions/pkistore.h"
+#include "uaf/client/sessions/sessionsettingsregistry.h"
 #include "uaf/client/discovery/discoverer.h"
 #include "uaf/client/clientinterface.h"
 #include "uaf/client/requests/requests.h"
@@ -49,7 +57,8 @@ namespace uaf
     *
     * @ingroup ClientSessions
     ***********************************************************************************************/
-    class UAF_EXPORT SessionFactory : private UaClientSdk::UaSessionCallback
+    class UAF_EXPORT SessionFactory : private UaClientSdk::UaSessionCallback,
+                                      private uaf::DiscoveryListener
     {
     public:
 
@@ -331,8 +340,11 @@ namespace uaf
                 const uaf::Mask&                   mask,
                 typename _Service::Result&         result)
         {
-            logger_->debug("Invoking %sRequest %d", _Service::name().c_str(), request.requestHandle());
-            logger_->debug("Mask is %s", mask.toString().c_str());
+            if (logger_->isDebugEnabled())
+            {
+                logger_->debug("Invoking %sRequest %d", _Service::name().c_str(), request.requestHandle());
+                logger_->debug("Mask is %s", mask.toString().c_str());
+            }
 
             // Invocation details
             typedef typename _Service::Invocation Invocation;
@@ -363,152 +375,169 @@ namespace uaf
             InvocationMap invocations;
 
             logger_->debug("Building the invocations");
-            for (std::size_t i = 0; i < request.targets.size() && ret.isGood(); i++)
+            if (request.clientConnectionIdGiven)
             {
-                if (mask.isSet(i))
+                logger_->debug("ClientConnectionId %d is given", request.clientConnectionId);
+
+                // we'll only have 0 or 1 invocations in this case
+                Session* session = NULL;
+                for (std::size_t i = 0; i < request.targets.size() && ret.isGood(); i++)
                 {
-                    if (request.clientConnectionIdGiven)
+                    if (mask.isSet(i))
                     {
-                        logger_->debug("ClientConnectionId %d is given", request.clientConnectionId);
-
-                        // we'll only have 0 or 1 invocations in this case
-                        if (invocations.size() == 0)
+                        if (session == NULL)
                         {
-                            Session* session;
                             ret = acquireExistingSession(request.clientConnectionId, session);
                             if (ret.isGood())
-                            {
-                                invocations[session] = new Invocation;
-                                invocations[session]->setAsynchronous(async);
-                                invocations[session]->setRequestHandle(requestHandle);
-                                invocations[session]->setServiceSettings(getServiceSettings<_Service>(request));
-                            }
+                                invocations[session] = newInvocation<_Service>(request);
                         }
 
-                        // check if we're indeed having just one invocation scheduled
-                        if (ret.isGood() && invocations.size() != 1)
-                            ret = UnexpectedError("Bug in SessionFactory::invokeRequest: #invocations != 1");
-
                         if (ret.isGood())
                         {
-                            for (typename InvocationMap::const_iterator it = invocations.begin(); it != invocations.end(); ++it)
-                            {
-                                logger_->debug("Adding target %d", i);
-                                it->second->addTarget(i, request.targets[i], result.targets[i]);
-                            }
+                            logger_->debug("Adding target %d", i);
+                            invocations[session]->addTarget(i, request.targets[i], result.targets[i]);
                         }
-
                     }
-                    else
-                    {
-                        logger_->debug("Trying to get the serverUri from the target");
+                }
+            }
+            else
+            {
+                // group the targets per server in a single pass, so that the session settings
+                // only need to be determined (and a session acquired) once per server
+                typedef std::map<std::string, std::vector<std::size_t> > ServerTargetsMap;
+                ServerTargetsMap serverTargets;
 
-                        // we first need to determine the server which hosts the target
+                logger_->debug("Trying to get the serverUris from the targets");
+                for (std::size_t i = 0; i < request.targets.size() && ret.isGood(); i++)
+                {
+                    if (mask.isSet(i))
+                    {
                         std::string serverUri;
                         if (getServerUriFromTarget(request.targets[i], serverUri).isGood())
-                        {
-                            logger_->debug("ServerUri was found: %s", serverUri.c_str());
-
-                            Session* session = NULL;
-                            uaf::SessionSettings sessionSettings = getSessionSettings<_Service>(request, serverUri);
-
-                            logger_->debug("Trying to find a scheduled session");
-
-                            // check if the session we need is already scheduled for an invocation
-                            for (typename InvocationMap::const_iterator it = invocations.begin();
-                                    it != invocations.end(); ++it)
-                            {
-                                if (   it->first->serverUri() == serverUri
-                                    && it->first->sessionSettings() == sessionSettings)
-                                {
-                                    logger_->debug("Found a scheduled session");
-                                    session = it->first;
-                                }
-                            }
-
-                            // if the session is not already scheduled, we acquire it first
-                            if (session == NULL)
-                            {
-                                logger_->debug("No session was scheduled, so we acquire one");
-
-                                ret = acquireSession(serverUri, sessionSettings, session);
-
-                                if (ret.isGood())
-                                {
-                                    logger_->debug("Scheduling an invocation for this session");
-                                    invocations[session] = new Invocation;
-                                    invocations[session]->setAsynchronous(async);
-                                    invocations[session]->setRequestHandle(requestHandle);
-                                    invocations[session]->setServiceSettings(getServiceSettings<_Service>(request));
-                                }
-                            }
-
-                            if (ret.isGood())
-                            {
-                                logger_->debug("Adding the target");
-                                invocations[session]->addTarget(i, request.targets[i], result.targets[i]);
-                            }
-                        }
+                            serverTargets[serverUri].push_back(i);
                         else
-                        {
                             ret = uaf::InvalidServerUriError(serverUri);
-                        }
                     }
                 }
-            }
 
-            logger_->debug("A total of %d invocations were built", invocations.size());
+                for (ServerTargetsMap::const_iterator it = serverTargets.begin();
+                     it != serverTargets.end() && ret.isGood();
+                     ++it)
+                {
+                    const std::string& serverUri = it->first;
+                    const std::vector<std::size_t>& ranks = it->second;
 
-            // the UAF currently does NOT support asynchronous communication to multiple sessions
-            // in one request (because the logic to reconstruct the result from multiple
-            // asynchronous invocations is not implemented). Synchronous communication DOES support
-            // this however. So we check here if, in case of an asynchronous request, we don't have
-            // more than one invocation.
-            if (ret.isGood() && async)
-            {
-                if (invocations.size() > 1)
-                    ret = uaf::AsyncInvocationOnMultipleSessionsNotSupportedError();
+                    logger_->debug("Acquiring a session to %s for %d targets",
+                                   serverUri.c_str(), ranks.size());
+
+                    Session* session = NULL;
+                    ret = acquireSession(serverUri,
+                                         getSessionSettings<_Service>(request, serverUri),
+                                         session,
+                                         sessionLane<_Service>(request));
+
+                    if (ret.isGood())
+                    {
+                        logger_->debug("Scheduling an invocation for this session");
+                        Invocation* invocation = newInvocation<_Service>(request);
+                        invocations[session] = invocation;
+
+                        for (std::size_t j = 0; j < ranks.size(); j++)
+                            invocation->addTarget(ranks[j], request.targets[ranks[j]], result.targets[ranks[j]]);
+                    }
+                }
             }
 
+            logger_->debug("A total of %d invocations were built", invocations.size());
 
-            // loop through the invocations (while the return Status is good)
-            int invocationIndex = 0; // index to keep track of the number of processed invocations
+            // create a job for each invocation, so that they can be executed concurrently
+            typedef ServiceInvocationJob<_Service> Job;
+            std::vector<uaf::InvocationJob*> jobs;
+            std::vector<uaf::TransactionId> transactionIds;
+            std::vector< std::vector<std::size_t> > transactionRanks;
             for (typename InvocationMap::iterator it = invocations.begin();
-                 it != invocations.end() && ret.isGood();
+                 it != invocations.end();
                  ++it)
             {
-                logger_->debug("Processing invocation %d", invocationIndex);
-
                 // create a pointer to the current invocation
                 uaf::Session* session = it->first;
                 Invocation*   invocation = it->second;
 
-                // set the transactionId if necessary
+                // set the transactionId if necessary: every invocation gets its own transaction
+                // id, so that its partial result can be recognized when it is received
                 if (handleStored)
                 {
-                    logger_->debug("Copying the transaction id %d to the invocation",transactionId);
-                    invocation->setTransactionId(transactionId);
+                    uaf::TransactionId invocationTransactionId = transactionId;
+                    if (transactionIds.size() > 0)
+                        invocationTransactionId = storeTransactionId(requestHandle);
+
+                    logger_->debug("Copying the transaction id %d to the invocation",
+                                   invocationTransactionId);
+                    invocation->setTransactionId(invocationTransactionId);
+                    transactionIds.push_back(invocationTransactionId);
+                    transactionRanks.push_back(invocation->ranks());
                 }
 
-                // copy the session information to the invocation
-                logger_->debug("Copying the session information to the invocation");
-                invocation->setSessionInformation(session->sessionInformation());
+                // synchronous invocations may pipeline their chunks via asynchronous calls
+                if (!async)
+                    invocation->setChunkPipeline(chunkPipeline_);
 
-                // if the session is connected, invoke the service
-                if (session->isConnected())
-                {
-                    logger_->debug("Forwarding the invocation to session %d",
-                                   session->clientConnectionId());
-                    ret = session->invokeService<_Service>(request, *invocation);
-                }
-                else
-                    ret = session->sessionInformation().lastConnectionAttemptStatus;
+                jobs.push_back(new Job(request, session, invocation, logger_));
+            }
+
+            // the partial results of an asynchronous request to multiple sessions must be
+            // assembled into a single result, so announce them before any invocation is started
+            bool assembled = false;
+            if (ret.isGood() && async && invocations.size() > 1)
+            {
+                assembled = expectAsyncResult(request, transactionIds, transactionRanks);
+
+                if (!assembled)
+                    ret = uaf::AsyncInvocationOnMultipleSessionsNotSupportedError();
+            }
+
+            // execute the jobs (while the return Status is good): synchronous invocations to
+            // different sessions are dispatched concurrently, so the total latency is that of
+            // the slowest session instead of the sum of all of them
+            bool executed = ret.isGood();
+            if (executed)
+            {
+                uint32_t maxParallelInvocations = 1;
+                if (!async)
+                    maxParallelInvocations = database_->clientSettings.maxParallelInvocations;
+
+                invocationPool_->executeAll(jobs, maxParallelInvocations);
+            }
+
+            // the transactions that were started, and of which the results will still be received
+            std::vector<uaf::TransactionId> startedTransactionIds;
+
+            // loop through the jobs, to copy their results (by rank) and release their sessions
+            for (std::size_t invocationIndex = 0; invocationIndex < jobs.size(); invocationIndex++)
+            {
+                logger_->debug("Processing invocation %d", invocationIndex);
+
+                Job* job = static_cast<Job*>(jobs[invocationIndex]);
+                uaf::Session* session = job->session();
+                Invocation*   invocation = job->invocation();
 
                 // copy all data to the result
-                if (ret.isGood())
+                if (executed)
                 {
-                    logger_->debug("Copying the invocation data to the result");
-                    ret = invocation->copyToResult(result);
+                    uaf::Status invocationStatus = job->status();
+
+                    if (invocationStatus.isGood() && invocationIndex < transactionIds.size())
+                        startedTransactionIds.push_back(transactionIds[invocationIndex]);
+
+                    if (invocationStatus.isGood())
+                    {
+                        logger_->debug("Copying the invocation data to the result");
+                        invocationStatus = invocation->copyToResult(result);
+                    }
+
+                    // the first failing invocation determines the return Status
+                    if (ret.isGood())
+                        ret = invocationStatus;
                 }
 
                 releaseSession(session);
@@ -516,20 +545,36 @@ namespace uaf
                 // don't forget to delete the invocation!!!
                 // (see bugfix https://github.com/uaf/uaf/issues/86)
                 delete invocation;
-
-                invocationIndex++;
+                delete job;
             }
+            jobs.clear();
 
             // clear the InvocationMap
             invocations.clear();
 
-            // remove the handle if one was stored, and if there was an unexpected error
+            // remove the handles if they were stored, and if there was an unexpected error
             if (ret.isNotGood() && handleStored)
             {
-                logger_->debug("Removing the transaction id");
-                // remove the transaction id : request handle pair
+                logger_->debug("Removing the transaction ids");
+
+                if (assembled)
+                    cancelAsyncResult(request, startedTransactionIds);
+
+                // remove the transaction id : request handle pairs, except those of the
+                // asynchronous transactions that were started (their callbacks remove them)
+                std::set<uaf::TransactionId> pendingTransactionIds;
+                if (async)
+                    pendingTransactionIds.insert(startedTransactionIds.begin(),
+                                                 startedTransactionIds.end());
+
                 transactionMapMutex_.lock();            // lock the map
-                transactionMap_.erase(transactionId);   // erase the key
+                if (pendingTransactionIds.count(transactionId) == 0)
+                    transactionMap_.erase(transactionId);
+                for (std::size_t i = 0; i < transactionIds.size(); i++)
+                {
+                    if (pendingTransactionIds.count(transactionIds[i]) == 0)
+                        transactionMap_.erase(transactionIds[i]);
+                }
                 transactionMapMutex_.unlock();          // unlock the map
             }
 
@@ -543,6 +588,24 @@ namespace uaf
         DISALLOW_COPY_AND_ASSIGN(SessionFactory);
 
 
+        /**
+         * Create a new invocation for the given request.
+         *
+         * @tparam _Service The service to be invoked.
+         * @param request   The request to be invoked.
+         * @return          A new invocation, to be deleted by the caller.
+         */
+        template<typename _Service>
+        typename _Service::Invocation* newInvocation(const typename _Service::Request& request)
+        {
+            typename _Service::Invocation* invocation = new typename _Service::Invocation;
+            invocation->setAsynchronous(_Service::asynchronous);
+            invocation->setRequestHandle(request.requestHandle());
+            invocation->setServiceSettings(getServiceSettings<_Service>(request));
+            return invocation;
+        }
+
+
         // define a dataype for the number of activities associated with a specific session
         typedef uint32_t Activity;
 
@@ -553,6 +616,133 @@ namespace uaf
         // define a map to relate transaction ids with request handles
         typedef std::map<uaf::TransactionId, uaf::RequestHandle>  TransactionMap;
 
+        // the lanes via which an invocation can be sent to a server:
+        //  - PrimaryLane     : the first session of the pool (e.g. for subscriptions)
+        //  - PooledLane      : the least busy session of the pool
+        //  - LongRunningLane : a dedicated session for long-running services (if configured)
+        enum Lane { PrimaryLane, PooledLane, LongRunningLane };
+
+        // define the key to find a pool of shared sessions
+        struct SessionKey
+        {
+            SessionKey(const std::string& serverUri,
+                       uaf::SessionSettingsFingerprint fingerprint,
+                       bool longRunning)
+            : serverUri(serverUri), fingerprint(fingerprint), longRunning(longRunning) {}
+
+            std::string                     serverUri;
+            uaf::SessionSettingsFingerprint fingerprint;
+            bool                            longRunning;
+
+            bool operator<(const SessionKey& other) const
+            {
+                if (fingerprint != other.fingerprint)
+                    return fingerprint < other.fingerprint;
+                else if (longRunning != other.longRunning)
+                    return longRunning < other.longRunning;
+                else
+                    return serverUri < other.serverUri;
+            }
+        };
+
+        // define an index to find the pools of shared sessions
+        typedef std::vector<uaf::ClientConnectionId>                    SessionPool;
+        typedef std::map<SessionKey, SessionPool>                       SessionIndex;
+        typedef std::map<uaf::ClientConnectionId, SessionKey>           SessionKeyMap;
+
+
+        /**
+         * Check if a service with the given settings takes long to complete.
+         */
+        static bool isLongRunning(const uaf::ServiceSettings& settings)
+        { return false; }
+        static bool isLongRunning(const uaf::BrowseSettings& settings)
+        { return settings.maxAutoBrowseNext > 0; }
+        static bool isLongRunning(const uaf::HistoryReadRawModifiedSettings& settings)
+        { return true; }
+
+
+        /**
+         * Get the lane via which a session request must be invoked.
+         */
+        template<typename _Service>
+        Lane sessionLane(
+                const uaf::BaseSessionRequest<typename _Service::Settings,
+                                               typename _Service::RequestTarget,
+                                               _Service::asynchronous>& request)
+        {
+            if (isLongRunning(getServiceSettings<_Service>(request)))
+                return LongRunningLane;
+            else
+                return PooledLane;
+        }
+
+
+        /**
+         * Get the lane via which a subscription request must be invoked: subscriptions are
+         * always created on the first session of a pool.
+         */
+        template<typename _Service>
+        Lane sessionLane(
+                const uaf::BaseSubscriptionRequest<typename _Service::Settings,
+                                                    typename _Service::RequestTarget,
+                                                    _Service::asynchronous>& request)
+        {
+            return PrimaryLane;
+        }
+
+
+        /**
+         * A job that forwards a single invocation to its session, so that it can be executed
+         * by the invocation pool.
+         */
+        template<typename _Service>
+        class ServiceInvocationJob : public uaf::InvocationJob
+        {
+        public:
+            ServiceInvocationJob(
+                    const typename _Service::Request&   request,
+                    uaf::Session*                       session,
+                    typename _Service::Invocation*      invocation,
+                    uaf::Logger*                        logger)
+            : request_(request),
+              session_(session),
+              invocation_(invocation),
+              logger_(logger)
+            {}
+
+            void execute()
+            {
+                // connect a new session (if other jobs are connecting the same session, this
+                // job waits for them, but the jobs of other sessions are not blocked)
+                session_->connectIfNotAttemptedYet();
+
+                // copy the session information to the invocation
+                invocation_->setSessionInformation(session_->sessionInformation());
+
+                // if the session is connected, invoke the service
+                if (session_->isConnected())
+                {
+                    logger_->debug("Forwarding the invocation to session %d",
+                                   session_->clientConnectionId());
+                    status_ = session_->invokeService<_Service>(request_, *invocation_);
+                }
+                else
+                    status_ = session_->sessionInformation().lastConnectionAttemptStatus;
+            }
+
+            uaf::Session* session() const { return session_; }
+            typename _Service::Invocation* invocation() const { return invocation_; }
+            uaf::Status status() const { return status_; }
+
+        private:
+            const typename _Service::Request&   request_;
+            uaf::Session*                       session_;
+            typename _Service::Invocation*      invocation_;
+            uaf::Logger*                        logger_;
+            uaf::Status                         status_;
+        };
+
 
         /**
          * Acquire a session with the given properties (by getting an existing one, or creating
@@ -561,16 +751,62 @@ namespace uaf
          * The 'session' pointer can be used safely as long as releaseSession() is not called
          * by the same thread.
          *
+         * A new session is not connected by this method, since the sessionMap_ may not be locked
+         * while the server is being contacted. Call Session::connectIfNotAttemptedYet() after
+         * the session has been acquired.
+         *
          * @param serverUri         Server URI to create the session to.
          * @param sessionSettings   Settings of the session to be acquired.
          * @param session           Pointer to the requested session.
-         * @return                  Status object, will be erroneous in case no connected session
+         * @param lane              The lane via which the session will be used.
+         * @return                  Status object, will be erroneous in case no session
          *                          could be provided via the 'session' argument.
          */
         uaf::Status acquireSession(
                 const std::string&              serverUri,
                 const uaf::SessionSettings&    sessionSettings,
-                uaf::Session*&                 session);
+                uaf::Session*&                 session,
+                Lane                            lane=PrimaryLane);
+
+
+        /**
+         * Add a new session to the sessionIndex_ (the sessionMapMutex_ must be locked!).
+         *
+         * Unique sessions are never indexed, since they can't be shared. Sessions of which the
+         * server URI is not known yet (because they were connected manually to an endpoint) are
+         * indexed as soon as their server URI becomes known.
+         *
+         * @param session       The session to index.
+         * @param fingerprint   The fingerprint of the settings of the session.
+         * @param longRunning   True if the session is dedicated to long-running services.
+         */
+        void indexSession(
+                uaf::Session*                   session,
+                uaf::SessionSettingsFingerprint fingerprint,
+                bool                            longRunning=false);
+
+
+        /**
+         * Remove a session from the sessionIndex_ (the sessionMapMutex_ must be locked!).
+         *
+         * @param clientConnectionId    The id of the session to remove.
+         */
+        void unindexSession(uaf::ClientConnectionId clientConnectionId);
+
+
+        /**
+         * Find a shared session in the sessionIndex_ (the sessionMapMutex_ must be locked!).
+         *
+         * If the pool may still grow and all of its sessions are busy, no session is returned,
+         * so that a new one will be added to the pool.
+         *
+         * @param key           The key of the pool.
+         * @param primary       True to get the first session of the pool, false to get the
+         *                      least busy one.
+         * @param poolSize      The maximum size of the pool.
+         * @return              The session, or NULL if a new session must be created.
+         */
+        uaf::Session* findIndexedSession(const SessionKey& key, bool primary, std::size_t poolSize);
 
 
         /**
@@ -605,6 +841,23 @@ namespace uaf
         uaf::Status releaseSession(uaf::Session*& session, bool allowGarbageCollection=true);
 
 
+        /**
+         * Acquire all existing sessions at once, so that they can be used (e.g. to invoke a
+         * service on each of them) without keeping the sessionMap_ locked.
+         *
+         * @param sessions  Output parameter: the acquired sessions.
+         */
+        void acquireAllSessions(std::vector<uaf::Session*>& sessions);
+
+
+        /**
+         * Release all sessions that were acquired by acquireAllSessions().
+         *
+         * @param sessions  The sessions to release (the vector will be cleared).
+         */
+        void releaseSessions(std::vector<uaf::Session*>& sessions);
+
+
         /**
          * Get a new transaction id
          *
@@ -628,6 +881,17 @@ namespace uaf
             bool                                        clientSideError);
 
 
+        /**
+         * Called when the discovery URLs of a server have changed, overridden from
+         * uaf::DiscoveryListener. The sessions to this server that are not connected will try to
+         * connect again (via the new URLs) as soon as they are used, instead of reporting the
+         * result of their previous connection attempt.
+         */
+        virtual void discoveryUrlsChanged(
+                const std::string&              serverUri,
+                const std::vector<std::string>& discoveryUrls);
+
+
         /**
          * Called every time the connection status has changed,
          * overridden from UaSessionCallback.
@@ -673,6 +937,89 @@ namespace uaf
             );
 
 
+        /**
+         * Generate a new transaction ID and store the given request handle for it.
+         *
+         * @param requestHandle The handle of the asynchronous request.
+         * @return              The newly generated transaction id.
+         */
+        uaf::TransactionId storeTransactionId(uaf::RequestHandle requestHandle);
+
+
+        /**
+         * Remove a transaction id that was stored before (e.g. because its call could not be
+         * started, or because its result was handled already).
+         *
+         * @param transactionId The transaction id to remove.
+         */
+        void removeTransactionId(uaf::TransactionId transactionId);
+
+
+        /**
+         * Announce the transactions of an asynchronous request that was spread over multiple
+         * sessions, so that their partial results can be assembled when they are received.
+         *
+         * @param request           The asynchronous request.
+         * @param transactionIds    The transaction ids of the invocations.
+         * @param ranks             For each transaction id, the ranks of the invoked targets.
+         * @return                  True if the partial results will be assembled, false if
+         *                          this is not supported for this kind of request.
+         */
+        bool expectAsyncResult(
+                const uaf::AsyncReadRequest&                    request,
+                const std::vector<uaf::TransactionId>&          transactionIds,
+                const std::vector< std::vector<std::size_t> >&  ranks);
+        bool expectAsyncResult(
+                const uaf::AsyncWriteRequest&                   request,
+                const std::vector<uaf::TransactionId>&          transactionIds,
+                const std::vector< std::vector<std::size_t> >&  ranks);
+        bool expectAsyncResult(
+                const uaf::AsyncMethodCallRequest&              request,
+                const std::vector<uaf::TransactionId>&          transactionIds,
+                const std::vector< std::vector<std::size_t> >&  ranks);
+
+
+        /**
+         * Catch the requests for which no partial results can be assembled.
+         */
+        template<typename _Request>
+        bool expectAsyncResult(
+                const _Request&                                 request,
+                const std::vector<uaf::TransactionId>&          transactionIds,
+                const std::vector< std::vector<std::size_t> >&  ranks)
+        {
+            return false;
+        }
+
+
+        /**
+         * Cancel the assembly of the partial results of an asynchronous request.
+         *
+         * @param request               The asynchronous request.
+         * @param startedTransactionIds The transactions that were started, and of which the
+         *                              partial results will still be received (and discarded).
+         */
+        void cancelAsyncResult(
+                const uaf::AsyncReadRequest&            request,
+                const std::vector<uaf::TransactionId>&  startedTransactionIds);
+        void cancelAsyncResult(
+                const uaf::AsyncWriteRequest&           request,
+                const std::vector<uaf::TransactionId>&  startedTransactionIds);
+        void cancelAsyncResult(
+                const uaf::AsyncMethodCallRequest&      request,
+                const std::vector<uaf::TransactionId>&  startedTransactionIds);
+
+
+        /**
+         * Catch the requests for which no partial results can be assembled.
+         */
+        template<typename _Request>
+        void cancelAsyncResult(
+                const _Request&                         request,
+                const std::vector<uaf::TransactionId>&  startedTransactionIds)
+        {}
+
+
         /**
          * Generate a new transaction ID and store the request id of the associated request, if
          * necessary (i.e. if the service is asynchronous).
@@ -699,13 +1046,8 @@ namespace uaf
 
             if (_Service::asynchronous)
             {
-                transactionMapMutex_.lock();
-                transactionId = getNewTransactionId();
-                transactionMap_[transactionId] = request.requestHandle();
-                transactionMapMutex_.unlock();
+                transactionId = storeTransactionId(request.requestHandle());
                 stored = true;
-                logger_->debug("A new transaction id %d was stored for request %d",
-                               transactionId, request.requestHandle());
             }
             else
             {
@@ -755,14 +1097,39 @@ namespace uaf
 
         // map storing all sessions
         SessionMap sessionMap_;
-        // mutex to safely manipulate the sessionMap_
+        // mutex to safely manipulate the sessionMap_ (and the index of it)
         UaMutex  sessionMapMutex_;
 
+        // the interned session settings
+        uaf::SessionSettingsRegistry settingsRegistry_;
+        // the pools of shared sessions, indexed by server URI, settings fingerprint and lane
+        SessionIndex sessionIndex_;
+        // the keys of the indexed sessions
+        SessionKeyMap sessionKeys_;
+        // the shared sessions that couldn't be indexed yet because their server URI is unknown
+        // (and whether they are dedicated to long-running services)
+        std::map<uaf::ClientConnectionId, bool> unindexedSessions_;
+
         // map storing all activity counts
         ActivityMap activityMap_;
         // mutex to safely manipulate the activity map
         UaMutex activityMapMutex_;
 
+        // the pool to execute the invocations of a single request concurrently
+        uaf::InvocationPool* invocationPool_;
+
+        // the pipeline that routes the responses to pipelined chunks to their invocations
+        uaf::ChunkPipeline* chunkPipeline_;
+        friend class ChunkPipeline;
+
+        // the PKI store that is shared by all sessions
+        uaf::PkiStore* pkiStore_;
+
+        // the assemblers of the asynchronous results of requests to multiple sessions
+        uaf::AsyncResultAssembler<uaf::ReadResult>         readResultAssembler_;
+        uaf::AsyncResultAssembler<uaf::WriteResult>        writeResultAssembler_;
+        uaf::AsyncResultAssembler<uaf::MethodCallResult>   methodCallResultAssembler_;
+
 
 
     };
@@ -0,0 +1,103 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/client/sessions/sessionsettingsregistry.h"
+
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+    using std::size_t;
+
+
+    // Constructor
+    // =============================================================================================
+    SessionSettingsRegistry::SessionSettingsRegistry()
+    : nextFingerprint_(0)
+    {}
+
+
+    // Hash the settings
+    // =============================================================================================
+    uint32_t SessionSettingsRegistry::hash(const SessionSettings& settings)
+    {
+        uint32_t h = fnvhash::OFFSET_BASIS;
+
+        // hash exactly the same values as the ones compared by operator==
+        fnvhash::addInt(h, int(settings.sessionTimeoutSec*1000));
+        fnvhash::addInt(h, int(settings.connectTimeoutSec*1000));
+        fnvhash::addInt(h, int(settings.watchdogTimeoutSec*1000));
+        fnvhash::addInt(h, int(settings.watchdogTimeSec*1000));
+        fnvhash::addInt(h, settings.unique);
+        fnvhash::addInt(h, settings.maxChunksInFlight);
+        fnvhash::addInt(h, settings.sessionPoolSize);
+        fnvhash::addInt(h, settings.separateLongRunningServices);
+        fnvhash::addInt(h, int(settings.readServerInfoSettings.callTimeoutSec*1000));
+        fnvhash::addInt(h, settings.readServerInfoSettings.maxOperationsPerCall);
+        fnvhash::addString(h, settings.securitySettings.securityPolicy);
+        fnvhash::addInt(h, settings.securitySettings.messageSecurityMode);
+        fnvhash::addInt(h, settings.securitySettings.userTokenType);
+        fnvhash::addString(h, settings.securitySettings.userName);
+        fnvhash::addString(h, settings.securitySettings.userPassword);
+        fnvhash::addString(h, settings.securitySettings.userCertificateFileName);
+        fnvhash::addString(h, settings.securitySettings.userPrivateKeyFileName);
+
+        return h;
+    }
+
+
+    // Intern the settings
+    // =============================================================================================
+    SessionSettingsFingerprint SessionSettingsRegistry::intern(const SessionSettings& settings)
+    {
+        uint32_t h = hash(settings);
+
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        vector<Entry>& bucket = buckets_[h];
+
+        // only the settings with the same hash need to be compared in full
+        for (vector<Entry>::const_iterator it = bucket.begin(); it != bucket.end(); ++it)
+        {
+            if (it->settings == settings)
+                return it->fingerprint;
+        }
+
+        Entry entry;
+        entry.settings    = settings;
+        entry.fingerprint = nextFingerprint_++;
+        bucket.push_back(entry);
+
+        return entry.fingerprint;
+    }
+
+
+    // Get the number of interned settings
+    // =============================================================================================
+    size_t SessionSettingsRegistry::size() const
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return nextFingerprint_;
+    }
+
+
+}
@@ -0,0 +1,126 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SESSIONSETTINGSREGISTRY_H_
+#define UAF_SESSIONSETTINGSREGISTRY_H_
+
+
+// STD
+#include <map>
+#include <vector>
+#include <stdint.h>
+// SDK
+#include "uabase/uamutex.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/fnvhash.h"
+#include "uaf/client/clientexport.h"
+#include "uaf/client/settings/sessionsettings.h"
+
+
+namespace uaf
+{
+
+    /**
+     * A fingerprint identifies a set of session settings: two SessionSettings instances have the
+     * same fingerprint if and only if they are equal (according to operator==).
+     */
+    typedef uint32_t SessionSettingsFingerprint;
+
+
+    /*******************************************************************************************//**
+    * An uaf::SessionSettingsRegistry interns uaf::SessionSettings into fingerprints.
+    *
+    * Comparing SessionSettings is expensive (they contain several strings), so the session
+    * factory compares their fingerprints instead. The registry hashes the settings, and only
+    * compares them in full with the (few) settings that were interned before with the same hash.
+    *
+    * Interned settings are never removed, since an application typically uses only a handful of
+    * different session settings.
+    *
+    * @ingroup ClientSessions
+    ***********************************************************************************************/
+    class UAF_EXPORT SessionSettingsRegistry
+    {
+    public:
+
+
+        /**
+         * Construct an empty registry.
+         */
+        SessionSettingsRegistry();
+
+
+        /**
+         * Get the fingerprint of the given settings (and intern them if they're new).
+         *
+         * @param settings  The settings to intern.
+         * @return          The fingerprint of the settings.
+         */
+        uaf::SessionSettingsFingerprint intern(const uaf::SessionSettings& settings);
+
+
+        /**
+         * Get the number of different settings that have been interned.
+         *
+         * @return  The number of fingerprints that were handed out.
+         */
+        std::size_t size() const;
+
+
+        /**
+         * Compute the hash of the given settings. Settings that are equal (according to
+         * operator==) have the same hash.
+         *
+         * @param settings  The settings to hash.
+         * @return          The hash value.
+         */
+        static uint32_t hash(const uaf::SessionSettings& settings);
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(SessionSettingsRegistry);
+
+
+        // an interned set of settings
+        struct Entry
+        {
+            uaf::SessionSettings                settings;
+            uaf::SessionSettingsFingerprint     fingerprint;
+        };
+
+        // the interned settings, grouped by their hash
+        typedef std::map<uint32_t, std::vector<Entry> > Buckets;
+        Buckets buckets_;
+
+        // the fingerprint to assign to the next new settings
+        uaf::SessionSettingsFingerprint nextFingerprint_;
+
+        // mutex to safely manipulate the buckets
+        mutable UaMutex mutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_SESSIONSETTINGSREGISTRY_H_ */
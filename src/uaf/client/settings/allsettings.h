@@ -31,6 +31,8 @@
 #include "uaf/client/settings/browsesettings.h"
 #include "uaf/client/settings/browsenextsettings.h"
 #include "uaf/client/settings/historyreadrawmodifiedsettings.h"
+#include "uaf/client/settings/registernodessettings.h"
+#include "uaf/client/settings/unregisternodessettings.h"
 #include "uaf/client/settings/sessionsettings.h"
 #include "uaf/client/settings/subscriptionsettings.h"
 #include "uaf/client/settings/clientsettings.h"
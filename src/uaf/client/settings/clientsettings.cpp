@@ -36,7 +36,9 @@ namespace uaf
     template<> uaf::HistoryReadRawModifiedSettings          getDefaultServiceSettings<uaf::HistoryReadRawModifiedSettings>          (const uaf::ClientSettings& clientSettings) { return clientSettings.defaultHistoryReadRawModifiedSettings; }
     template<> uaf::MethodCallSettings                      getDefaultServiceSettings<uaf::MethodCallSettings>                      (const uaf::ClientSettings& clientSettings) { return clientSettings.defaultMethodCallSettings;; }
     template<> uaf::ReadSettings                            getDefaultServiceSettings<uaf::ReadSettings>                            (const uaf::ClientSettings& clientSettings) { return clientSettings.defaultReadSettings; }
+    template<> uaf::RegisterNodesSettings                   getDefaultServiceSettings<uaf::RegisterNodesSettings>                   (const uaf::ClientSettings& clientSettings) { return clientSettings.defaultRegisterNodesSettings; }
     template<> uaf::TranslateBrowsePathsToNodeIdsSettings   getDefaultServiceSettings<uaf::TranslateBrowsePathsToNodeIdsSettings>   (const uaf::ClientSettings& clientSettings) { return clientSettings.defaultTranslateBrowsePathsToNodeIdsSettings; }
+    template<> uaf::UnregisterNodesSettings                 getDefaultServiceSettings<uaf::UnregisterNodesSettings>                 (const uaf::ClientSettings& clientSettings) { return clientSettings.defaultUnregisterNodesSettings; }
     template<> uaf::WriteSettings                           getDefaultServiceSettings<uaf::WriteSettings>                           (const uaf::ClientSettings& clientSettings) { return clientSettings.defaultWriteSettings; }
 
 
@@ -49,6 +51,17 @@ namespace uaf
       discoveryFindServersTimeoutSec(2.0),
       discoveryGetEndpointsTimeoutSec(1.0),
       discoveryIntervalSec(30.0),
+      discoveryEndpointsCacheTimeSec(60.0),
+      discoveryMaxParallelFindServers(10),
+      maxParallelInvocations(10),
+      houseKeepingIntervalSec(30.0),
+      persistedRequestsIntervalSec(30.0),
+      addressCacheMaxEntries(1000000),
+      addressCacheMaxBytes(0),
+      addressCacheTimeToLiveSec(0.0),
+      addressCacheUnresolvableTimeToLiveSec(5.0),
+      addressCacheMonitorModelChanges(false),
+      addressCacheFile(""),
       certificateTrustListLocation("PKI/trusted/certs/"),
       certificateRevocationListLocation("PKI/trusted/crl/"),
       issuersCertificatesLocation("PKI/issuers/certs/"),
@@ -68,6 +81,17 @@ namespace uaf
       discoveryFindServersTimeoutSec(2.0),
       discoveryGetEndpointsTimeoutSec(1.0),
       discoveryIntervalSec(30.0),
+      discoveryEndpointsCacheTimeSec(60.0),
+      discoveryMaxParallelFindServers(10),
+      maxParallelInvocations(10),
+      houseKeepingIntervalSec(30.0),
+      persistedRequestsIntervalSec(30.0),
+      addressCacheMaxEntries(1000000),
+      addressCacheMaxBytes(0),
+      addressCacheTimeToLiveSec(0.0),
+      addressCacheUnresolvableTimeToLiveSec(5.0),
+      addressCacheMonitorModelChanges(false),
+      addressCacheFile(""),
       certificateTrustListLocation("PKI/trusted/certs/"),
       certificateRevocationListLocation("PKI/trusted/crl/"),
       issuersCertificatesLocation("PKI/issuers/certs/"),
@@ -89,6 +113,17 @@ namespace uaf
       discoveryFindServersTimeoutSec(2.0),
       discoveryGetEndpointsTimeoutSec(1.0),
       discoveryIntervalSec(30.0),
+      discoveryEndpointsCacheTimeSec(60.0),
+      discoveryMaxParallelFindServers(10),
+      maxParallelInvocations(10),
+      houseKeepingIntervalSec(30.0),
+      persistedRequestsIntervalSec(30.0),
+      addressCacheMaxEntries(1000000),
+      addressCacheMaxBytes(0),
+      addressCacheTimeToLiveSec(0.0),
+      addressCacheUnresolvableTimeToLiveSec(5.0),
+      addressCacheMonitorModelChanges(false),
+      addressCacheFile(""),
       certificateTrustListLocation("PKI/trusted/certs/"),
       certificateRevocationListLocation("PKI/trusted/crl/"),
       issuersCertificatesLocation("PKI/issuers/certs/"),
@@ -251,6 +286,50 @@ namespace uaf
         ss << fillToPos(ss, colon);
         ss << ": " << discoveryGetEndpointsTimeoutSec << "\n";
 
+        ss << indent << " - discoveryEndpointsCacheTimeSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << discoveryEndpointsCacheTimeSec << "\n";
+
+        ss << indent << " - discoveryMaxParallelFindServers";
+        ss << fillToPos(ss, colon);
+        ss << ": " << discoveryMaxParallelFindServers << "\n";
+
+        ss << indent << " - maxParallelInvocations";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxParallelInvocations << "\n";
+
+        ss << indent << " - houseKeepingIntervalSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << houseKeepingIntervalSec << "\n";
+
+        ss << indent << " - persistedRequestsIntervalSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << persistedRequestsIntervalSec << "\n";
+
+        ss << indent << " - addressCacheMaxEntries";
+        ss << fillToPos(ss, colon);
+        ss << ": " << addressCacheMaxEntries << "\n";
+
+        ss << indent << " - addressCacheMaxBytes";
+        ss << fillToPos(ss, colon);
+        ss << ": " << addressCacheMaxBytes << "\n";
+
+        ss << indent << " - addressCacheTimeToLiveSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << addressCacheTimeToLiveSec << "\n";
+
+        ss << indent << " - addressCacheUnresolvableTimeToLiveSec";
+        ss << fillToPos(ss, colon);
+        ss << ": " << addressCacheUnresolvableTimeToLiveSec << "\n";
+
+        ss << indent << " - addressCacheMonitorModelChanges";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (addressCacheMonitorModelChanges ? "true" : "false") << "\n";
+
+        ss << indent << " - addressCacheFile";
+        ss << fillToPos(ss, colon);
+        ss << ": " << addressCacheFile << "\n";
+
         ss << indent << " - certificateTrustListLocation";
         ss << fillToPos(ss, colon);
         ss << ": " << certificateTrustListLocation << "\n";
@@ -318,9 +397,15 @@ namespace uaf
         ss << indent << " - defaultReadSettings\n";
         ss << defaultReadSettings.toString(indent + "   ", colon) << "\n";
 
+        ss << indent << " - defaultRegisterNodesSettings\n";
+        ss << defaultRegisterNodesSettings.toString(indent + "   ", colon) << "\n";
+
         ss << indent << " - defaultTranslateBrowsePathsToNodeIdsSettings\n";
         ss << defaultTranslateBrowsePathsToNodeIdsSettings.toString(indent + "   ", colon) << "\n";
 
+        ss << indent << " - defaultUnregisterNodesSettings\n";
+        ss << defaultUnregisterNodesSettings.toString(indent + "   ", colon) << "\n";
+
         ss << indent << " - defaultWriteSettings\n";
         ss << defaultWriteSettings.toString(indent + "   ", colon) << "\n";
 
@@ -351,6 +436,18 @@ namespace uaf
                && object1.logToCallbackLevel == object2.logToCallbackLevel
                && object1.discoveryFindServersTimeoutSec == object2.discoveryFindServersTimeoutSec
                && object1.discoveryGetEndpointsTimeoutSec == object2.discoveryGetEndpointsTimeoutSec
+               && object1.discoveryEndpointsCacheTimeSec == object2.discoveryEndpointsCacheTimeSec
+               && object1.discoveryMaxParallelFindServers == object2.discoveryMaxParallelFindServers
+               && object1.maxParallelInvocations == object2.maxParallelInvocations
+               && object1.houseKeepingIntervalSec == object2.houseKeepingIntervalSec
+               && object1.persistedRequestsIntervalSec == object2.persistedRequestsIntervalSec
+               && object1.addressCacheMaxEntries == object2.addressCacheMaxEntries
+               && object1.addressCacheMaxBytes == object2.addressCacheMaxBytes
+               && object1.addressCacheTimeToLiveSec == object2.addressCacheTimeToLiveSec
+               && object1.addressCacheUnresolvableTimeToLiveSec
+                  == object2.addressCacheUnresolvableTimeToLiveSec
+               && object1.addressCacheMonitorModelChanges == object2.addressCacheMonitorModelChanges
+               && object1.addressCacheFile == object2.addressCacheFile
                && object1.certificateTrustListLocation == object2.certificateTrustListLocation
                && object1.certificateRevocationListLocation == object2.certificateRevocationListLocation
                && object1.issuersCertificatesLocation == object2.issuersCertificatesLocation
@@ -391,6 +488,30 @@ namespace uaf
             return object1.discoveryFindServersTimeoutSec < object2.discoveryFindServersTimeoutSec;
         else if (object1.discoveryGetEndpointsTimeoutSec != object2.discoveryGetEndpointsTimeoutSec)
             return object1.discoveryGetEndpointsTimeoutSec < object2.discoveryGetEndpointsTimeoutSec;
+        else if (object1.discoveryEndpointsCacheTimeSec != object2.discoveryEndpointsCacheTimeSec)
+            return object1.discoveryEndpointsCacheTimeSec < object2.discoveryEndpointsCacheTimeSec;
+        else if (object1.discoveryMaxParallelFindServers != object2.discoveryMaxParallelFindServers)
+            return object1.discoveryMaxParallelFindServers < object2.discoveryMaxParallelFindServers;
+        else if (object1.maxParallelInvocations != object2.maxParallelInvocations)
+            return object1.maxParallelInvocations < object2.maxParallelInvocations;
+        else if (object1.houseKeepingIntervalSec != object2.houseKeepingIntervalSec)
+            return object1.houseKeepingIntervalSec < object2.houseKeepingIntervalSec;
+        else if (object1.persistedRequestsIntervalSec != object2.persistedRequestsIntervalSec)
+            return object1.persistedRequestsIntervalSec < object2.persistedRequestsIntervalSec;
+        else if (object1.addressCacheMaxEntries != object2.addressCacheMaxEntries)
+            return object1.addressCacheMaxEntries < object2.addressCacheMaxEntries;
+        else if (object1.addressCacheMaxBytes != object2.addressCacheMaxBytes)
+            return object1.addressCacheMaxBytes < object2.addressCacheMaxBytes;
+        else if (object1.addressCacheTimeToLiveSec != object2.addressCacheTimeToLiveSec)
+            return object1.addressCacheTimeToLiveSec < object2.addressCacheTimeToLiveSec;
+        else if (object1.addressCacheUnresolvableTimeToLiveSec
+                 != object2.addressCacheUnresolvableTimeToLiveSec)
+            return object1.addressCacheUnresolvableTimeToLiveSec
+                   < object2.addressCacheUnresolvableTimeToLiveSec;
+        else if (object1.addressCacheMonitorModelChanges != object2.addressCacheMonitorModelChanges)
+            return object1.addressCacheMonitorModelChanges < object2.addressCacheMonitorModelChanges;
+        else if (object1.addressCacheFile != object2.addressCacheFile)
+            return object1.addressCacheFile < object2.addressCacheFile;
         else if (object1.certificateTrustListLocation != object2.certificateTrustListLocation)
             return object1.certificateTrustListLocation < object2.certificateTrustListLocation;
         else if (object1.certificateRevocationListLocation != object2.certificateRevocationListLocation)
@@ -42,6 +42,8 @@
 #include "uaf/client/settings/browsesettings.h"
 #include "uaf/client/settings/browsenextsettings.h"
 #include "uaf/client/settings/historyreadrawmodifiedsettings.h"
+#include "uaf/client/settings/registernodessettings.h"
+#include "uaf/client/settings/unregisternodessettings.h"
 #include "uaf/client/settings/sessionsettings.h"
 #include "uaf/client/settings/subscriptionsettings.h"
 
@@ -70,6 +72,17 @@ namespace uaf
          *  - discoveryFindServersTimeoutSec : 2.0
          *  - discoveryGetEndpointsTimeoutSec : 1.0
          *  - discoveryIntervalSec : 30.0
+         *  - discoveryEndpointsCacheTimeSec : 60.0
+         *  - discoveryMaxParallelFindServers : 10
+         *  - maxParallelInvocations : 10
+         *  - houseKeepingIntervalSec : 30.0
+         *  - persistedRequestsIntervalSec : 30.0
+         *  - addressCacheMaxEntries : 1000000
+         *  - addressCacheMaxBytes : 0
+         *  - addressCacheTimeToLiveSec : 0.0
+         *  - addressCacheUnresolvableTimeToLiveSec : 5.0
+         *  - addressCacheMonitorModelChanges : false
+         *  - addressCacheFile : "" (i.e. the cache is not persisted)
          *  - logToStdOutLevel : uaf::loglevels::Disabled
          *  - logToCallbackLevel : uaf::loglevels::Disabled
          *  - certificateTrustListLocation : "PKI/trusted/certs/"
@@ -138,6 +151,73 @@ namespace uaf
          *  background, in seconds. */
         float discoveryIntervalSec;
 
+        /** The time during which the endpoints that were fetched via the GetEndpoints service
+         *  are cached (and reused for connecting sessions), in seconds. A value of 0 or less
+         *  disables the cache. */
+        float discoveryEndpointsCacheTimeSec;
+
+        /** The maximum number of discovery URLs on which the FindServers service may be invoked
+         *  at the same time. A value of 0 or 1 means that the URLs are handled one after the
+         *  other. */
+        uint32_t discoveryMaxParallelFindServers;
+
+
+        /////// Invocations ///////
+
+
+        /** The maximum number of sessions that a single synchronous request (e.g. a read of
+         *  targets hosted by several servers) may invoke concurrently. A value of 0 or 1 means
+         *  that the sessions are invoked one after the other. */
+        uint32_t maxParallelInvocations;
+
+
+        /////// Periodic jobs ///////
+
+
+        /** The interval between the checks of the sessions and subscriptions (which are
+         *  reconnected if needed) that are continuously running in the background, in seconds. */
+        float houseKeepingIntervalSec;
+
+        /** The interval between the attempts to process the persisted requests (e.g. to
+         *  re-create monitored items that could not be created before) that are continuously
+         *  running in the background, in seconds. */
+        float persistedRequestsIntervalSec;
+
+
+        /////// Address cache ///////
+
+
+        /** The maximum number of resolved addresses that are cached. When the cache is full,
+         *  the least recently used addresses are evicted. A value of 0 means no limit. */
+        uint32_t addressCacheMaxEntries;
+
+        /** The maximum number of bytes (estimated) that the cached addresses may occupy. When
+         *  the cache is full, the least recently used addresses are evicted. A value of 0 means
+         *  no limit. */
+        uint32_t addressCacheMaxBytes;
+
+        /** The time after which a cached address expires (and must be resolved again), in
+         *  seconds. A value of 0 or less means that cached addresses never expire. */
+        float addressCacheTimeToLiveSec;
+
+        /** The time during which addresses that could not be resolved (e.g. because the browse
+         *  path doesn't exist) are remembered as unresolvable, in seconds, so that they don't
+         *  need to be resolved again every time they are used. They are forgotten earlier when
+         *  their server is reconnected or its namespace array has changed. Addresses of unknown
+         *  servers are never remembered, since the server may be discovered at any time.
+         *  A value of 0 or less means that they are always resolved again. */
+        float addressCacheUnresolvableTimeToLiveSec;
+
+        /** True to subscribe to the model change events (GeneralModelChangeEvents and
+         *  SemanticChangeEvents) of every connected server, so that the cached addresses of the
+         *  affected nodes are removed as soon as the address space of a server changes. */
+        bool addressCacheMonitorModelChanges;
+
+        /** The file to which the cached addresses are saved when the client is destructed, and
+         *  from which they are loaded when the client is constructed (or when this setting is
+         *  changed). An empty string means that the cache is not persisted. */
+        std::string addressCacheFile;
+
 
         /////// Security ///////
 
@@ -215,7 +295,9 @@ namespace uaf
         uaf::HistoryReadRawModifiedSettings         defaultHistoryReadRawModifiedSettings;
         uaf::MethodCallSettings                     defaultMethodCallSettings;
         uaf::ReadSettings                           defaultReadSettings;
+        uaf::RegisterNodesSettings                  defaultRegisterNodesSettings;
         uaf::TranslateBrowsePathsToNodeIdsSettings  defaultTranslateBrowsePathsToNodeIdsSettings;
+        uaf::UnregisterNodesSettings                defaultUnregisterNodesSettings;
         uaf::WriteSettings                          defaultWriteSettings;
         uaf::ServiceSettings                        defaultSetPublishingModeSettings;
         uaf::ServiceSettings                        defaultSetMonitoringModeSettings;
@@ -292,7 +374,9 @@ namespace uaf
     template<> uaf::HistoryReadRawModifiedSettings           UAF_EXPORT getDefaultServiceSettings<uaf::HistoryReadRawModifiedSettings>          (const uaf::ClientSettings& clientSettings);
     template<> uaf::MethodCallSettings                       UAF_EXPORT getDefaultServiceSettings<uaf::MethodCallSettings>                      (const uaf::ClientSettings& clientSettings);
     template<> uaf::ReadSettings                             UAF_EXPORT getDefaultServiceSettings<uaf::ReadSettings>                            (const uaf::ClientSettings& clientSettings);
+    template<> uaf::RegisterNodesSettings                    UAF_EXPORT getDefaultServiceSettings<uaf::RegisterNodesSettings>                   (const uaf::ClientSettings& clientSettings);
     template<> uaf::TranslateBrowsePathsToNodeIdsSettings    UAF_EXPORT getDefaultServiceSettings<uaf::TranslateBrowsePathsToNodeIdsSettings>   (const uaf::ClientSettings& clientSettings);
+    template<> uaf::UnregisterNodesSettings                  UAF_EXPORT getDefaultServiceSettings<uaf::UnregisterNodesSettings>                 (const uaf::ClientSettings& clientSettings);
     template<> uaf::WriteSettings                            UAF_EXPORT getDefaultServiceSettings<uaf::WriteSettings>                           (const uaf::ClientSettings& clientSettings);
 
 
@@ -33,6 +33,7 @@ namespace uaf
     ServiceSettings::ServiceSettings()
     {
         callTimeoutSec = 1.0; // 1 sec
+        maxOperationsPerCall = 0; // respect the limits of the server
     }
 
 
@@ -44,7 +45,11 @@ namespace uaf
 
         ss << indent << " - callTimeoutSec";
         ss << fillToPos(ss, colon);
-        ss << ": " << callTimeoutSec;
+        ss << ": " << callTimeoutSec << "\n";
+
+        ss << indent << " - maxOperationsPerCall";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxOperationsPerCall;
 
         return ss.str();
     }
@@ -69,7 +74,10 @@ namespace uaf
     // =============================================================================================
     bool operator<(const ServiceSettings& object1, const ServiceSettings& object2)
     {
-        return int(object1.callTimeoutSec*1000) < int(object2.callTimeoutSec*1000);
+        if (int(object1.callTimeoutSec*1000) != int(object2.callTimeoutSec*1000))
+            return int(object1.callTimeoutSec*1000) < int(object2.callTimeoutSec*1000);
+        else
+            return object1.maxOperationsPerCall < object2.maxOperationsPerCall;
     }
 
 
@@ -77,7 +85,8 @@ namespace uaf
     // =============================================================================================
     bool operator==(const ServiceSettings& object1, const ServiceSettings& object2)
     {
-        return (int(object1.callTimeoutSec*1000)  == int(object2.callTimeoutSec*1000));
+        return (int(object1.callTimeoutSec*1000)  == int(object2.callTimeoutSec*1000))
+            && object1.maxOperationsPerCall == object2.maxOperationsPerCall;
     }
 
 
@@ -60,6 +60,16 @@ namespace uaf
          */
         double callTimeoutSec;
 
+        /**
+         * The maximum number of targets (operations) that may be sent to the server in a single
+         * service call. Invocations with more targets are split into several calls, and the
+         * results of these calls are merged transparently.
+         *
+         * If 0 (the default), the OperationLimits exposed by the server are respected (or no
+         * limit is imposed at all, if the server doesn't expose them).
+         */
+        uint32_t maxOperationsPerCall;
+
 
         /**
          * Get a string representation of the settings.
@@ -38,6 +38,9 @@ namespace uaf
         watchdogTimeoutSec         = 2.0;
         watchdogTimeSec            = 5.0;
         unique                     = false;
+        maxChunksInFlight          = 1;
+        sessionPoolSize            = 1;
+        separateLongRunningServices = false;
 
     }
 
@@ -62,6 +65,15 @@ namespace uaf
         ss << indent << " - unique";
         ss << fillToPos(ss, colon);
         ss << ": " << (unique ? "true" : "false") << "\n";
+        ss << indent << " - maxChunksInFlight";
+        ss << fillToPos(ss, colon);
+        ss << ": " << maxChunksInFlight << "\n";
+        ss << indent << " - sessionPoolSize";
+        ss << fillToPos(ss, colon);
+        ss << ": " << sessionPoolSize << "\n";
+        ss << indent << " - separateLongRunningServices";
+        ss << fillToPos(ss, colon);
+        ss << ": " << (separateLongRunningServices ? "true" : "false") << "\n";
         ss << indent << " - readServerInfoSettings\n";
         ss << readServerInfoSettings.toString(indent + "   ", colon).c_str() << '\n';
         ss << indent << " - securitySettings\n";
@@ -87,6 +99,12 @@ namespace uaf
             return int(object1.watchdogTimeSec*1000) < int(object2.watchdogTimeSec*1000);
         else if (object1.unique != object2.unique)
             return object1.unique < object2.unique;
+        else if (object1.maxChunksInFlight != object2.maxChunksInFlight)
+            return object1.maxChunksInFlight < object2.maxChunksInFlight;
+        else if (object1.sessionPoolSize != object2.sessionPoolSize)
+            return object1.sessionPoolSize < object2.sessionPoolSize;
+        else if (object1.separateLongRunningServices != object2.separateLongRunningServices)
+            return object1.separateLongRunningServices < object2.separateLongRunningServices;
         else if (object1.readServerInfoSettings != object2.readServerInfoSettings)
             return object1.readServerInfoSettings < object2.readServerInfoSettings;
         else if (object1.securitySettings != object2.securitySettings)
@@ -107,6 +125,9 @@ namespace uaf
            &&    (int(object1.watchdogTimeoutSec*1000) == int(object2.watchdogTimeoutSec*1000))
            &&    (int(object1.watchdogTimeSec*1000)    == int(object2.watchdogTimeSec*1000)))
            &&    object1.unique == object2.unique
+           &&    object1.maxChunksInFlight == object2.maxChunksInFlight
+           &&    object1.sessionPoolSize == object2.sessionPoolSize
+           &&    object1.separateLongRunningServices == object2.separateLongRunningServices
            &&    object1.readServerInfoSettings == object2.readServerInfoSettings
            &&    object1.securitySettings == object2.securitySettings;
     }
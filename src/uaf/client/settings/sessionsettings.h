@@ -57,6 +57,9 @@ namespace uaf
          *   - watchdogTimeoutSec = 2.0
          *   - watchdogTimeSec    = 5.0
          *   - unique             = false
+         *   - maxChunksInFlight  = 1
+         *   - sessionPoolSize    = 1
+         *   - separateLongRunningServices = false
          */
         SessionSettings();
 
@@ -75,6 +78,24 @@ namespace uaf
         /** Should this session that uses these settings be unique, or not? **/
         bool        unique;
 
+        /** The maximum number of chunks of a synchronous Read or Write request that may be in
+         *  flight on this session at the same time. Requests are split into chunks when they
+         *  exceed the OperationLimits of the server (or the maxOperationsPerCall of the service
+         *  settings). A value of 1 means that the chunks are sent one after another. **/
+        uint32_t    maxChunksInFlight;
+
+        /** The maximum number of (non-unique) sessions with these settings that the client may
+         *  create to the same server. The invocations are spread over the sessions of such a
+         *  pool according to their number of ongoing invocations, and a new session is only
+         *  added to the pool when all existing sessions are busy. Subscriptions are always
+         *  created on the first session of the pool. **/
+        uint32_t    sessionPoolSize;
+
+        /** True to invoke long-running services (HistoryReadRawModified, and Browse with
+         *  automatic BrowseNext calls) on a dedicated session, so that they don't delay the
+         *  other services (such as the Read calls of a control loop). **/
+        bool        separateLongRunningServices;
+
         /** The settings to be used to read the namespace array and server array, when the session
          *  is first connected (UAF clients will do this automatically in the background). */
         uaf::ReadSettings readServerInfoSettings;
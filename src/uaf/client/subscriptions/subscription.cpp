@@ -430,8 +430,11 @@ namespace uaf
                 notifications.push_back(notification);
 
                 // log the notification
-                logger_->debug(" - Notification %d:", int(i));
-                logger_->debug(notification.toString("   ", 25));
+                if (logger_->isDebugEnabled())
+                {
+                    logger_->debug(" - Notification %d:", int(i));
+                    logger_->debug(notification.toString("   ", 25));
+                }
             }
         }
 
@@ -474,8 +477,11 @@ namespace uaf
                 notifications.push_back(notification);
 
                 // log the notification
-                logger_->debug(" - Notification %d:", int(i));
-                logger_->debug(notification.toString("   ", 25));
+                if (logger_->isDebugEnabled())
+                {
+                    logger_->debug(" - Notification %d:", int(i));
+                    logger_->debug(notification.toString("   ", 25));
+                }
             }
         }
 
@@ -38,7 +38,9 @@ namespace uaf
       relativePath_(0),
       startingAddress_(0),
       expandedNodeId_(new ExpandedNodeId)
-    {}
+    {
+        updateHash();
+    }
 
 
     // Constructor
@@ -49,7 +51,9 @@ namespace uaf
       relativePath_(new vector<RelativePathElement>(relativePath)),
       startingAddress_(new Address(*startingAddress)),
       expandedNodeId_(0)
-    {}
+    {
+        updateHash();
+    }
 
 
     // Constructor
@@ -62,6 +66,7 @@ namespace uaf
     {
         relativePath_ = new vector<RelativePathElement>();
         relativePath_->push_back(relativePath);
+        updateHash();
     }
 
 
@@ -74,7 +79,9 @@ namespace uaf
       relativePath_(new vector<RelativePathElement>(browsePath.relativePath)),
       startingAddress_(new Address(browsePath.startingExpandedNodeId)),
       expandedNodeId_(0)
-    {}
+    {
+        updateHash();
+    }
 
 
     // Constructor
@@ -85,7 +92,9 @@ namespace uaf
       relativePath_(0),
       startingAddress_(0),
       expandedNodeId_(new ExpandedNodeId(expandedNodeId))
-    {}
+    {
+        updateHash();
+    }
 
 
     // Constructor
@@ -96,7 +105,9 @@ namespace uaf
       relativePath_(0),
       startingAddress_(0),
       expandedNodeId_(new ExpandedNodeId(nodeId, serverUri))
-    {}
+    {
+        updateHash();
+    }
 
 
     // Constructor
@@ -105,6 +116,7 @@ namespace uaf
     {
         isRelativePath_ = other.isRelativePath_;
         isStartingAddressOwned_ = other.isStartingAddressOwned_;
+        hash_ = other.hash_;
         
         if (isRelativePath_)
         {
@@ -133,6 +145,7 @@ namespace uaf
 
             isRelativePath_ = other.isRelativePath_;
             isStartingAddressOwned_ = other.isStartingAddressOwned_;
+            hash_ = other.hash_;
             if (isRelativePath_)
             {
                 relativePath_    = new vector<RelativePathElement>(*other.relativePath_);
@@ -182,6 +195,90 @@ namespace uaf
         }
     }
 
+
+    // Add a qualified name to a hash
+    // =============================================================================================
+    static void hashQualifiedName(uint32_t& h, const QualifiedName& qualifiedName)
+    {
+        fnvhash::addString(h, qualifiedName.name());
+        fnvhash::addInt(h, qualifiedName.nameSpaceIndex());
+        fnvhash::addString(h, qualifiedName.nameSpaceUri());
+    }
+
+
+    // Add a node id to a hash
+    // =============================================================================================
+    static void hashNodeId(uint32_t& h, const NodeId& nodeId)
+    {
+        NodeIdIdentifier identifier = nodeId.identifier();
+
+        fnvhash::addInt(h, identifier.type);
+
+        if (identifier.type == nodeididentifiertypes::Identifier_Numeric)
+        {
+            fnvhash::addInt(h, identifier.idNumeric);
+        }
+        else if (identifier.type == nodeididentifiertypes::Identifier_String)
+        {
+            fnvhash::addString(h, identifier.idString);
+        }
+        else if (identifier.type == nodeididentifiertypes::Identifier_Guid)
+        {
+            OpcUa_Guid guid;
+            identifier.idGuid.toSdk(&guid);
+            fnvhash::addInt(h, guid.Data1);
+            fnvhash::addInt(h, guid.Data2);
+            fnvhash::addInt(h, guid.Data3);
+            fnvhash::addBytes(h, guid.Data4, sizeof(guid.Data4));
+        }
+        else if (identifier.type == nodeididentifiertypes::Identifier_Opaque)
+        {
+            fnvhash::addInt(h, identifier.idOpaque.length());
+            fnvhash::addBytes(h, identifier.idOpaque.data(), identifier.idOpaque.length());
+        }
+
+        fnvhash::addInt(h, nodeId.nameSpaceIndex());
+        fnvhash::addString(h, nodeId.nameSpaceUri());
+    }
+
+
+    // Update the hash
+    // =============================================================================================
+    void Address::updateHash()
+    {
+        // hash the same values as the ones compared by operator==
+        uint32_t h = fnvhash::OFFSET_BASIS;
+
+        fnvhash::addInt(h, isRelativePath_);
+
+        if (isRelativePath_)
+        {
+            fnvhash::addInt(h, int64_t(relativePath_->size()));
+
+            for (vector<RelativePathElement>::const_iterator it = relativePath_->begin();
+                 it != relativePath_->end();
+                 ++it)
+            {
+                hashQualifiedName(h, it->targetName);
+                hashNodeId(h, it->referenceType);
+                fnvhash::addInt(h, it->isInverse);
+                fnvhash::addInt(h, it->includeSubtypes);
+            }
+
+            // the starting address has computed its own hash already
+            fnvhash::addInt(h, startingAddress_->hash_);
+        }
+        else
+        {
+            hashNodeId(h, expandedNodeId_->nodeId());
+            fnvhash::addInt(h, expandedNodeId_->serverIndex());
+            fnvhash::addString(h, expandedNodeId_->serverUri());
+        }
+
+        hash_ = h;
+    }
+
+
     // Get the relative path
     // =============================================================================================
     vector<RelativePathElement> Address::getRelativePath() const
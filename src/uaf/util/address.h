@@ -32,6 +32,7 @@
 #include "uaf/util/relativepathelement.h"
 #include "uaf/util/expandednodeid.h"
 #include "uaf/util/constants.h"
+#include "uaf/util/fnvhash.h"
 // SDK
 
 
@@ -189,6 +190,18 @@ namespace uaf
         bool isRelativePath() const { return isRelativePath_; }
 
 
+        /**
+         * Get the hash of the address.
+         *
+         * The hash is computed only once, when the address is constructed. Equal addresses
+         * always have the same hash, so it can be used to look up addresses quickly (e.g. in
+         * the uaf::AddressCache).
+         *
+         * @return The hash of the address.
+         */
+        uint32_t hash() const { return hash_; }
+
+
         /**
          * Get a string representation.
          *
@@ -233,6 +246,12 @@ namespace uaf
         // The ExpandedNodeId in case the address is absolute.
         uaf::ExpandedNodeId* expandedNodeId_;
 
+        // The hash of the address (computed by the constructors)
+        uint32_t hash_;
+
+        // Compute the hash of the address, from the members above
+        void updateHash();
+
     };
 
 
@@ -0,0 +1,147 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_ARRAYVIEW_H_
+#define UAF_ARRAYVIEW_H_
+
+
+// STD
+#include <cstddef>
+#include <stdint.h>
+// SDK
+#include "uabase/uavariant.h"
+// UAF
+#include "uaf/util/util.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An ArrayView is a read-only view on an array that is owned by some other object (e.g. the
+    * array of a uaf::Variant).
+    *
+    * A view does not copy any elements, so it is only valid for as long as the owner of the
+    * array is not modified or destroyed.
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    template <typename _T>
+    class ArrayView
+    {
+    public:
+
+
+        /**
+         * Construct an empty view.
+         */
+        ArrayView() : data_(NULL), size_(0) {}
+
+
+        /**
+         * Construct a view on the given elements.
+         *
+         * @param data  Pointer to the first element.
+         * @param size  Number of elements.
+         */
+        ArrayView(const _T* data, std::size_t size) : data_(data), size_(size) {}
+
+
+        /**
+         * Get a pointer to the first element.
+         *
+         * @return  The pointer to the first element (may be NULL if the view is empty).
+         */
+        const _T* data() const { return data_; }
+
+
+        /**
+         * Get the number of elements.
+         *
+         * @return  The number of elements.
+         */
+        std::size_t size() const { return size_; }
+
+
+        /**
+         * Check if the view has no elements.
+         *
+         * @return  True if the view is empty.
+         */
+        bool empty() const { return size_ == 0; }
+
+
+        /**
+         * Get the element at the given index (which is not checked).
+         *
+         * @param i The index of the element.
+         * @return  The element.
+         */
+        const _T& operator[](std::size_t i) const { return data_[i]; }
+
+
+        /**
+         * Get an iterator to the first element.
+         */
+        const _T* begin() const { return data_; }
+
+
+        /**
+         * Get an iterator past the last element.
+         */
+        const _T* end() const { return data_ + size_; }
+
+
+    private:
+
+        // pointer to the first element
+        const _T* data_;
+
+        // number of elements
+        std::size_t size_;
+    };
+
+
+
+    /**
+     * Allocate a buffer for the given number of elements, so that it can be adopted afterwards
+     * by a uaf::Variant (e.g. by Variant::adoptDoubleArray()).
+     *
+     * The buffer is allocated by the memory functions of the OPC UA stack, since the variant
+     * will eventually free it with these functions. A buffer that is not adopted must be freed
+     * with OpcUa_Free().
+     *
+     * @param length    The number of elements.
+     * @return          The (uninitialized) buffer, or NULL if it could not be allocated.
+     *
+     * @ingroup Util
+     */
+    template <typename _T>
+    _T* allocateArray(uint32_t length)
+    {
+        return (_T*) OpcUa_Alloc(length * sizeof(_T));
+    }
+
+
+}
+
+
+#endif /* UAF_ARRAYVIEW_H_ */
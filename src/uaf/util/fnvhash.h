@@ -0,0 +1,104 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_FNVHASH_H_
+#define UAF_FNVHASH_H_
+
+
+// STD
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+// SDK
+// UAF
+#include "uaf/util/util.h"
+
+
+namespace uaf
+{
+
+
+    /**
+     * Helper functions to compute FNV-1a hashes.
+     *
+     * The hashes are not cryptographic, they are only meant to look up objects quickly (e.g. in
+     * a cache). They are stable: the same values always result in the same hash.
+     *
+     * @ingroup Util
+     */
+    namespace fnvhash
+    {
+
+        /** The initial value of a hash. */
+        const uint32_t OFFSET_BASIS = 2166136261u;
+
+        /** The prime to multiply a hash with, for every byte. */
+        const uint32_t PRIME        = 16777619u;
+
+
+        /**
+         * Add the bytes of a value to a hash.
+         *
+         * @param h         The hash to update.
+         * @param data      Pointer to the bytes.
+         * @param length    Number of bytes.
+         */
+        inline void addBytes(uint32_t& h, const void* data, std::size_t length)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < length; i++)
+            {
+                h ^= bytes[i];
+                h *= PRIME;
+            }
+        }
+
+
+        /**
+         * Add an integer to a hash.
+         *
+         * @param h         The hash to update.
+         * @param value     The value to add.
+         */
+        inline void addInt(uint32_t& h, int64_t value)
+        {
+            addBytes(h, &value, sizeof(value));
+        }
+
+
+        /**
+         * Add a string to a hash (including its length, so that e.g. ("ab","c") and ("a","bc")
+         * hash differently).
+         *
+         * @param h         The hash to update.
+         * @param value     The value to add.
+         */
+        inline void addString(uint32_t& h, const std::string& value)
+        {
+            addInt(h, int64_t(value.size()));
+            addBytes(h, value.data(), value.size());
+        }
+
+    }
+
+}
+
+
+#endif /* UAF_FNVHASH_H_ */
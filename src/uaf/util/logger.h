@@ -260,6 +260,33 @@ namespace uaf
         ~Logger();
 
 
+        /**
+         * Check if a message with the given level will be logged at all.
+         *
+         * Use this method to avoid building expensive messages (e.g. the string representation
+         * of a large request) that would be thrown away anyway:
+         * @code
+         * if (logger->checkLevel(uaf::loglevels::Debug))
+         *     logger->debug(request.toString());
+         * @endcode
+         *
+         * @param level The loglevel of the message.
+         * @return      True if the message would be logged to the stdout or the callback interface.
+         */
+        bool checkLevel(uaf::loglevels::LogLevel level) const
+        {
+            return loggerFactory_->checkLevel(level);
+        }
+
+
+        /**
+         * Check if debug messages will be logged at all (see checkLevel()).
+         *
+         * @return True if debug messages would be logged to the stdout or the callback interface.
+         */
+        bool isDebugEnabled() const { return checkLevel(uaf::loglevels::Debug); }
+
+
         /**
          * Log the SDK status (Debug if Good, Warning if Uncertain, Error if Bad).
          */
@@ -31,7 +31,9 @@ namespace uaf
 
     // Constructor
     // =============================================================================================
-    NamespaceArray::NamespaceArray() {}
+    NamespaceArray::NamespaceArray()
+    : memoizing_(false)
+    {}
 
 
     // Destructor
@@ -39,6 +41,15 @@ namespace uaf
     NamespaceArray::~NamespaceArray() {}
 
 
+    // Enable or disable the memoization of the namespace indexes
+    // =============================================================================================
+    void NamespaceArray::setMemoizing(bool memoizing)
+    {
+        memoizing_ = memoizing;
+        memo_.clear();
+    }
+
+
     // Read the contents of a data value as returned when a client reads the NamespaceArray NodeId.
     // =============================================================================================
     Status NamespaceArray::fromSdk(const OpcUa_DataValue& value)
@@ -61,6 +72,21 @@ namespace uaf
                     nameSpaceMap_[i] = NamespaceArray::getSimplifiedUri(
                             string(UaString(&namespaceArray_[i]).toUtf8()));
                 }
+
+                // build the reverse index (if a simplified URI occurs multiple times, the
+                // lowest index wins, just like it did for the linear search)
+                uriIndexes_.clear();
+                memo_.clear();
+                NameSpaceMap::const_iterator iter;
+                for (iter = nameSpaceMap_.begin(); iter != nameSpaceMap_.end(); ++iter)
+                    uriIndexes_.insert(std::make_pair(iter->second, iter->first));
+
+                // also add the URIs as they were exposed by the server, mapped to the same index
+                // as their simplified URIs
+                for (uint16_t i=0; i<namespaceArray_.length(); i++)
+                    uriIndexes_.insert(std::make_pair(
+                            string(UaString(&namespaceArray_[i]).toUtf8()),
+                            uriIndexes_[nameSpaceMap_[i]]));
             }
             else
             {
@@ -101,29 +127,35 @@ namespace uaf
             const string&   namespaceUri,
             NameSpaceIndex& namespaceIndex) const
     {
-        // We need to do a "reverse" lookup, by iterating over the key:value pairs until we have
-        // found the correct value.
-
-        // get a simplified URI
-        string simplifiedUri = NamespaceArray::getSimplifiedUri(namespaceUri);
-
-        // iterate over the key:value pairs
-        NameSpaceMap::const_iterator iter;
-        for (iter = nameSpaceMap_.begin(); iter != nameSpaceMap_.end(); ++iter)
+        // check the memo first (only filled if memoizing_ is true)
+        std::map<string, NameSpaceIndex>::const_iterator iter;
+        if (memoizing_)
         {
-            // if the NamespaceURI was found, assign the NamespaceIndex, update the status,
-            // and return
-            if (iter->second == simplifiedUri)
+            iter = memo_.find(namespaceUri);
+            if (iter != memo_.end())
             {
-                namespaceIndex = iter->first;
-
-                // we found the URI, so we can return!
+                namespaceIndex = iter->second;
                 return true;
             }
         }
 
-        // we haven't returned yet, so the URI was not found...
-        return false;
+        // then try the URI as it was given (no need to simplify it if it's exactly the same as
+        // the one exposed by the server), and finally the simplified URI
+        iter = uriIndexes_.find(namespaceUri);
+        if (iter == uriIndexes_.end())
+            iter = uriIndexes_.find(NamespaceArray::getSimplifiedUri(namespaceUri));
+
+        // we haven't found the URI...
+        if (iter == uriIndexes_.end())
+            return false;
+
+        // we found the URI, so assign the NamespaceIndex (and remember it, if needed)
+        namespaceIndex = iter->second;
+
+        if (memoizing_)
+            memo_[namespaceUri] = namespaceIndex;
+
+        return true;
     }
 
 
@@ -71,6 +71,21 @@ namespace uaf
         ~NamespaceArray();
 
 
+        /**
+         * Enable or disable the memoization of the namespace indexes that are looked up.
+         *
+         * A memoizing NamespaceArray remembers the namespace index of every namespace URI that
+         * was looked up (exactly as it was given, so without simplifying it again). This is
+         * meant for a copy of the NamespaceArray that is used during a single service
+         * invocation (and therefore by a single thread!), so that the thousands of targets of a
+         * request only cause one lookup per distinct namespace URI.
+         *
+         * @param memoizing True to enable the memoization, false to disable it (and to forget
+         *                  the memoized namespace indexes).
+         */
+        void setMemoizing(bool memoizing);
+
+
         /**
          * Fill the NamespaceArray with the information contained by the given OpcUa_DataValue
          * from the stack.
@@ -249,6 +264,14 @@ namespace uaf
         uaf::Status fillVariant(uaf::Variant& variant) const;
 
 
+        /**
+         * Get the namespace map (index to URI) of the array.
+         *
+         * @return  The namespace map.
+         */
+        const uaf::NameSpaceMap& nameSpaceMap() const { return nameSpaceMap_; }
+
+
         /**
          * A static function to create a string from the given namespace map.
          *
@@ -267,6 +290,16 @@ namespace uaf
         // the original array
         UaStringArray namespaceArray_;
 
+        // the reverse NameSpaceURI:NameSpaceIndex map, containing both the simplified URIs and
+        // the URIs as they were exposed by the server (so that most lookups don't need to
+        // simplify the given URI)
+        std::map<std::string, NameSpaceIndex> uriIndexes_;
+
+        // the memoized NameSpaceURI:NameSpaceIndex pairs (with the URIs as they were given),
+        // only used if memoizing_ is true
+        bool memoizing_;
+        mutable std::map<std::string, NameSpaceIndex> memo_;
+
         /**
          * A static function to convert the URI to a "plain" one (no trailing forward slash,
          * no capitals) in order to simplify comparison.
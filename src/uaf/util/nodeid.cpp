@@ -136,6 +136,16 @@ namespace uaf
     {}
 
 
+    // Constructor
+    // =============================================================================================
+    NodeId::NodeId(const NodeIdIdentifier& identifier)
+    : nameSpaceIndex_(0),
+      identifier_(identifier),
+      nameSpaceIndexGiven_(false),
+      nameSpaceUriGiven_(false)
+    {}
+
+
     // Constructor
     // =============================================================================================
     NodeId::NodeId(const NodeIdIdentifier& identifier, const string& nameSpaceUri)
@@ -151,6 +151,14 @@ namespace uaf
                uaf::NameSpaceIndex  nameSpaceIndex);
 
 
+        /**
+         * Construct a NodeId based on an identifier only (without namespace URI or index).
+         *
+         * @param identifier        Identifier of the NodeId.
+         */
+        explicit NodeId(const uaf::NodeIdIdentifier& identifier);
+
+
         /**
          * Construct a NodeId based on an identifier and a namespace URI.
          *
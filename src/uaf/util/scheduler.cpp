@@ -0,0 +1,179 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "uaf/util/scheduler.h"
+#include "uabase/uadatetime.h"
+
+namespace uaf
+{
+    using namespace uaf;
+    using std::string;
+    using std::vector;
+
+
+    // Constructor
+    // =============================================================================================
+    Scheduler::JobThread::JobThread(Scheduler* scheduler, ScheduledJob* job, const string& name)
+    : wakeUp(0),
+      scheduler_(scheduler),
+      job_(job),
+      name_(name)
+    {}
+
+
+    // Destructor
+    // =============================================================================================
+    Scheduler::JobThread::~JobThread()
+    {
+        delete job_;
+        job_ = 0;
+    }
+
+
+    // Thread function of a job
+    // =============================================================================================
+    void Scheduler::JobThread::run()
+    {
+        scheduler_->logger_->debug("Job '%s' has started", name_.c_str());
+
+        UaDateTime lastExecution = UaDateTime::now();
+
+        while (!scheduler_->isStopping())
+        {
+            // don't let a job run back-to-back (e.g. if its interval was configured as 0)
+            double intervalMs = job_->intervalSec() * 1000.0;
+            if (intervalMs < Scheduler::MIN_INTERVAL_MS)
+                intervalMs = Scheduler::MIN_INTERVAL_MS;
+            double elapsedMs  = lastExecution.msecsTo(UaDateTime::now());
+
+            // don't wait forever if the clock was set back
+            if (elapsedMs < 0)
+            {
+                lastExecution = UaDateTime::now();
+                elapsedMs     = 0;
+            }
+
+            if (elapsedMs >= intervalMs)
+            {
+                lastExecution = UaDateTime::now();
+                job_->execute();
+            }
+            else
+            {
+                // sleep until the job is due, or until we're woken up
+                wakeUp.timedWait(OpcUa_UInt32(intervalMs - elapsedMs) + 1);
+            }
+        }
+
+        scheduler_->logger_->debug("Job '%s' has stopped", name_.c_str());
+    }
+
+
+    // Constructor
+    // =============================================================================================
+    Scheduler::Scheduler(LoggerFactory* loggerFactory)
+    : stopping_(false)
+    {
+        logger_ = new Logger(loggerFactory, "Scheduler");
+        logger_->debug("The Scheduler has been constructed");
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    Scheduler::~Scheduler()
+    {
+        logger_->debug("Destructing the Scheduler");
+
+        stop();
+
+        for (vector<JobThread*>::iterator it = threads_.begin(); it != threads_.end(); ++it)
+            delete *it;
+        threads_.clear();
+
+        delete logger_;
+        logger_ = 0;
+    }
+
+
+    // Schedule a job
+    // =============================================================================================
+    void Scheduler::schedule(ScheduledJob* job, const string& name)
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        JobThread* thread = new JobThread(this, job, name);
+        threads_.push_back(thread);
+
+        if (!stopping_)
+            thread->start();
+
+        logger_->debug("Job '%s' has been scheduled", name.c_str());
+    }
+
+
+    // Wake up all threads
+    // =============================================================================================
+    void Scheduler::reschedule()
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+        for (vector<JobThread*>::iterator it = threads_.begin(); it != threads_.end(); ++it)
+            (*it)->wakeUp.post(1);
+    }
+
+
+    // Stop all jobs
+    // =============================================================================================
+    void Scheduler::stop()
+    {
+        vector<JobThread*> threads;
+
+        {
+            UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+
+            if (stopping_)
+                return;
+
+            stopping_ = true;
+            threads = threads_;
+
+            for (vector<JobThread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+                (*it)->wakeUp.post(1);
+        }
+
+        // wait for the threads without locking the mutex, since they need it to finish
+        for (vector<JobThread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+            (*it)->wait();
+
+        logger_->debug("All %d jobs have been stopped", threads.size());
+    }
+
+
+    // Check if the scheduler is stopping
+    // =============================================================================================
+    bool Scheduler::isStopping() const
+    {
+        UaMutexLocker locker(&mutex_); // unlocks when locker goes out of scope
+        return stopping_;
+    }
+
+
+}
@@ -0,0 +1,179 @@
+/* This file is part of the UAF (Unified Architecture Framework) project.
+ *
+ * Copyright (C) 2012 Wim Pessemier (Institute of Astronomy, KULeuven)
+ *
+ * Project website: http://www.ster.kuleuven.be/uaf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UAF_SCHEDULER_H_
+#define UAF_SCHEDULER_H_
+
+
+// STD
+#include <string>
+#include <vector>
+// SDK
+#include "uabase/uathread.h"
+#include "uabase/uamutex.h"
+#include "uabase/uasemaphore.h"
+// UAF
+#include "uaf/util/util.h"
+#include "uaf/util/logger.h"
+
+
+namespace uaf
+{
+
+
+    /*******************************************************************************************//**
+    * An uaf::ScheduledJob is a piece of work that is executed periodically by an uaf::Scheduler.
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    class UAF_EXPORT ScheduledJob
+    {
+    public:
+
+        /**
+         * Destruct the job.
+         */
+        virtual ~ScheduledJob() {}
+
+
+        /**
+         * Get the time between two executions of the job. This method is called again before
+         * every wait, so the interval may change while the job is scheduled. Intervals shorter
+         * than Scheduler::MIN_INTERVAL_MS (including 0 or negative ones) are rounded up to it.
+         *
+         * @return  The interval, in seconds.
+         */
+        virtual double intervalSec() const = 0;
+
+
+        /**
+         * Execute the job. This method is called from the thread of the job.
+         */
+        virtual void execute() = 0;
+    };
+
+
+
+    /*******************************************************************************************//**
+    * An uaf::Scheduler executes a number of uaf::ScheduledJob instances periodically.
+    *
+    * Every job runs on its own thread, so a job that takes a long time (e.g. because a server
+    * doesn't respond) doesn't delay the other jobs. The threads sleep until their job is due
+    * (instead of polling), and they are woken up immediately when the scheduler is stopped.
+    *
+    * @ingroup Util
+    ***********************************************************************************************/
+    class UAF_EXPORT Scheduler
+    {
+    public:
+
+
+        /**
+         * Construct a scheduler without any jobs.
+         *
+         * @param loggerFactory Logger factory to log all messages to.
+         */
+        Scheduler(uaf::LoggerFactory* loggerFactory);
+
+
+        /**
+         * Destruct the scheduler, after stopping all jobs. The jobs are deleted.
+         */
+        virtual ~Scheduler();
+
+
+        /**
+         * Schedule a job, and start its thread. The job is executed for the first time after
+         * one interval.
+         *
+         * @param job   The job to schedule (the scheduler takes ownership of it).
+         * @param name  The name of the job (only used for logging).
+         */
+        void schedule(uaf::ScheduledJob* job, const std::string& name);
+
+
+        /**
+         * Wake up all threads, so that they take a changed interval into account immediately.
+         */
+        void reschedule();
+
+
+        /**
+         * Stop all jobs (without waiting for the current interval to expire) and wait until
+         * their threads have finished. A job that is being executed is allowed to finish.
+         */
+        void stop();
+
+
+        /**
+         * Check if the scheduler is stopping (jobs that take long may check this regularly).
+         *
+         * @return  True if stop() has been called.
+         */
+        bool isStopping() const;
+
+
+        /** The minimum time between two executions of a job, in milliseconds. */
+        static const uint32_t MIN_INTERVAL_MS = 100;
+
+
+    private:
+
+
+        DISALLOW_COPY_AND_ASSIGN(Scheduler);
+
+
+        /**
+         * The thread of a single job.
+         */
+        class JobThread : public UaThread
+        {
+        public:
+            JobThread(uaf::Scheduler* scheduler, uaf::ScheduledJob* job, const std::string& name);
+            ~JobThread();
+            void run();
+
+            // posted to wake up the thread before its job is due
+            UaSemaphore wakeUp;
+
+        private:
+            uaf::Scheduler*     scheduler_;
+            uaf::ScheduledJob*  job_;
+            std::string         name_;
+        };
+        friend class JobThread;
+
+
+        // logger of the scheduler
+        uaf::Logger* logger_;
+
+        // the threads of the scheduled jobs
+        std::vector<JobThread*> threads_;
+        // true if the jobs must stop
+        bool stopping_;
+        // mutex to safely manipulate the threads_ and stopping_
+        mutable UaMutex mutex_;
+    };
+
+
+}
+
+
+#endif /* UAF_SCHEDULER_H_ */
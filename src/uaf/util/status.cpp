@@ -31,18 +31,15 @@ namespace uaf
     // Constructor
     // =============================================================================================
     Status::Status(const Status& other)
+    : statusCode(other.statusCode),
+      raisedBy_(NULL)
     {
-        copyErrors(other);
-        statusCode = other.statusCode;
+        error_.holder_ = NULL;
+        if (other.error_.holder_ != NULL)
+            error_.holder_ = other.error_.holder_->clone();
 
         if (other.isRaisedBy())
-        {
             raisedBy_ = new Status(*other.raisedBy_);
-        }
-        else
-        {
-            raisedBy_ = NULL;
-        }
     }
 
 
@@ -53,17 +50,21 @@ namespace uaf
         // protect for self-assignment
         if (&other != this)
         {
+            // copy the other status first, since it may be owned by this instance
+            StatusErrorHolderBase* newError = NULL;
+            if (other.error_.holder_ != NULL)
+                newError = other.error_.holder_->clone();
+
+            Status* newRaisedBy = NULL;
+            if (other.isRaisedBy())
+                newRaisedBy = new Status(*other.raisedBy_);
+
+            clearError();
             clearRaisedBy();
-            copyErrors(other);
+
             statusCode = other.statusCode;
-            if (other.isRaisedBy())
-            {
-                raisedBy_ = new Status(*other.raisedBy_);
-            }
-            else
-            {
-                raisedBy_ = NULL;
-            }
+            error_.holder_ = newError;
+            raisedBy_      = newRaisedBy;
         }
         return *this;
     }
@@ -73,10 +74,23 @@ namespace uaf
     // =============================================================================================
     Status::~Status()
     {
+        clearError();
         clearRaisedBy();
     }
 
 
+    // Clear the error payload
+    // =============================================================================================
+    void Status::clearError()
+    {
+        if (error_.holder_ != NULL)
+        {
+            delete error_.holder_;
+            error_.holder_ = NULL;
+        }
+    }
+
+
     // Clear the internal variables
     // =============================================================================================
     void Status::clearRaisedBy()
@@ -104,17 +118,26 @@ namespace uaf
 
         if (statuses.size() == 0)
         {
+            clearError();
             statusCode = uaf::statuscodes::NoStatusesGivenError;
-            raisedBy_NoStatusesGivenError = NoStatusesGivenError();
+            error_.holder_ = new StatusErrorHolder<NoStatusesGivenError>(NoStatusesGivenError());
         }
         else if (noOfGood == statuses.size())
+        {
+            clearError();
             statusCode = uaf::statuscodes::Good;
+        }
         else if (noOfUncertain > 0 && noOfBad == 0)
+        {
+            clearError();
             statusCode = uaf::statuscodes::Uncertain;
+        }
         else
         {
+            clearError();
             statusCode = uaf::statuscodes::BadStatusesPresentError;
-            raisedBy_BadStatusesPresentError = BadStatusesPresentError(noOfGood, noOfUncertain, noOfBad);
+            error_.holder_ = new StatusErrorHolder<BadStatusesPresentError>(
+                    BadStatusesPresentError(noOfGood, noOfUncertain, noOfBad));
         }
     }
 
@@ -123,6 +146,7 @@ namespace uaf
     // =============================================================================================
     void Status::setGood()
     {
+        clearError();
         clearRaisedBy();
         statusCode = uaf::statuscodes::Good;
     }
@@ -131,6 +155,7 @@ namespace uaf
     // =============================================================================================
     void Status::setUncertain()
     {
+        clearError();
         clearRaisedBy();
         statusCode = uaf::statuscodes::Uncertain;
     }
@@ -140,7 +165,10 @@ namespace uaf
     // =============================================================================================
     void Status::setRaisedBy(const Status& status)
     {
-        raisedBy_ = new uaf::Status(status);
+        // copy the status first, since it may be the one we're replacing
+        Status* newRaisedBy = new uaf::Status(status);
+        clearRaisedBy();
+        raisedBy_ = newRaisedBy;
     }
 
     // Check if this status is raised by some other status.
@@ -169,125 +197,8 @@ namespace uaf
 
 
 
-#define UAF_STATUS_COPY_ERROR(ERROR)       \
-        raisedBy_##ERROR = from.raisedBy_##ERROR;
-
-    void Status::copyErrors(const Status& from)
-    {
-        UAF_STATUS_COPY_ERROR(FindServersError)
-        UAF_STATUS_COPY_ERROR(UnknownServerError)
-        UAF_STATUS_COPY_ERROR(EmptyUrlError)
-        UAF_STATUS_COPY_ERROR(NoParallelFindServersAllowedError)
-        UAF_STATUS_COPY_ERROR(NoDiscoveryUrlsFoundError)
-        UAF_STATUS_COPY_ERROR(ServerCertificateRejectedByUserError)
-        UAF_STATUS_COPY_ERROR(ServerCertificateSavingError)
-        UAF_STATUS_COPY_ERROR(OpenSSLStoreInitializationError)
-        UAF_STATUS_COPY_ERROR(ClientCertificateLoadingError)
-        UAF_STATUS_COPY_ERROR(ServerDidNotProvideCertificateError)
-        UAF_STATUS_COPY_ERROR(PathNotExistsError)
-        UAF_STATUS_COPY_ERROR(NoSecuritySettingsGivenError)
-        UAF_STATUS_COPY_ERROR(PathCreationError)
-        UAF_STATUS_COPY_ERROR(SecuritySettingsMatchError)
-        UAF_STATUS_COPY_ERROR(WrongTypeError)
-        UAF_STATUS_COPY_ERROR(UnexpectedError)
-        UAF_STATUS_COPY_ERROR(ServerArrayConversionError)
-        UAF_STATUS_COPY_ERROR(NamespaceArrayConversionError)
-        UAF_STATUS_COPY_ERROR(BadNamespaceArrayError)
-        UAF_STATUS_COPY_ERROR(BadServerArrayError)
-        UAF_STATUS_COPY_ERROR(UnknownServerIndexError)
-        UAF_STATUS_COPY_ERROR(InvalidAddressError)
-        UAF_STATUS_COPY_ERROR(UnknownNamespaceUriError)
-        UAF_STATUS_COPY_ERROR(NoNamespaceIndexOrUriGivenError)
-        UAF_STATUS_COPY_ERROR(UnknownNamespaceIndexError)
-        UAF_STATUS_COPY_ERROR(EmptyServerUriAndUnknownNamespaceIndexError)
-        UAF_STATUS_COPY_ERROR(ExpandedNodeIdAddressExpectedError)
-        UAF_STATUS_COPY_ERROR(EmptyServerUriError)
-        UAF_STATUS_COPY_ERROR(UnsupportedError)
-        UAF_STATUS_COPY_ERROR(UnsupportedNodeIdIdentifierTypeError)
-        UAF_STATUS_COPY_ERROR(SyncInvocationNotSupportedError)
-        UAF_STATUS_COPY_ERROR(AsyncInvocationNotSupportedError)
-        UAF_STATUS_COPY_ERROR(NoStatusesGivenError)
-        UAF_STATUS_COPY_ERROR(BadStatusesPresentError)
-        UAF_STATUS_COPY_ERROR(NotAllTargetsCouldBeResolvedError)
-        UAF_STATUS_COPY_ERROR(InvalidServerUriError)
-        UAF_STATUS_COPY_ERROR(SubscriptionNotCreatedError)
-        UAF_STATUS_COPY_ERROR(NoTargetsGivenError)
-        UAF_STATUS_COPY_ERROR(DataDontMatchAddressesError)
-        UAF_STATUS_COPY_ERROR(ItemNotFoundForTheGivenHandleError)
-        UAF_STATUS_COPY_ERROR(TargetRankOutOfBoundsError)
-        UAF_STATUS_COPY_ERROR(NoItemFoundForTheGivenRequestHandleError)
-        UAF_STATUS_COPY_ERROR(ContinuationPointsDontMatchAddressesError)
-        UAF_STATUS_COPY_ERROR(UnknownNamespaceIndexAndServerIndexError)
-        UAF_STATUS_COPY_ERROR(AsyncMultiMethodCallNotSupportedError)
-        UAF_STATUS_COPY_ERROR(EmptyAddressError)
-        UAF_STATUS_COPY_ERROR(MultipleTranslationResultsError)
-        UAF_STATUS_COPY_ERROR(UnknownClientSubscriptionHandleError)
-        UAF_STATUS_COPY_ERROR(UnknownClientHandleError)
-        UAF_STATUS_COPY_ERROR(UnknownClientConnectionIdError)
-        UAF_STATUS_COPY_ERROR(AsyncConnectionFailedError)
-        UAF_STATUS_COPY_ERROR(ConnectionFailedError)
-        UAF_STATUS_COPY_ERROR(SessionSecuritySettingsDontMatchEndpointError)
-        UAF_STATUS_COPY_ERROR(CouldNotManuallyUnsubscribeError)
-        UAF_STATUS_COPY_ERROR(CouldNotManuallySubscribeError)
-        UAF_STATUS_COPY_ERROR(SessionNotConnectedError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotSetMonitoringModeError)
-        UAF_STATUS_COPY_ERROR(CreateSubscriptionError)
-        UAF_STATUS_COPY_ERROR(DeleteSubscriptionError)
-        UAF_STATUS_COPY_ERROR(SubscriptionHasBeenDeletedError)
-        UAF_STATUS_COPY_ERROR(SetMonitoringModeInvocationError)
-        UAF_STATUS_COPY_ERROR(NoDiscoveryUrlsExposedByServerError)
-        UAF_STATUS_COPY_ERROR(GetEndpointsError)
-        UAF_STATUS_COPY_ERROR(NoEndpointsProvidedByServerError)
-        UAF_STATUS_COPY_ERROR(DisconnectionFailedError)
-        UAF_STATUS_COPY_ERROR(NoConnectedSessionToUpdateArraysError)
-        UAF_STATUS_COPY_ERROR(BadDataReceivedError)
-
-
-        // service errors
-        UAF_STATUS_COPY_ERROR(CouldNotReadArraysError)
-        UAF_STATUS_COPY_ERROR(CreateMonitoredItemsError)
-        UAF_STATUS_COPY_ERROR(CreateMonitoredItemsInvocationError)
-        UAF_STATUS_COPY_ERROR(BeginCreateMonitoredItemsInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotCreateMonitoredItemsError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotBrowseNextError)
-        UAF_STATUS_COPY_ERROR(BrowseNextInvocationError)
-        UAF_STATUS_COPY_ERROR(ReadInvocationError)
-        UAF_STATUS_COPY_ERROR(BeginReadInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotReadError)
-        UAF_STATUS_COPY_ERROR(TranslateBrowsePathsToNodeIdsInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
-        UAF_STATUS_COPY_ERROR(HistoryReadInvocationError)
-        UAF_STATUS_COPY_ERROR(HistoryReadRawModifiedInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotHistoryReadError)
-        UAF_STATUS_COPY_ERROR(MethodCallInvocationError)
-        UAF_STATUS_COPY_ERROR(AsyncMethodCallInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotCallMethodError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotBrowseError)
-        UAF_STATUS_COPY_ERROR(BrowseInvocationError)
-        UAF_STATUS_COPY_ERROR(WriteInvocationError)
-        UAF_STATUS_COPY_ERROR(AsyncWriteInvocationError)
-        UAF_STATUS_COPY_ERROR(ServerCouldNotWriteError)
-        UAF_STATUS_COPY_ERROR(CallCompleteError)
-        UAF_STATUS_COPY_ERROR(InputArgumentError)
-        UAF_STATUS_COPY_ERROR(ReadCompleteError)
-        UAF_STATUS_COPY_ERROR(WriteCompleteError)
-        UAF_STATUS_COPY_ERROR(EmptyUserCertificateError)
-        UAF_STATUS_COPY_ERROR(InvalidPrivateKeyError)
-        UAF_STATUS_COPY_ERROR(SetPublishingModeInvocationError)
-        UAF_STATUS_COPY_ERROR(DefinitionNotFoundError)
-
-        // configuration errors
-        UAF_STATUS_COPY_ERROR(ConfigurationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateCertificateTrustListLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateCertificateRevocationListLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateIssuersCertificateLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateIssuersRevocationListLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateClientPrivateKeyLocationError)
-        UAF_STATUS_COPY_ERROR(CouldNotCreateClientCertificateLocationError)
-    }
-
 #define UAF_STATUS_TOSTRING_IF(ERROR)       \
-        if (statusCode == uaf::statuscodes::ERROR) return raisedBy_##ERROR.message;
+        if (statusCode == uaf::statuscodes::ERROR) return raisedBy_##ERROR->message;
 #define UAF_STATUS_TOSTRING_ELSE_IF(ERROR)       \
         else UAF_STATUS_TOSTRING_IF(ERROR)
 
@@ -295,6 +206,12 @@ namespace uaf
     // =============================================================================================
     string Status::toString() const
     {
+        // most statuses are Good or Uncertain, so check these first
+        if (isGood())
+            return "Good";
+        else if (isUncertain())
+            return "Uncertain";
+
         UAF_STATUS_TOSTRING_IF(FindServersError)
         UAF_STATUS_TOSTRING_ELSE_IF(UnknownServerError)
         UAF_STATUS_TOSTRING_ELSE_IF(EmptyUrlError)
@@ -380,6 +297,8 @@ namespace uaf
         UAF_STATUS_TOSTRING_ELSE_IF(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
         UAF_STATUS_TOSTRING_ELSE_IF(HistoryReadInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(HistoryReadRawModifiedInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(RegisterNodesInvocationError)
+        UAF_STATUS_TOSTRING_ELSE_IF(UnregisterNodesInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(ServerCouldNotHistoryReadError)
         UAF_STATUS_TOSTRING_ELSE_IF(MethodCallInvocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(AsyncMethodCallInvocationError)
@@ -407,10 +326,6 @@ namespace uaf
         UAF_STATUS_TOSTRING_ELSE_IF(CouldNotCreateClientPrivateKeyLocationError)
         UAF_STATUS_TOSTRING_ELSE_IF(CouldNotCreateClientCertificateLocationError)
 
-        else if (isUncertain())
-            return "Uncertain";
-        else if (isGood())
-            return "Good";
         else if (isBad())
             return "Bad";
         else
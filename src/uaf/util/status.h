@@ -42,19 +42,132 @@
 #include "uaf/util/errors/backwardscompatibilityerrors.h"
 
 
-#define UAF_STATUS_CONSTRUCTOR(ERROR)           \
-        Status(const uaf::ERROR& error)         \
-        : raisedBy_##ERROR(error),              \
-          statusCode(uaf::statuscodes::ERROR),  \
-          raisedBy_(NULL)                       \
-        {}                                      \
-                                                \
-        uaf::ERROR raisedBy_##ERROR;
+// For each error, a Status can be constructed from it, and it has a raisedBy_<Error> data member
+// that gives access to the error (see uaf::StatusErrorMember).
+#ifdef SWIG
+// SWIG sees the raisedBy_<Error> members as accessor methods (pyuaf turns them into attributes)
+#define UAF_STATUS_CONSTRUCTOR(ERROR)                               \
+        Status(const uaf::ERROR& error);                            \
+        uaf::ERROR raisedBy_##ERROR() const;
+#else
+#define UAF_STATUS_CONSTRUCTOR(ERROR)                               \
+        Status(const uaf::ERROR& error)                             \
+        : statusCode(uaf::statuscodes::ERROR),                      \
+          raisedBy_(NULL)                                           \
+        { error_.holder_ = new uaf::StatusErrorHolder<uaf::ERROR>(error); }
+#endif
+
+#define UAF_STATUS_ERROR_MEMBER(ERROR)                              \
+        uaf::StatusErrorMember<uaf::ERROR> raisedBy_##ERROR;
 
 
 namespace uaf
 {
 
+#ifndef SWIG
+
+    /**
+     * The error payload of a Status (for internal use only).
+     *
+     * A Status only allocates a payload if it was constructed from an error, so Good and
+     * Uncertain statuses (the vast majority) consist of just a status code and two NULL pointers.
+     */
+    class UAF_EXPORT StatusErrorHolderBase
+    {
+    public:
+        virtual ~StatusErrorHolderBase() {}
+        virtual StatusErrorHolderBase* clone() const = 0;
+    };
+
+
+    /**
+     * The error payload of a Status, holding an error of a specific type (for internal use only).
+     */
+    template<typename _Error>
+    class StatusErrorHolder : public StatusErrorHolderBase
+    {
+    public:
+        StatusErrorHolder(const _Error& error) : error(error) {}
+        StatusErrorHolderBase* clone() const { return new StatusErrorHolder<_Error>(error); }
+        _Error error;
+    };
+
+
+    /**
+     * The pointer to the error payload of a Status (for internal use only).
+     *
+     * It shares its storage with the raisedBy_<Error> members of the Status (see
+     * uaf::StatusErrorMember), so it must remain a trivial type.
+     */
+    class StatusErrorPayload
+    {
+    private:
+        friend class Status;
+        template<typename _Error> friend class StatusErrorMember;
+
+        // the error that was given when constructing the status (NULL if no error was given)
+        StatusErrorHolderBase* holder_;
+    };
+
+
+    /**
+     * A raisedBy_<Error> data member of a Status.
+     *
+     * The members don't store an error themselves (so a Status doesn't hold an instance of every
+     * error): they all share the storage of the error payload of the Status, and give access to
+     * it. Reading a member gives the error of the Status if it is of the same type, or a default
+     * error if not:
+     *
+     * @code
+     * uaf::UnknownServerError error = status.raisedBy_UnknownServerError;
+     * std::string serverUri = status.raisedBy_UnknownServerError->serverUri;
+     * @endcode
+     *
+     * Assigning an error to a member replaces the error payload of the Status (but, as before,
+     * not its status code).
+     */
+    template<typename _Error>
+    class StatusErrorMember
+    {
+    public:
+        /** Get the error. */
+        operator const _Error&() const { return get(); }
+
+        /** Get the error. */
+        const _Error& operator()() const { return get(); }
+
+        /** Access the fields of the error. */
+        const _Error* operator->() const { return &get(); }
+
+        /** Get the error. */
+        const _Error& get() const
+        {
+            // all members of the union share their address with the payload
+            const StatusErrorPayload* payload = reinterpret_cast<const StatusErrorPayload*>(this);
+            const StatusErrorHolder<_Error>* holder
+                = dynamic_cast<const StatusErrorHolder<_Error>*>(payload->holder_);
+
+            if (holder != NULL)
+                return holder->error;
+
+            static const _Error defaultError;
+            return defaultError;
+        }
+
+        /** Replace the error payload of the status. */
+        StatusErrorMember& operator=(const _Error& error)
+        {
+            StatusErrorPayload* payload = reinterpret_cast<StatusErrorPayload*>(this);
+            StatusErrorHolderBase* holder = new StatusErrorHolder<_Error>(error);
+            delete payload->holder_;
+            payload->holder_ = holder;
+            return *this;
+        }
+    };
+
+#endif /* SWIG */
+
+
     class UAF_EXPORT Status
     {
     public:
@@ -62,12 +175,12 @@ namespace uaf
         Status()
         : statusCode(uaf::statuscodes::Uncertain),
           raisedBy_(NULL)
-        {}
+        { error_.holder_ = NULL; }
 
         Status(uaf::statuscodes::StatusCode statusCode)
         : statusCode(statusCode),
           raisedBy_(NULL)
-        {}
+        { error_.holder_ = NULL; }
 
 
         /** Copy constructor.*/
@@ -166,6 +279,8 @@ namespace uaf
         UAF_STATUS_CONSTRUCTOR(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
         UAF_STATUS_CONSTRUCTOR(HistoryReadInvocationError)
         UAF_STATUS_CONSTRUCTOR(HistoryReadRawModifiedInvocationError)
+        UAF_STATUS_CONSTRUCTOR(RegisterNodesInvocationError)
+        UAF_STATUS_CONSTRUCTOR(UnregisterNodesInvocationError)
         UAF_STATUS_CONSTRUCTOR(ServerCouldNotHistoryReadError)
         UAF_STATUS_CONSTRUCTOR(MethodCallInvocationError)
         UAF_STATUS_CONSTRUCTOR(AsyncMethodCallInvocationError)
@@ -198,6 +313,121 @@ namespace uaf
         /** The UAF status code */
         uaf::statuscodes::StatusCode statusCode;
 
+#ifndef SWIG
+        /** The errors, which all share the storage of the (optional) error payload. */
+        union
+        {
+            uaf::StatusErrorPayload error_;
+            UAF_STATUS_ERROR_MEMBER(FindServersError)
+            UAF_STATUS_ERROR_MEMBER(UnknownServerError)
+            UAF_STATUS_ERROR_MEMBER(EmptyUrlError)
+            UAF_STATUS_ERROR_MEMBER(NoParallelFindServersAllowedError)
+            UAF_STATUS_ERROR_MEMBER(NoDiscoveryUrlsFoundError)
+            UAF_STATUS_ERROR_MEMBER(ServerCertificateRejectedByUserError)
+            UAF_STATUS_ERROR_MEMBER(ServerCertificateSavingError)
+            UAF_STATUS_ERROR_MEMBER(OpenSSLStoreInitializationError)
+            UAF_STATUS_ERROR_MEMBER(ClientCertificateLoadingError)
+            UAF_STATUS_ERROR_MEMBER(ServerDidNotProvideCertificateError)
+            UAF_STATUS_ERROR_MEMBER(PathNotExistsError)
+            UAF_STATUS_ERROR_MEMBER(NoSecuritySettingsGivenError)
+            UAF_STATUS_ERROR_MEMBER(PathCreationError)
+            UAF_STATUS_ERROR_MEMBER(SecuritySettingsMatchError)
+            UAF_STATUS_ERROR_MEMBER(WrongTypeError)
+            UAF_STATUS_ERROR_MEMBER(UnexpectedError)
+            UAF_STATUS_ERROR_MEMBER(ServerArrayConversionError)
+            UAF_STATUS_ERROR_MEMBER(NamespaceArrayConversionError)
+            UAF_STATUS_ERROR_MEMBER(BadNamespaceArrayError)
+            UAF_STATUS_ERROR_MEMBER(BadServerArrayError)
+            UAF_STATUS_ERROR_MEMBER(UnknownServerIndexError)
+            UAF_STATUS_ERROR_MEMBER(InvalidAddressError)
+            UAF_STATUS_ERROR_MEMBER(UnknownNamespaceUriError)
+            UAF_STATUS_ERROR_MEMBER(NoNamespaceIndexOrUriGivenError)
+            UAF_STATUS_ERROR_MEMBER(UnknownNamespaceIndexError)
+            UAF_STATUS_ERROR_MEMBER(EmptyServerUriAndUnknownNamespaceIndexError)
+            UAF_STATUS_ERROR_MEMBER(ExpandedNodeIdAddressExpectedError)
+            UAF_STATUS_ERROR_MEMBER(EmptyServerUriError)
+            UAF_STATUS_ERROR_MEMBER(UnsupportedError)
+            UAF_STATUS_ERROR_MEMBER(UnsupportedNodeIdIdentifierTypeError)
+            UAF_STATUS_ERROR_MEMBER(SyncInvocationNotSupportedError)
+            UAF_STATUS_ERROR_MEMBER(AsyncInvocationNotSupportedError)
+            UAF_STATUS_ERROR_MEMBER(NoStatusesGivenError)
+            UAF_STATUS_ERROR_MEMBER(BadStatusesPresentError)
+            UAF_STATUS_ERROR_MEMBER(NotAllTargetsCouldBeResolvedError)
+            UAF_STATUS_ERROR_MEMBER(InvalidServerUriError)
+            UAF_STATUS_ERROR_MEMBER(SubscriptionNotCreatedError)
+            UAF_STATUS_ERROR_MEMBER(NoTargetsGivenError)
+            UAF_STATUS_ERROR_MEMBER(DataDontMatchAddressesError)
+            UAF_STATUS_ERROR_MEMBER(ItemNotFoundForTheGivenHandleError)
+            UAF_STATUS_ERROR_MEMBER(TargetRankOutOfBoundsError)
+            UAF_STATUS_ERROR_MEMBER(NoItemFoundForTheGivenRequestHandleError)
+            UAF_STATUS_ERROR_MEMBER(ContinuationPointsDontMatchAddressesError)
+            UAF_STATUS_ERROR_MEMBER(UnknownNamespaceIndexAndServerIndexError)
+            UAF_STATUS_ERROR_MEMBER(AsyncMultiMethodCallNotSupportedError)
+            UAF_STATUS_ERROR_MEMBER(EmptyAddressError)
+            UAF_STATUS_ERROR_MEMBER(MultipleTranslationResultsError)
+            UAF_STATUS_ERROR_MEMBER(UnknownClientSubscriptionHandleError)
+            UAF_STATUS_ERROR_MEMBER(UnknownClientHandleError)
+            UAF_STATUS_ERROR_MEMBER(UnknownClientConnectionIdError)
+            UAF_STATUS_ERROR_MEMBER(AsyncConnectionFailedError)
+            UAF_STATUS_ERROR_MEMBER(ConnectionFailedError)
+            UAF_STATUS_ERROR_MEMBER(EmptyUserCertificateError)
+            UAF_STATUS_ERROR_MEMBER(InvalidPrivateKeyError)
+            UAF_STATUS_ERROR_MEMBER(SessionSecuritySettingsDontMatchEndpointError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotManuallyUnsubscribeError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotManuallySubscribeError)
+            UAF_STATUS_ERROR_MEMBER(SessionNotConnectedError)
+            UAF_STATUS_ERROR_MEMBER(SubscriptionHasBeenDeletedError)
+            UAF_STATUS_ERROR_MEMBER(NoDiscoveryUrlsExposedByServerError)
+            UAF_STATUS_ERROR_MEMBER(GetEndpointsError)
+            UAF_STATUS_ERROR_MEMBER(NoEndpointsProvidedByServerError)
+            UAF_STATUS_ERROR_MEMBER(DisconnectionFailedError)
+            UAF_STATUS_ERROR_MEMBER(NoConnectedSessionToUpdateArraysError)
+            UAF_STATUS_ERROR_MEMBER(BadDataReceivedError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotReadArraysError)
+            UAF_STATUS_ERROR_MEMBER(CreateMonitoredItemsError)
+            UAF_STATUS_ERROR_MEMBER(CreateMonitoredItemsInvocationError)
+            UAF_STATUS_ERROR_MEMBER(BeginCreateMonitoredItemsInvocationError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotCreateMonitoredItemsError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotBrowseNextError)
+            UAF_STATUS_ERROR_MEMBER(BrowseNextInvocationError)
+            UAF_STATUS_ERROR_MEMBER(ReadInvocationError)
+            UAF_STATUS_ERROR_MEMBER(BeginReadInvocationError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotReadError)
+            UAF_STATUS_ERROR_MEMBER(TranslateBrowsePathsToNodeIdsInvocationError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
+            UAF_STATUS_ERROR_MEMBER(HistoryReadInvocationError)
+            UAF_STATUS_ERROR_MEMBER(HistoryReadRawModifiedInvocationError)
+            UAF_STATUS_ERROR_MEMBER(RegisterNodesInvocationError)
+            UAF_STATUS_ERROR_MEMBER(UnregisterNodesInvocationError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotHistoryReadError)
+            UAF_STATUS_ERROR_MEMBER(MethodCallInvocationError)
+            UAF_STATUS_ERROR_MEMBER(AsyncMethodCallInvocationError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotCallMethodError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotBrowseError)
+            UAF_STATUS_ERROR_MEMBER(BrowseInvocationError)
+            UAF_STATUS_ERROR_MEMBER(WriteInvocationError)
+            UAF_STATUS_ERROR_MEMBER(AsyncWriteInvocationError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotWriteError)
+            UAF_STATUS_ERROR_MEMBER(CallCompleteError)
+            UAF_STATUS_ERROR_MEMBER(InputArgumentError)
+            UAF_STATUS_ERROR_MEMBER(ReadCompleteError)
+            UAF_STATUS_ERROR_MEMBER(WriteCompleteError)
+            UAF_STATUS_ERROR_MEMBER(SetPublishingModeInvocationError)
+            UAF_STATUS_ERROR_MEMBER(ServerCouldNotSetMonitoringModeError)
+            UAF_STATUS_ERROR_MEMBER(CreateSubscriptionError)
+            UAF_STATUS_ERROR_MEMBER(DeleteSubscriptionError)
+            UAF_STATUS_ERROR_MEMBER(SetMonitoringModeInvocationError)
+            UAF_STATUS_ERROR_MEMBER(DefinitionNotFoundError)
+            UAF_STATUS_ERROR_MEMBER(ConfigurationError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotCreateCertificateTrustListLocationError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotCreateCertificateRevocationListLocationError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotCreateIssuersCertificateLocationError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotCreateIssuersRevocationListLocationError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotCreateClientPrivateKeyLocationError)
+            UAF_STATUS_ERROR_MEMBER(CouldNotCreateClientCertificateLocationError)
+        };
+#endif
+
         /** Check if the Status is good/bad/uncertain/... */
         bool isUncertain()      const { return statusCode == uaf::statuscodes::Uncertain;   }
         bool isGood()           const { return statusCode == uaf::statuscodes::Good;        }
@@ -253,9 +483,11 @@ namespace uaf
         friend UAF_EXPORT bool operator<(const Status& object1, const Status& object2);
 
     private:
+        // the status that raised this status (NULL if none)
         Status* raisedBy_;
 
-        void copyErrors(const Status& from);
+        /** Delete the error payload, if any. */
+        void clearError();
     };
 }
 
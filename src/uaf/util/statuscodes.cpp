@@ -122,6 +122,8 @@ namespace uaf
                 UAF_STATUSCODES_TOSTRING(ServerCouldNotTranslateBrowsePathsToNodeIdsError)
                 UAF_STATUSCODES_TOSTRING(HistoryReadInvocationError)
                 UAF_STATUSCODES_TOSTRING(HistoryReadRawModifiedInvocationError)
+                UAF_STATUSCODES_TOSTRING(RegisterNodesInvocationError)
+                UAF_STATUSCODES_TOSTRING(UnregisterNodesInvocationError)
                 UAF_STATUSCODES_TOSTRING(ServerCouldNotHistoryReadError)
                 UAF_STATUSCODES_TOSTRING(MethodCallInvocationError)
                 UAF_STATUSCODES_TOSTRING(AsyncMethodCallInvocationError)
@@ -133,6 +133,8 @@ namespace uaf
             ServerCouldNotTranslateBrowsePathsToNodeIdsError,
             HistoryReadInvocationError,
             HistoryReadRawModifiedInvocationError,
+            RegisterNodesInvocationError,
+            UnregisterNodesInvocationError,
             ServerCouldNotHistoryReadError,
             MethodCallInvocationError,
             AsyncMethodCallInvocationError,
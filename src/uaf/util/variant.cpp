@@ -25,35 +25,237 @@ namespace uaf
     using namespace uaf;
     using std::string;
     using std::stringstream;
+    using std::vector;
+
+
+    // The native UAF values of a variant
+    // =============================================================================================
+    struct Variant::NativeValue
+    {
+        NativeValue(opcuatypes::OpcUaType dataType, bool isArray)
+        : dataType(dataType),
+          isArray(isArray)
+        {}
+
+        opcuatypes::OpcUaType   dataType;
+        bool                    isArray;
+
+        // we store them as vectors, so that they can also represent array types if necessary
+        vector<NodeId>          nodeId;
+        vector<Guid>            guid;
+        vector<ExpandedNodeId>  expandedNodeId;
+        vector<QualifiedName>   qualifiedName;
+        vector<ExtensionObject> extensionObject;
+    };
+
+
+    // Helper function: can a value of the given built-in type be stored inline?
+    // =============================================================================================
+    static bool isInlineType(OpcUa_Byte type)
+    {
+        // only types that own no memory may be stored inline (since they're copied bitwise)
+        switch (type)
+        {
+            case OpcUaType_Boolean:
+            case OpcUaType_SByte:
+            case OpcUaType_Byte:
+            case OpcUaType_Int16:
+            case OpcUaType_UInt16:
+            case OpcUaType_Int32:
+            case OpcUaType_UInt32:
+            case OpcUaType_Int64:
+            case OpcUaType_UInt64:
+            case OpcUaType_Float:
+            case OpcUaType_Double:
+            case OpcUaType_DateTime:
+            case OpcUaType_StatusCode:
+                return true;
+            default:
+                return false;
+        }
+    }
 
 
     // Constructor
     // =============================================================================================
     Variant::Variant()
-    : isNativeUaf_(false),
-      dataTypeIfNativeUaf_(opcuatypes::Null),
-      arrayTypeIfNativeUaf_(OpcUa_VariantArrayType_Scalar)
+    : storage_(Storage_Null)
     {}
 
 
     // Constructor
     // =============================================================================================
     Variant::Variant(const OpcUa_Variant& variant)
-    : uaVariant_(variant),
-      isNativeUaf_(false),
-      dataTypeIfNativeUaf_(opcuatypes::Null),
-      arrayTypeIfNativeUaf_(OpcUa_VariantArrayType_Scalar)
-    {}
+    : storage_(Storage_Null)
+    {
+        assign(variant);
+    }
+
+
+    // Copy constructor
+    // =============================================================================================
+    Variant::Variant(const Variant& other)
+    : storage_(Storage_Null)
+    {
+        copyFrom(other);
+    }
+
+
+    // Assignment operator
+    // =============================================================================================
+    Variant& Variant::operator=(const Variant& other)
+    {
+        // protect for self-assignment
+        if (&other != this)
+        {
+            clear();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+
+    // Destructor
+    // =============================================================================================
+    Variant::~Variant()
+    {
+        clear();
+    }
+
+
+    // Copy the storage of another variant
+    // =============================================================================================
+    void Variant::copyFrom(const Variant& other)
+    {
+        // inline scalars and short strings are copied bitwise
+        value_   = other.value_;
+        storage_ = other.storage_;
+
+        if (storage_ == Storage_Sdk)
+            value_.sdk = new UaVariant(*other.value_.sdk);
+        else if (storage_ == Storage_Native)
+            value_.native = new NativeValue(*other.value_.native);
+    }
+
+
+    // Check if a string contains NUL characters (which a short string can't hold)
+    // =============================================================================================
+    bool Variant::hasEmbeddedNull(const OpcUa_String* string)
+    {
+        OpcUa_UInt32 size = OpcUa_String_StrSize(string);
+        return size > 0
+            && memchr(OpcUa_String_GetRawString(string), '\0', size) != NULL;
+    }
+
+
+    // Copy a stack object, using the most compact storage
+    // =============================================================================================
+    void Variant::assign(const OpcUa_Variant& variant)
+    {
+        if (variant.Datatype == OpcUaType_Null)
+        {
+            storage_ = Storage_Null;
+        }
+        else if (variant.ArrayType == OpcUa_VariantArrayType_Scalar
+                 && isInlineType(variant.Datatype))
+        {
+            storage_ = Storage_Inline;
+            value_.scalar = variant;
+        }
+        else if (variant.ArrayType == OpcUa_VariantArrayType_Scalar
+                 && variant.Datatype == OpcUaType_String
+                 && !OpcUa_String_IsNull(&variant.Value.String)
+                 && OpcUa_String_StrSize(&variant.Value.String) < sizeof(value_.shortString)
+                 && !hasEmbeddedNull(&variant.Value.String))
+        {
+            OpcUa_String* string = (OpcUa_String*) &variant.Value.String;
+            OpcUa_UInt32 size = OpcUa_String_StrSize(string);
+
+            storage_ = Storage_ShortString;
+            memcpy(value_.shortString, OpcUa_String_GetRawString(string), size);
+            value_.shortString[size] = '\0';
+        }
+        else
+        {
+            storage_ = Storage_Sdk;
+            value_.sdk = new UaVariant(variant);
+        }
+    }
+
+
+    // Prepare the variant for an inline scalar
+    // =============================================================================================
+    OpcUa_Variant& Variant::newInlineValue(OpcUa_BuiltInType type)
+    {
+        clear();
+        storage_ = Storage_Inline;
+        OpcUa_Variant_Initialize(&value_.scalar);
+        value_.scalar.Datatype = type;
+        return value_.scalar;
+    }
+
+
+    // Prepare the variant for an SDK value
+    // =============================================================================================
+    UaVariant& Variant::newSdkValue()
+    {
+        clear();
+        storage_ = Storage_Sdk;
+        value_.sdk = new UaVariant();
+        return *value_.sdk;
+    }
+
+
+    // Prepare the variant for a native UAF value
+    // =============================================================================================
+    Variant::NativeValue& Variant::newNativeValue(opcuatypes::OpcUaType type, bool isArray)
+    {
+        clear();
+        storage_ = Storage_Native;
+        value_.native = new NativeValue(type, isArray);
+        return *value_.native;
+    }
+
+
+    // Get the value as an SDK object
+    // =============================================================================================
+    const UaVariant& Variant::sdkValue(UaVariant& temporary) const
+    {
+        switch (storage_)
+        {
+            case Storage_Sdk:
+                return *value_.sdk;
+            case Storage_Inline:
+                temporary = UaVariant(value_.scalar);
+                return temporary;
+            case Storage_ShortString:
+            {
+                // refer to the inline characters (read-only, so they are never freed by the
+                // temporary), instead of copying them into a heap allocated string
+                OpcUa_Variant variant;
+                OpcUa_Variant_Initialize(&variant);
+                variant.Datatype = OpcUaType_String;
+                OpcUa_String_AttachReadOnly(&variant.Value.String, value_.shortString);
+                temporary.attach(&variant);
+                return temporary;
+            }
+            default:
+                // native UAF values are not converted (just like null values)
+                return temporary;
+        }
+    }
 
 
     // Convert the variant to a native C++ uint8_t.
     // =============================================================================================
     Status Variant::toByteArray(std::vector<uint8_t>& vec) const
     {
+        UaVariant temporary;
+        const UaVariant& uaVariant = sdkValue(temporary);
         UaByteArray arr;
         uaf::Status ret = evaluate(
-                uaVariant_.toByteArray(arr),
-                uaVariant_.type(),
+                uaVariant.toByteArray(arr),
+                uaVariant.type(),
                 OpcUaType_Byte);
         vec.resize(arr.size());
         for (int i = 0; i < arr.size(); i++)
@@ -66,9 +268,16 @@ namespace uaf
     =========================================================================================== */ \
     Status Variant::to##XXX(CPPTYPE &val) const                                                    \
     {                                                                                              \
+        if (storage_ == Storage_Inline && value_.scalar.Datatype == OpcUaType_##XXX)               \
+        {                                                                                          \
+            val = value_.scalar.Value.XXX;                                                         \
+            return uaf::statuscodes::Good;                                                         \
+        }                                                                                          \
+        UaVariant temporary;                                                                       \
+        const UaVariant& uaVariant = sdkValue(temporary);                                          \
         return evaluate(                                                                           \
-                uaVariant_.to##XXX( (OpcUa_##XXX &) val ),                                         \
-                uaVariant_.type(),                                                                 \
+                uaVariant.to##XXX( (OpcUa_##XXX &) val ),                                          \
+                uaVariant.type(),                                                                  \
                 OpcUaType_##XXX);                                                                  \
     }
 
@@ -90,10 +299,12 @@ namespace uaf
     =========================================================================================== */ \
     Status Variant::to##XXX##Array(std::vector<CPPTYPE>& vec) const                                \
     {                                                                                              \
+        UaVariant temporary;                                                                       \
+        const UaVariant& uaVariant = sdkValue(temporary);                                          \
         Ua##XXX##Array arr;                                                                        \
         uaf::Status ret = evaluate(                                                                \
-                uaVariant_.to##XXX##Array(arr),                                                    \
-                uaVariant_.type(),                                                                 \
+                uaVariant.to##XXX##Array(arr),                                                     \
+                uaVariant.type(),                                                                  \
                 OpcUaType_##XXX);                                                                  \
         vec.resize(arr.length());                                                                  \
         for (std::size_t i = 0; i < arr.length(); i++)                                             \
@@ -119,34 +330,36 @@ namespace uaf
     Status Variant::to##XXX(uaf::XXX& val) const                                                   \
     {                                                                                              \
         uaf::Status ret;                                                                           \
-        if (isNativeUaf_)                                                                          \
+        if (storage_ == Storage_Native)                                                            \
         {                                                                                          \
-            if (dataTypeIfNativeUaf_ != uaf::opcuatypes::XXX)                                      \
+            if (value_.native->dataType != uaf::opcuatypes::XXX)                                   \
                 ret = uaf::WrongTypeError();                                                       \
-            else if (arrayTypeIfNativeUaf_ != OpcUa_VariantArrayType_Scalar)                       \
+            else if (value_.native->isArray)                                                       \
                 ret = uaf::WrongTypeError();                                                       \
-            else if (INTERNAL.size() != 1)                                                         \
+            else if (value_.native->INTERNAL.size() != 1)                                          \
                 ret = uaf::UnexpectedError("Bug: wrong size of internal vector");                  \
             else                                                                                   \
             {                                                                                      \
                 ret = uaf::statuscodes::Good;                                                      \
-                val = INTERNAL[0];                                                                 \
+                val = value_.native->INTERNAL[0];                                                  \
             }                                                                                      \
         }                                                                                          \
         else                                                                                       \
         {                                                                                          \
+            UaVariant temporary;                                                                   \
+            const UaVariant& uaVariant = sdkValue(temporary);                                      \
             Ua##XXX uaObject;                                                                      \
-            ret = evaluate(uaVariant_.to##XXX(uaObject), uaVariant_.type(), OpcUaType_##XXX);      \
+            ret = evaluate(uaVariant.to##XXX(uaObject), uaVariant.type(), OpcUaType_##XXX);        \
             val.fromSdk(uaObject);                                                                 \
         }                                                                                          \
         return ret;                                                                                \
     }
 
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(NodeId          , nodeId_)
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(Guid            , guid_)
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(ExpandedNodeId  , expandedNodeId_)
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(QualifiedName   , qualifiedName_)
-    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(ExtensionObject , extensionObject_)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(NodeId          , nodeId)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(Guid            , guid)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(ExpandedNodeId  , expandedNodeId)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(QualifiedName   , qualifiedName)
+    IMPLEMENT_VARIANT_TOXXX_METHOD_NATIVE_UAF(ExtensionObject , extensionObject)
 
 
 
@@ -156,24 +369,26 @@ namespace uaf
     uaf::Status Variant::to##XXX##Array(std::vector<uaf::XXX>& vec) const                          \
     {                                                                                              \
         uaf::Status ret;                                                                           \
-        if (isNativeUaf_)                                                                          \
+        if (storage_ == Storage_Native)                                                            \
         {                                                                                          \
-            if (dataTypeIfNativeUaf_ != uaf::opcuatypes::XXX)                                      \
+            if (value_.native->dataType != uaf::opcuatypes::XXX)                                   \
                 ret = uaf::WrongTypeError();                                                       \
-            else if (arrayTypeIfNativeUaf_ != OpcUa_VariantArrayType_Array)                        \
+            else if (!value_.native->isArray)                                                      \
                 ret = uaf::WrongTypeError();                                                       \
             else                                                                                   \
             {                                                                                      \
                 ret = uaf::statuscodes::Good;                                                      \
-                vec = INTERNAL;                                                                    \
+                vec = value_.native->INTERNAL;                                                     \
             }                                                                                      \
         }                                                                                          \
         else                                                                                       \
         {                                                                                          \
+            UaVariant temporary;                                                                   \
+            const UaVariant& uaVariant = sdkValue(temporary);                                      \
             Ua##XXX##Array arr;                                                                    \
             ret = evaluate(                                                                        \
-                    uaVariant_.to##XXX##Array(arr),                                                \
-                    uaVariant_.type(),                                                             \
+                    uaVariant.to##XXX##Array(arr),                                                 \
+                    uaVariant.type(),                                                              \
                     OpcUaType_##XXX);                                                              \
             vec.resize(arr.length());                                                              \
             for (std::size_t i = 0; i < arr.length(); i++)                                         \
@@ -182,11 +397,11 @@ namespace uaf
         return ret;                                                                                \
     }
 
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(NodeId          , nodeId_)
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(Guid            , guid_)
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(ExpandedNodeId  , expandedNodeId_)
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(QualifiedName   , qualifiedName_)
-    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(ExtensionObject , extensionObject_)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(NodeId          , nodeId)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(Guid            , guid)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(ExpandedNodeId  , expandedNodeId)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(QualifiedName   , qualifiedName)
+    IMPLEMENT_VARIANT_TOXXXARRAY_METHOD_NATIVE_UAF(ExtensionObject , extensionObject)
 
 
 
@@ -196,8 +411,7 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX(CPPTYPE val)                                                            \
     {                                                                                              \
-        clear();                                                                                   \
-        uaVariant_.set##XXX(val);                                                                  \
+        newInlineValue(OpcUaType_##XXX).Value.XXX = val;                                           \
     }
 
     IMPLEMENT_VARIANT_SETXXX_METHOD(SByte  , int8_t)
@@ -216,11 +430,10 @@ namespace uaf
     // ===========================================================================================
     void Variant::setByteArray(const std::vector<uint8_t>& vec)
     {
-        clear();
         UaByteArray arr;
         arr.resize(vec.size());
         for (std::size_t i = 0; i < vec.size(); i++) { arr[int(i)] = vec[i]; }
-        uaVariant_.setByteArray(arr);
+        newSdkValue().setByteArray(arr);
     }
 
 
@@ -229,11 +442,10 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX##Array(const std::vector<CPPTYPE>& vec)                                 \
     {                                                                                              \
-        clear();                                                                                   \
         Ua##XXX##Array arr;                                                                        \
         arr.create(vec.size());                                                                    \
         for (std::size_t i = 0; i < vec.size(); i++) { arr[i] = vec[i]; }                          \
-        uaVariant_.set##XXX##Array(arr);                                                           \
+        newSdkValue().set##XXX##Array(arr);                                                        \
     }
 
     IMPLEMENT_VARIANT_SETXXXARRAY_METHOD(SByte  , int8_t)
@@ -247,12 +459,133 @@ namespace uaf
     IMPLEMENT_VARIANT_SETXXXARRAY_METHOD(Double , double)
 
 
+
+#define IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(XXX, CPPTYPE)                                      \
+    /** Get a read-only view on the array of the variant.                                         \
+    =========================================================================================== */ \
+    Status Variant::to##XXX##ArrayView(uaf::ArrayView<CPPTYPE>& view) const                        \
+    {                                                                                              \
+        const OpcUa_Variant* variant = sdkArray(OpcUaType_##XXX);                                  \
+        if (variant == NULL)                                                                       \
+        {                                                                                          \
+            view = uaf::ArrayView<CPPTYPE>();                                                      \
+            return arrayViewError(OpcUaType_##XXX);                                                \
+        }                                                                                          \
+        view = uaf::ArrayView<CPPTYPE>((const CPPTYPE*) variant->Value.Array.Value.XXX##Array,     \
+                                       variant->Value.Array.Length);                               \
+        return uaf::statuscodes::Good;                                                             \
+    }
+
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(SByte  , int8_t)
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(Int16  , int16_t)
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(UInt16 , uint16_t)
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(Int32  , int32_t)
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(UInt32 , uint32_t)
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(Int64  , int64_t)
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(UInt64 , uint64_t)
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(Float  , float)
+    IMPLEMENT_VARIANT_TOXXXARRAYVIEW_METHOD(Double , double)
+
+
+    // Get a read-only view on the byte array of the variant.
+    // =============================================================================================
+    Status Variant::toByteArrayView(uaf::ArrayView<uint8_t>& view) const
+    {
+        // just like toByteArray(), we also accept a ByteString
+        if (    storage_ == Storage_Sdk
+             && value_.sdk->type() == OpcUaType_ByteString
+             && !value_.sdk->isArray())
+        {
+            const OpcUa_Variant* variant = *value_.sdk;
+            const OpcUa_ByteString& byteString = variant->Value.ByteString;
+            view = uaf::ArrayView<uint8_t>((const uint8_t*) byteString.Data,
+                                           byteString.Length > 0 ? byteString.Length : 0);
+            return uaf::statuscodes::Good;
+        }
+
+        const OpcUa_Variant* variant = sdkArray(OpcUaType_Byte);
+        if (variant == NULL)
+        {
+            view = uaf::ArrayView<uint8_t>();
+            return arrayViewError(OpcUaType_Byte);
+        }
+        view = uaf::ArrayView<uint8_t>((const uint8_t*) variant->Value.Array.Value.ByteArray,
+                                       variant->Value.Array.Length);
+        return uaf::statuscodes::Good;
+    }
+
+
+#define IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(XXX, CPPTYPE)                                       \
+    /** Set the variant to an array, by taking ownership of the given buffer.                     \
+    =========================================================================================== */ \
+    void Variant::adopt##XXX##Array(CPPTYPE* data, uint32_t length)                                \
+    {                                                                                              \
+        OpcUa_Variant variant;                                                                     \
+        OpcUa_Variant_Initialize(&variant);                                                        \
+        variant.Datatype                     = OpcUaType_##XXX;                                    \
+        variant.ArrayType                    = OpcUa_VariantArrayType_Array;                       \
+        variant.Value.Array.Length           = OpcUa_Int32(length);                                \
+        variant.Value.Array.Value.XXX##Array = (OpcUa_##XXX*) data;                                \
+        newSdkValue().attach(&variant);                                                            \
+    }
+
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(SByte  , int8_t)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(Byte   , uint8_t)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(Int16  , int16_t)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(UInt16 , uint16_t)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(Int32  , int32_t)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(UInt32 , uint32_t)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(Int64  , int64_t)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(UInt64 , uint64_t)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(Float  , float)
+    IMPLEMENT_VARIANT_ADOPTXXXARRAY_METHOD(Double , double)
+
+
+    // Get the stack object of an SDK array of the given type
+    // =============================================================================================
+    const OpcUa_Variant* Variant::sdkArray(OpcUa_BuiltInType type) const
+    {
+        if (storage_ != Storage_Sdk)
+            return NULL;
+
+        const OpcUa_Variant* variant = *value_.sdk;
+
+        if (    variant->Datatype != type
+             || variant->ArrayType != OpcUa_VariantArrayType_Array
+             || variant->Value.Array.Length < 0)
+            return NULL;
+        else
+            return variant;
+    }
+
+
+    // Create the error for a view that could not be made
+    // =============================================================================================
+    Status Variant::arrayViewError(OpcUa_BuiltInType type) const
+    {
+        return uaf::WrongTypeError(
+                uaf::format(
+                    "Cannot view the %s%s as a %s array",
+                    opcuatypes::toString(this->type()).c_str(),
+                    isArray() ? " array" : "",
+                    opcuatypes::toString(opcuatypes::fromSdkToUaf(type)).c_str()));
+    }
+
+
     // Convert the variant to a bool.
     // =============================================================================================
     Status Variant::toBoolean(bool &val) const
     {
+        if (storage_ == Storage_Inline && value_.scalar.Datatype == OpcUaType_Boolean)
+        {
+            val = (bool)(value_.scalar.Value.Boolean);
+            return uaf::statuscodes::Good;
+        }
+
+        UaVariant temporary;
+        const UaVariant& uaVariant = sdkValue(temporary);
         OpcUa_Boolean opcUaVal;
-        Status ret = evaluate(uaVariant_.toBool(opcUaVal), uaVariant_.type(), OpcUaType_Boolean);
+        Status ret = evaluate(uaVariant.toBool(opcUaVal), uaVariant.type(), OpcUaType_Boolean);
         val = (bool)(opcUaVal);
         return ret;
     }
@@ -261,8 +594,10 @@ namespace uaf
     // =============================================================================================
     Status Variant::toBooleanArray(std::vector<bool>& vec) const
     {
+        UaVariant temporary;
+        const UaVariant& uaVariant = sdkValue(temporary);
         UaBoolArray arr;
-        uaf::Status ret = evaluate(uaVariant_.toBoolArray(arr), uaVariant_.type(), OpcUaType_Boolean);
+        uaf::Status ret = evaluate(uaVariant.toBoolArray(arr), uaVariant.type(), OpcUaType_Boolean);
         vec.resize(arr.length());
         for (std::size_t i = 0; i < arr.length(); i++)
             vec[i] = arr[i];
@@ -273,19 +608,17 @@ namespace uaf
     // =============================================================================================
     void Variant::setBoolean(bool val)
     {
-        clear();
-        uaVariant_.setBool(val ? OpcUa_True : OpcUa_False);
+        newInlineValue(OpcUaType_Boolean).Value.Boolean = (val ? OpcUa_True : OpcUa_False);
     }
 
     // Set the variant to a boolean array.
     // =============================================================================================
     void Variant::setBooleanArray(const std::vector<bool>& vec)
     {
-        clear();
         UaBoolArray arr;
         arr.create(vec.size());
         for (std::size_t i = 0; i < vec.size(); i++) { arr[i] = vec[i]; }
-        uaVariant_.setBoolArray(arr);
+        newSdkValue().setBoolArray(arr);
     }
 
 
@@ -294,15 +627,24 @@ namespace uaf
     // =============================================================================================
     Status Variant::toString(string &val) const
     {
-        if (uaVariant_.isEmpty())
+        if (storage_ == Storage_ShortString)
+        {
+            val = value_.shortString;
+            return uaf::statuscodes::Good;
+        }
+
+        UaVariant temporary;
+        const UaVariant& uaVariant = sdkValue(temporary);
+
+        if (uaVariant.isEmpty())
             val = string();
         else
         {
-            UaString uaString(uaVariant_.toString());
+            UaString uaString(uaVariant.toString());
             if (uaString.isEmpty() || uaString.isNull())
                 val = string();
             else
-                val = uaVariant_.toString().toUtf8();
+                val = uaString.toUtf8();
         }
 
 
@@ -314,8 +656,10 @@ namespace uaf
     // =============================================================================================
     Status Variant::toStringArray(std::vector<std::string>& vec) const
     {
+        UaVariant temporary;
+        const UaVariant& uaVariant = sdkValue(temporary);
         UaStringArray arr;
-        Status ret = evaluate(uaVariant_.toStringArray(arr), uaVariant_.type(), OpcUaType_String);
+        Status ret = evaluate(uaVariant.toStringArray(arr), uaVariant.type(), OpcUaType_String);
         vec.resize(arr.length());
         for (std::size_t i = 0; i < arr.length(); i++)
         {
@@ -334,8 +678,16 @@ namespace uaf
     // =============================================================================================
     void Variant::setString(const std::string& val)
     {
-        clear();
-        uaVariant_.setString(UaString(val.c_str()));
+        if (val.size() < sizeof(value_.shortString) && val.find('\0') == string::npos)
+        {
+            clear();
+            storage_ = Storage_ShortString;
+            memcpy(value_.shortString, val.c_str(), val.size() + 1);
+        }
+        else
+        {
+            newSdkValue().setString(UaString(val.c_str()));
+        }
     }
 
 
@@ -343,11 +695,19 @@ namespace uaf
     // =============================================================================================
     void Variant::setStringArray(const std::vector<std::string>& vec)
     {
-        clear();
         UaStringArray arr;
         arr.create(vec.size());
         for (std::size_t i = 0; i < vec.size(); i++) { UaString(vec[i].c_str()).copyTo(&arr[i]); }
-        uaVariant_.setStringArray(arr);
+        newSdkValue().setStringArray(arr);
+    }
+
+
+    // Set the variant to a bytestring.
+    // =============================================================================================
+    void Variant::setByteString(uint8_t* data, int32_t length)
+    {
+        UaByteString byteString(length, data);
+        newSdkValue().setByteString(byteString, OpcUa_True);
     }
 
 
@@ -356,8 +716,10 @@ namespace uaf
     =========================================================================================== */ \
     Status Variant::to##XXX(uaf::XXX& val) const                                                   \
     {                                                                                              \
+        UaVariant temporary;                                                                       \
+        const UaVariant& uaVariant = sdkValue(temporary);                                          \
         Ua##XXX ua##XXX;                                                                           \
-        Status ret = evaluate(uaVariant_.to##XXX(ua##XXX), uaVariant_.type(), OpcUaType_##XXX);    \
+        Status ret = evaluate(uaVariant.to##XXX(ua##XXX), uaVariant.type(), OpcUaType_##XXX);      \
         val.fromSdk(ua##XXX);                                                                      \
         return ret;                                                                                \
     }
@@ -373,8 +735,10 @@ namespace uaf
     =========================================================================================== */ \
     Status Variant::to##XXX##Array(std::vector<uaf::XXX>& vec) const                               \
     {                                                                                              \
+        UaVariant temporary;                                                                       \
+        const UaVariant& uaVariant = sdkValue(temporary);                                          \
         Ua##XXX##Array arr;                                                                        \
-        Status ret = evaluate(uaVariant_.to##XXX##Array(arr), uaVariant_.type(), OpcUaType_##XXX); \
+        Status ret = evaluate(uaVariant.to##XXX##Array(arr), uaVariant.type(), OpcUaType_##XXX);   \
         vec.resize(arr.length());                                                                  \
         for (std::size_t i = 0; i < arr.length(); i++)                                             \
             vec[i].fromSdk(Ua##XXX(arr[i]));                                                       \
@@ -391,10 +755,9 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX(const uaf::XXX& val)                                                    \
     {                                                                                              \
-        clear();                                                                                   \
         Ua##XXX uaObject;                                                                          \
         val.toSdk(uaObject);                                                                       \
-        uaVariant_.set##XXX(uaObject, OpcUa_True);                                                 \
+        newSdkValue().set##XXX(uaObject, OpcUa_True);                                              \
     }
     IMPLEMENT_VARIANT_SETXXX_METHOD_COMPLEX_WITH_DETACH(ByteString)
 
@@ -404,25 +767,31 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX(const uaf::XXX& val)                                                    \
     {                                                                                              \
-        clear();                                                                                   \
         Ua##XXX uaObject;                                                                          \
         val.toSdk(uaObject);                                                                       \
-        uaVariant_.set##XXX(uaObject);                                                             \
+        newSdkValue().set##XXX(uaObject);                                                          \
     }
     IMPLEMENT_VARIANT_SETXXX_METHOD_COMPLEX(LocalizedText)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_COMPLEX(DateTime)
+
+
+    // Set the variant to a date time.
+    // =============================================================================================
+    void Variant::setDateTime(const uaf::DateTime& val)
+    {
+        // a date time owns no memory, so it can be stored inline
+        val.toSdk(&newInlineValue(OpcUaType_DateTime).Value.DateTime);
+    }
 
 
 #define IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_COMPLEX(XXX)                                          \
     /** Convert the variant to a complex native C++ type.                                          \
     =========================================================================================== */ \
-    void Variant::set##XXX##Array(const std::vector<uaf::XXX>& vec)                                         \
+    void Variant::set##XXX##Array(const std::vector<uaf::XXX>& vec)                                \
     {                                                                                              \
-        clear();                                                                                   \
         Ua##XXX##Array arr;                                                                        \
         arr.create(vec.size());                                                                    \
         for (std::size_t i = 0; i < vec.size(); i++) { vec[i].toSdk(&arr[i]); }                    \
-        uaVariant_.set##XXX##Array(arr);                                                           \
+        newSdkValue().set##XXX##Array(arr);                                                        \
     }
     IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_COMPLEX(ByteString)
     IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_COMPLEX(LocalizedText)
@@ -434,16 +803,13 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX(const uaf::XXX& val)                                                    \
     {                                                                                              \
-        clear();                                                                                   \
-        isNativeUaf_ = true;                                                                       \
-        dataTypeIfNativeUaf_  = uaf::opcuatypes::XXX;                                              \
-        INTERNAL.push_back(val);                                                                   \
+        newNativeValue(uaf::opcuatypes::XXX, false).INTERNAL.push_back(val);                       \
     }
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(QualifiedName, qualifiedName_)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(NodeId, nodeId_)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(Guid, guid_)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(ExpandedNodeId, expandedNodeId_)
-    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(ExtensionObject, extensionObject_)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(QualifiedName, qualifiedName)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(NodeId, nodeId)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(Guid, guid)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(ExpandedNodeId, expandedNodeId)
+    IMPLEMENT_VARIANT_SETXXX_METHOD_NATIVE_UAF(ExtensionObject, extensionObject)
 
 
 #define IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(XXX, INTERNAL)                             \
@@ -451,17 +817,13 @@ namespace uaf
     =========================================================================================== */ \
     void Variant::set##XXX##Array(const std::vector<uaf::XXX>& vec)                                \
     {                                                                                              \
-        clear();                                                                                   \
-        isNativeUaf_ = true;                                                                       \
-        dataTypeIfNativeUaf_  = uaf::opcuatypes::XXX;                                              \
-        arrayTypeIfNativeUaf_ = OpcUa_VariantArrayType_Array;                                      \
-        INTERNAL = vec;                                                                            \
+        newNativeValue(uaf::opcuatypes::XXX, true).INTERNAL = vec;                                 \
     }
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(QualifiedName, qualifiedName_)
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(NodeId, nodeId_)
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(Guid, guid_)
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(ExpandedNodeId, expandedNodeId_)
-    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(ExtensionObject, extensionObject_)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(QualifiedName, qualifiedName)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(NodeId, nodeId)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(Guid, guid)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(ExpandedNodeId, expandedNodeId)
+    IMPLEMENT_VARIANT_SETXXXARRAY_METHOD_NATIVE_UAF(ExtensionObject, extensionObject)
 
 
     // Get a string representation
@@ -485,8 +847,10 @@ namespace uaf
         }
         else
         {
-            if (isNativeUaf_)
+            if (storage_ == Storage_Native)
             {
+                const NativeValue& native = *value_.native;
+
                 if (isArray())
                 {
                     ss << "{";
@@ -498,19 +862,19 @@ namespace uaf
                         switch (t)
                         {
                             case uaf::opcuatypes::NodeId:
-                                ss << nodeId_[i].toString();
+                                ss << native.nodeId[i].toString();
                                 break;
                             case uaf::opcuatypes::Guid:
-                                ss << guid_[i].toString();
+                                ss << native.guid[i].toString();
                                 break;
                             case uaf::opcuatypes::ExpandedNodeId:
-                                ss << expandedNodeId_[i].toString();
+                                ss << native.expandedNodeId[i].toString();
                                 break;
                             case uaf::opcuatypes::QualifiedName:
-                                ss << qualifiedName_[i].toString();
+                                ss << native.qualifiedName[i].toString();
                                 break;
                             case uaf::opcuatypes::ExtensionObject:
-                                ss << '\n' << extensionObject_[i].toString(indent, colon);
+                                ss << '\n' << native.extensionObject[i].toString(indent, colon);
                                 break;
                             default:
                                 ss << "INVALID";
@@ -525,19 +889,19 @@ namespace uaf
                     switch (t)
                     {
                         case uaf::opcuatypes::NodeId:
-                            ss << nodeId_[0].toString();
+                            ss << native.nodeId[0].toString();
                             break;
                         case uaf::opcuatypes::Guid:
-                            ss << guid_[0].toString();
+                            ss << native.guid[0].toString();
                             break;
                         case uaf::opcuatypes::ExpandedNodeId:
-                            ss << expandedNodeId_[0].toString();
+                            ss << native.expandedNodeId[0].toString();
                             break;
                         case uaf::opcuatypes::QualifiedName:
-                            ss << qualifiedName_[0].toString();
+                            ss << native.qualifiedName[0].toString();
                             break;
                         case uaf::opcuatypes::ExtensionObject:
-                            ss << '\n' << extensionObject_[0].toString(indent, colon);
+                            ss << '\n' << native.extensionObject[0].toString(indent, colon);
                             break;
                         default:
                             ss << "INVALID";
@@ -545,15 +909,22 @@ namespace uaf
                     }
                 }
             }
+            else if (storage_ == Storage_ShortString)
+            {
+                ss << value_.shortString;
+            }
             else
             {
-                if (uaVariant_.isEmpty())
+                UaVariant temporary;
+                const UaVariant& uaVariant = sdkValue(temporary);
+
+                if (uaVariant.isEmpty())
                 {
                     ss << "";
                 }
                 else
                 {
-                    UaString uaString(uaVariant_.toString());
+                    UaString uaString(uaVariant.toString());
                     if (uaString.isNull())
                         ss << "NULL";
                     else if (uaString.isEmpty())
@@ -604,38 +975,49 @@ namespace uaf
 
 
 
+    // Convert a native UAF value to an SDK object
+    // =============================================================================================
+    void Variant::nativeValueToSdk(UaVariant& uaVariant) const
+    {
+        const NativeValue& native = *value_.native;
+
+        if (native.dataType == uaf::opcuatypes::NodeId)
+        {
+            IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(NodeId, native.nodeId)
+        }
+        else if (native.dataType == uaf::opcuatypes::Guid)
+        {
+            IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(Guid, native.guid)
+        }
+        else if (native.dataType == uaf::opcuatypes::ExpandedNodeId)
+        {
+            IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(ExpandedNodeId, native.expandedNodeId)
+        }
+        else if (native.dataType == uaf::opcuatypes::QualifiedName)
+        {
+            IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(QualifiedName, native.qualifiedName)
+        }
+        else if (native.dataType == uaf::opcuatypes::ExtensionObject)
+        {
+            IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF_WITH_DETACH(ExtensionObject, native.extensionObject)
+        }
+    }
+
+
     // toSdk
     // =============================================================================================
     void Variant::toSdk(OpcUa_Variant* destination) const
     {
-        if (isNativeUaf_)
+        if (storage_ == Storage_Native)
         {
             UaVariant uaVariant;
-            if (type() == uaf::opcuatypes::NodeId)
-            {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(NodeId, nodeId_)
-            }
-            else if (type() == uaf::opcuatypes::Guid)
-            {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(Guid, guid_)
-            }
-            else if (type() == uaf::opcuatypes::ExpandedNodeId)
-            {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(ExpandedNodeId, expandedNodeId_)
-            }
-            else if (type() == uaf::opcuatypes::QualifiedName)
-            {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF(QualifiedName, qualifiedName_)
-            }
-            else if (type() == uaf::opcuatypes::ExtensionObject)
-            {
-                IMPLEMENT_VARIANT_TOSDK_NATIVE_UAF_WITH_DETACH(ExtensionObject, extensionObject_)
-            }
+            nativeValueToSdk(uaVariant);
             uaVariant.copyTo(destination);
         }
         else
         {
-            uaVariant_.copyTo(destination);
+            UaVariant temporary;
+            sdkValue(temporary).copyTo(destination);
         }
     }
 
@@ -644,7 +1026,16 @@ namespace uaf
     // =============================================================================================
     void Variant::toSdk(UaVariant& uaVariant) const
     {
-    	uaVariant = uaVariant_;
+        if (storage_ == Storage_Native)
+        {
+            uaVariant.clear();
+            nativeValueToSdk(uaVariant);
+        }
+        else
+        {
+            UaVariant temporary;
+            uaVariant = sdkValue(temporary);
+        }
     }
 
 
@@ -652,7 +1043,8 @@ namespace uaf
     // =============================================================================================
     void Variant::fromSdk(const UaVariant& uaVariant)
     {
-    	uaVariant_ = uaVariant;
+        clear();
+        assign(*((const OpcUa_Variant*)uaVariant));
     }
 
 
@@ -730,15 +1122,23 @@ namespace uaf
     // =============================================================================================
     void Variant::clear()
     {
-        uaVariant_.clear();
-        nodeId_.clear();
-        guid_.clear();
-        expandedNodeId_.clear();
-        qualifiedName_.clear();
-        extensionObject_.clear();
-        isNativeUaf_ = false;
-        dataTypeIfNativeUaf_ = opcuatypes::Null;
-        arrayTypeIfNativeUaf_ = OpcUa_VariantArrayType_Scalar;
+        if (storage_ == Storage_Sdk)
+            delete value_.sdk;
+        else if (storage_ == Storage_Native)
+            delete value_.native;
+
+        storage_ = Storage_Null;
+    }
+
+
+    // Is the variant empty?
+    // =============================================================================================
+    bool Variant::isNull() const
+    {
+        if (storage_ == Storage_Sdk)
+            return (bool)(value_.sdk->isEmpty());
+        else
+            return storage_ == Storage_Null;
     }
 
 
@@ -746,10 +1146,19 @@ namespace uaf
     // =============================================================================================
     opcuatypes::OpcUaType Variant::type() const
     {
-        if (isNativeUaf_)
-            return dataTypeIfNativeUaf_;
-        else
-            return uaf::opcuatypes::fromSdkToUaf(uaVariant_.type());
+        switch (storage_)
+        {
+            case Storage_Inline:
+                return uaf::opcuatypes::fromSdkToUaf(OpcUa_BuiltInType(value_.scalar.Datatype));
+            case Storage_ShortString:
+                return uaf::opcuatypes::String;
+            case Storage_Sdk:
+                return uaf::opcuatypes::fromSdkToUaf(value_.sdk->type());
+            case Storage_Native:
+                return value_.native->dataType;
+            default:
+                return uaf::opcuatypes::Null;
+        }
     }
 
 
@@ -757,10 +1166,12 @@ namespace uaf
     // =============================================================================================
     bool Variant::isArray() const
     {
-        if (isNativeUaf_)
-            return arrayTypeIfNativeUaf_ == OpcUa_VariantArrayType_Array;
+        if (storage_ == Storage_Native)
+            return value_.native->isArray;
+        else if (storage_ == Storage_Sdk)
+            return (bool)(value_.sdk->isArray());
         else
-            return (bool)(uaVariant_.isArray());
+            return false;
     }
 
 
@@ -768,26 +1179,29 @@ namespace uaf
     // =============================================================================================
     uint32_t Variant::arraySize() const
     {
-        if (isNativeUaf_)
+        if (storage_ == Storage_Native)
         {
             switch (type())
             {
                 case uaf::opcuatypes::NodeId:
-                    return nodeId_.size();
+                    return value_.native->nodeId.size();
                 case uaf::opcuatypes::Guid:
-                    return guid_.size();
+                    return value_.native->guid.size();
                 case uaf::opcuatypes::ExpandedNodeId:
-                    return expandedNodeId_.size();
+                    return value_.native->expandedNodeId.size();
                 case uaf::opcuatypes::QualifiedName:
-                    return qualifiedName_.size();
+                    return value_.native->qualifiedName.size();
                 case uaf::opcuatypes::ExtensionObject:
-                    return extensionObject_.size();
+                    return value_.native->extensionObject.size();
                 default:
                     return -1;
             }
         }
         else
-            return uaVariant_.arraySize();
+        {
+            UaVariant temporary;
+            return sdkValue(temporary).arraySize();
+        }
     }
 
 
@@ -795,22 +1209,36 @@ namespace uaf
     // =============================================================================================
     bool operator==(const Variant& object1, const Variant& object2)
     {
+        bool isNative1 = object1.storage_ == Variant::Storage_Native;
+        bool isNative2 = object2.storage_ == Variant::Storage_Native;
+
         // first we test the most likely situation
-        if ( (!object1.isNativeUaf_) && (!object2.isNativeUaf_) )
+        if ( (!isNative1) && (!isNative2) )
         {
-            return object1.uaVariant_ == object2.uaVariant_;
+            // short strings can be compared without converting them
+            if (    object1.storage_ == Variant::Storage_ShortString
+                 && object2.storage_ == Variant::Storage_ShortString)
+                return strcmp(object1.value_.shortString, object2.value_.shortString) == 0;
+
+            UaVariant temporary1, temporary2;
+            return object1.sdkValue(temporary1) == object2.sdkValue(temporary2);
         }
         // else, test the whole lot
+        else if (isNative1 && isNative2)
+        {
+            const Variant::NativeValue& native1 = *object1.value_.native;
+            const Variant::NativeValue& native2 = *object2.value_.native;
+
+            return    native1.isArray == native2.isArray
+                   && native1.dataType == native2.dataType
+                   && native1.expandedNodeId == native2.expandedNodeId
+                   && native1.nodeId == native2.nodeId
+                   && native1.guid == native2.guid
+                   && native1.qualifiedName == native2.qualifiedName;
+        }
         else
         {
-            return    object1.uaVariant_ == object2.uaVariant_
-                   && object1.isNativeUaf_ == object2.isNativeUaf_
-                   && object1.arrayTypeIfNativeUaf_ == object2.arrayTypeIfNativeUaf_
-                   && object1.dataTypeIfNativeUaf_ == object2.dataTypeIfNativeUaf_
-                   && object1.expandedNodeId_ == object2.expandedNodeId_
-                   && object1.nodeId_ == object2.nodeId_
-                   && object1.guid_ == object2.guid_
-                   && object1.qualifiedName_ == object2.qualifiedName_;
+            return false;
         }
     }
 
@@ -826,22 +1254,33 @@ namespace uaf
     // =============================================================================================
     bool operator<(const Variant& object1, const Variant& object2)
     {
-        if (object1.uaVariant_ != object2.uaVariant_)
-            return object1.uaVariant_ < object2.uaVariant_;
-        else if (object1.isNativeUaf_ != object2.isNativeUaf_)
-            return object1.isNativeUaf_ < object2.isNativeUaf_;
-        else if (object1.arrayTypeIfNativeUaf_ != object2.arrayTypeIfNativeUaf_)
-            return object1.arrayTypeIfNativeUaf_ < object2.arrayTypeIfNativeUaf_;
-        else if (object1.dataTypeIfNativeUaf_ != object2.dataTypeIfNativeUaf_)
-            return object1.dataTypeIfNativeUaf_ < object2.dataTypeIfNativeUaf_;
-        else if (object1.expandedNodeId_ != object2.expandedNodeId_)
-            return object1.expandedNodeId_ < object2.expandedNodeId_;
-        else if (object1.nodeId_ != object2.nodeId_)
-            return object1.nodeId_ < object2.nodeId_;
-        else if (object1.guid_ != object2.guid_)
-            return object1.guid_ < object2.guid_;
+        bool isNative1 = object1.storage_ == Variant::Storage_Native;
+        bool isNative2 = object2.storage_ == Variant::Storage_Native;
+
+        // native UAF values are ordered after all other values
+        if (isNative1 != isNative2)
+            return isNative1 < isNative2;
+        else if (!isNative1)
+        {
+            UaVariant temporary1, temporary2;
+            return object1.sdkValue(temporary1) < object2.sdkValue(temporary2);
+        }
+
+        const Variant::NativeValue& native1 = *object1.value_.native;
+        const Variant::NativeValue& native2 = *object2.value_.native;
+
+        if (native1.isArray != native2.isArray)
+            return native1.isArray < native2.isArray;
+        else if (native1.dataType != native2.dataType)
+            return native1.dataType < native2.dataType;
+        else if (native1.expandedNodeId != native2.expandedNodeId)
+            return native1.expandedNodeId < native2.expandedNodeId;
+        else if (native1.nodeId != native2.nodeId)
+            return native1.nodeId < native2.nodeId;
+        else if (native1.guid != native2.guid)
+            return native1.guid < native2.guid;
         else
-            return object1.qualifiedName_ < object2.qualifiedName_;
+            return native1.qualifiedName < native2.qualifiedName;
     }
 
 
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <vector>
 #include <cctype>
+#include <cstring>
 #include <stdint.h>
 #include <stdio.h>
 #include <iostream>
@@ -35,6 +36,7 @@
 // UAF
 #include "uaf/util/util.h"
 #include "uaf/util/status.h"
+#include "uaf/util/arrayview.h"
 #include "uaf/util/datetime.h"
 #include "uaf/util/bytestring.h"
 #include "uaf/util/opcuatypes.h"
@@ -61,6 +63,10 @@ namespace uaf
     * A variant can hold primitive types and some OPC UA related non-primitive types (such as a
     * NodeId).
     *
+    * Scalars that don't own any memory (numbers, booleans, date times, ...) and short strings are
+    * stored inside the variant itself, so creating and copying them never allocates memory.
+    * Only arrays, long strings and complex types are allocated on the heap.
+    *
     * @ingroup Util
     ***********************************************************************************************/
     class UAF_EXPORT Variant
@@ -80,6 +86,24 @@ namespace uaf
         Variant(const OpcUa_Variant &variant);
 
 
+        /**
+         * Construct a copy of another variant.
+         */
+        Variant(const Variant& other);
+
+
+        /**
+         * Copy the contents of another variant.
+         */
+        Variant& operator=(const Variant& other);
+
+
+        /**
+         * Destruct the variant.
+         */
+        ~Variant();
+
+
         /**
          * Clear the variant.
          */
@@ -91,7 +115,7 @@ namespace uaf
          *
          * @return  True if empty.
          */
-        bool isNull() const { return (!isNativeUaf_) && ((bool)(uaVariant_.isEmpty())); }
+        bool isNull() const;
 
 
         /**
@@ -170,18 +194,48 @@ namespace uaf
         DECLARE_VARIANT_METHODS(ExtensionObject , uaf::ExtensionObject, const uaf::ExtensionObject&)
 
 
+#define DECLARE_VARIANT_ARRAYVIEW_METHODS(XXX, TYPE)                                               \
+        /** Get a read-only view on the array of the variant, without copying it.                  \
+         *                                                                                         \
+         * The view is only valid as long as the variant is not modified or destroyed.             \
+         * Unlike to##XXX##Array(), no conversions are done: the variant must hold an array of     \
+         * exactly this type.                                                                      \
+         *                                                                                         \
+         * @param view  View to update.                                                            \
+         * @return      Status of the operation.                                                   \
+         */                                                                                        \
+        uaf::Status to##XXX##ArrayView(uaf::ArrayView<TYPE>& view) const;                          \
+                                                                                                   \
+        /** Set the variant to an array, by taking ownership of the given buffer (no copy is made).\
+         *                                                                                         \
+         * The buffer must have been allocated by uaf::allocateArray() (or OpcUa_Alloc()), and     \
+         * must not be used anymore by the caller afterwards.                                      \
+         *                                                                                         \
+         * @param data      The buffer to adopt.                                                   \
+         * @param length    The number of elements in the buffer.                                  \
+         */                                                                                        \
+        void adopt##XXX##Array(TYPE* data, uint32_t length);
+
+
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(SByte  , int8_t)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(Byte   , uint8_t)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(Int16  , int16_t)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(UInt16 , uint16_t)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(Int32  , int32_t)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(UInt32 , uint32_t)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(Int64  , int64_t)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(UInt64 , uint64_t)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(Float  , float)
+        DECLARE_VARIANT_ARRAYVIEW_METHODS(Double , double)
+
+
         /**
          * Set the variant to a bytestring.
          *
          * @param data The data.
          * @param length Lenght of the data.
          */
-        void setByteString(uint8_t* data, int32_t length)
-        {
-            clear();
-            UaByteString byteString(length, data);
-            uaVariant_.setByteString(byteString, OpcUa_True);
-        }
+        void setByteString(uint8_t* data, int32_t length);
 
 
         /**
@@ -251,22 +305,137 @@ namespace uaf
 
     private:
 
-        // internal SDK object - used for everything but the ones hereafter
-        UaVariant uaVariant_;
+        /**
+         * The ways in which the value of a variant can be stored.
+         */
+        enum Storage
+        {
+            /** No value ("empty"). */
+            Storage_Null,
+            /** A scalar that owns no memory (a number, a boolean, ...), stored in value_.scalar. */
+            Storage_Inline,
+            /** A string without NUL characters that fits in value_.shortString. */
+            Storage_ShortString,
+            /** Any other SDK value (arrays, long strings, ...), stored in a heap allocated
+             *  UaVariant. */
+            Storage_Sdk,
+            /** A native UAF value (scalar or array), stored in a heap allocated NativeValue. */
+            Storage_Native
+        };
 
         // variant types that must be stored as a native UAF instance
         // (because these support namespace URIs and/or server URIs instead of only
         //  namespace IDs and/or server IDs)
-        // We store them as vectors, so that they can also represent array types if necessary.
-        std::vector<uaf::NodeId> nodeId_;
-        std::vector<uaf::Guid> guid_;
-        std::vector<uaf::ExpandedNodeId> expandedNodeId_;
-        std::vector<uaf::QualifiedName> qualifiedName_;
-        std::vector<uaf::ExtensionObject> extensionObject_;
-
-        bool isNativeUaf_;
-        uaf::opcuatypes::OpcUaType dataTypeIfNativeUaf_;
-        OpcUa_Byte arrayTypeIfNativeUaf_;
+        struct NativeValue;
+
+        /**
+         * The value of the variant: which member is valid depends on the storage_.
+         */
+        union Value
+        {
+            OpcUa_Variant   scalar;
+            char            shortString[sizeof(OpcUa_Variant)];
+            UaVariant*      sdk;
+            NativeValue*    native;
+        };
+
+        // the kind of storage that is currently used
+        Storage storage_;
+
+        // the value of the variant
+        Value value_;
+
+
+        /**
+         * Clear the variant and prepare it for an inline scalar.
+         *
+         * @param type  The built-in type of the scalar.
+         * @return      The (initialized) stack object to store the scalar in.
+         */
+        OpcUa_Variant& newInlineValue(OpcUa_BuiltInType type);
+
+
+        /**
+         * Clear the variant and prepare it for a value that is stored as an SDK object.
+         *
+         * @return  The (empty) SDK object to store the value in.
+         */
+        UaVariant& newSdkValue();
+
+
+        /**
+         * Clear the variant and prepare it for a native UAF value.
+         *
+         * @param type      The type of the native value.
+         * @param isArray   True if the value is an array.
+         * @return          The (empty) native value.
+         */
+        NativeValue& newNativeValue(uaf::opcuatypes::OpcUaType type, bool isArray);
+
+
+        /**
+         * Copy a OpcUa_Variant stack object into the (cleared) variant, using the most compact
+         * storage.
+         *
+         * @param variant   The stack object to copy.
+         */
+        void assign(const OpcUa_Variant& variant);
+
+
+        /**
+         * Check if a string contains NUL characters, in which case it can't be stored as a
+         * (NUL-terminated) short string without losing characters.
+         *
+         * @param string    The stack string to check.
+         * @return          True if the string contains a NUL character.
+         */
+        static bool hasEmbeddedNull(const OpcUa_String* string);
+
+
+        /**
+         * Copy the storage of another variant into this (cleared) variant.
+         *
+         * @param other     The variant to copy.
+         */
+        void copyFrom(const Variant& other);
+
+
+        /**
+         * Get the value as an SDK object (empty for native UAF values).
+         *
+         * @param temporary A temporary object, which will only be used to store the value if it
+         *                  is not already stored as an SDK object. A short string in the
+         *                  temporary refers to the characters of this variant, so the temporary
+         *                  must not outlive this variant (nor survive a change of it).
+         * @return          A reference to the SDK object (possibly the given temporary).
+         */
+        const UaVariant& sdkValue(UaVariant& temporary) const;
+
+
+        /**
+         * Get the stack object of the variant, if it holds an SDK array of the given type.
+         *
+         * @param type  The built-in type of the array.
+         * @return      The stack object, or NULL if the variant doesn't hold such an array.
+         */
+        const OpcUa_Variant* sdkArray(OpcUa_BuiltInType type) const;
+
+
+        /**
+         * Get the error for an array view that could not be made.
+         *
+         * @param type  The built-in type of the requested view.
+         * @return      A bad status.
+         */
+        uaf::Status arrayViewError(OpcUa_BuiltInType type) const;
+
+
+        /**
+         * Convert a native UAF value to an SDK object.
+         *
+         * @param uaVariant SDK object to modify.
+         */
+        void nativeValueToSdk(UaVariant& uaVariant) const;
 
 
         /**
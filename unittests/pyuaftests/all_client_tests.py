@@ -43,6 +43,8 @@ ALL_MODULES = [ "client_client",
                 "requests.translatebrowsepathstonodeidsrequesttarget",
                 "requests.writerequesttarget",
                 "requests.historyreadrawmodifiedrequesttarget",
+                "requests.registernodesrequesttarget",
+                "requests.unregisternodesrequesttarget",
                 "results.asyncresulttarget",
                 "results.browseresulttarget",
                 "results.createmonitoreddataresulttarget",
@@ -51,7 +53,9 @@ ALL_MODULES = [ "client_client",
                 "results.readresulttarget",
                 "results.translatebrowsepathstonodeidsresulttarget",
                 "results.writeresulttarget",
-                "results.historyreadrawmodifiedresulttarget"
+                "results.historyreadrawmodifiedresulttarget",
+                "results.registernodesresulttarget",
+                "results.unregisternodesresulttarget"
               ]
 
 
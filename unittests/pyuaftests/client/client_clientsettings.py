@@ -55,6 +55,97 @@ class ClientSettingsTest(unittest.TestCase):
         self.assertEqual( self.c1.clientSettings() , cs1_ )
         self.assertEqual( self.c2.clientSettings() , cs2_ )
     
+    def test_client_ClientSettings_addressCacheLimits(self):
+        cs = pyuaf.client.settings.ClientSettings()
+        
+        self.assertEqual( cs.addressCacheMaxEntries    , 1000000 )
+        self.assertEqual( cs.addressCacheMaxBytes      , 0 )
+        self.assertEqual( cs.addressCacheTimeToLiveSec , 0.0 )
+        
+        cs.addressCacheMaxEntries    = 100
+        cs.addressCacheMaxBytes      = 4096
+        cs.addressCacheTimeToLiveSec = 2.5
+        
+        self.assertEqual( cs.addressCacheMaxEntries    , 100 )
+        self.assertEqual( cs.addressCacheMaxBytes      , 4096 )
+        self.assertEqual( cs.addressCacheTimeToLiveSec , 2.5 )
+        self.assertNotEqual( cs , self.cs0 )
+        
+        self.c0.setClientSettings(cs)
+        self.assertEqual( self.c0.clientSettings() , cs )
+        
+        cs.addressCacheMaxBytes = 8192
+        self.assertNotEqual( self.c0.clientSettings() , cs )
+    
+    def test_client_ClientSettings_sessionPools(self):
+        cs = pyuaf.client.settings.ClientSettings()
+        
+        self.assertEqual( cs.defaultSessionSettings.sessionPoolSize             , 1 )
+        self.assertEqual( cs.defaultSessionSettings.separateLongRunningServices , False )
+        
+        sessionSettings = pyuaf.client.settings.SessionSettings()
+        sessionSettings.sessionPoolSize             = 4
+        sessionSettings.separateLongRunningServices = True
+        cs.defaultSessionSettings = sessionSettings
+        
+        self.assertEqual( cs.defaultSessionSettings.sessionPoolSize             , 4 )
+        self.assertEqual( cs.defaultSessionSettings.separateLongRunningServices , True )
+        self.assertNotEqual( cs.defaultSessionSettings , self.cs0.defaultSessionSettings )
+        
+        self.c0.setClientSettings(cs)
+        self.assertEqual( self.c0.clientSettings().defaultSessionSettings , sessionSettings )
+        
+        sessionSettings.separateLongRunningServices = False
+        self.assertNotEqual( self.c0.clientSettings().defaultSessionSettings , sessionSettings )
+    
+    def test_client_ClientSettings_discoveryEndpointsCacheTimeSec(self):
+        cs = pyuaf.client.settings.ClientSettings()
+        
+        self.assertEqual( cs.discoveryEndpointsCacheTimeSec , 60.0 )
+        
+        cs.discoveryEndpointsCacheTimeSec = 0.5
+        
+        self.assertEqual( cs.discoveryEndpointsCacheTimeSec , 0.5 )
+        self.assertNotEqual( cs , self.cs0 )
+        
+        self.c0.setClientSettings(cs)
+        self.assertEqual( self.c0.clientSettings() , cs )
+        
+        cs.discoveryEndpointsCacheTimeSec = 0.0
+        self.assertNotEqual( self.c0.clientSettings() , cs )
+    
+    def test_client_ClientSettings_discoveryMaxParallelFindServers(self):
+        cs = pyuaf.client.settings.ClientSettings()
+        
+        self.assertEqual( cs.discoveryMaxParallelFindServers , 10 )
+        
+        cs.discoveryMaxParallelFindServers = 3
+        
+        self.assertEqual( cs.discoveryMaxParallelFindServers , 3 )
+        self.assertNotEqual( cs , self.cs0 )
+        
+        self.c0.setClientSettings(cs)
+        self.assertEqual( self.c0.clientSettings() , cs )
+        
+        cs.discoveryMaxParallelFindServers = 1
+        self.assertNotEqual( self.c0.clientSettings() , cs )
+    
+    def test_client_ClientSettings_addressCacheUnresolvableTimeToLiveSec(self):
+        cs = pyuaf.client.settings.ClientSettings()
+        
+        self.assertEqual( cs.addressCacheUnresolvableTimeToLiveSec , 5.0 )
+        
+        cs.addressCacheUnresolvableTimeToLiveSec = 0.25
+        
+        self.assertEqual( cs.addressCacheUnresolvableTimeToLiveSec , 0.25 )
+        self.assertNotEqual( cs , self.cs0 )
+        
+        self.c0.setClientSettings(cs)
+        self.assertEqual( self.c0.clientSettings() , cs )
+        
+        cs.addressCacheUnresolvableTimeToLiveSec = 0.0
+        self.assertNotEqual( self.c0.clientSettings() , cs )
+    
     def tearDown(self):
         # delete the client instances manually (now!) instead of letting them be garbage collected 
         # automatically (which may happen during a another test, and which may cause logging output
@@ -0,0 +1,40 @@
+import pyuaf
+import unittest
+from pyuaf.util.unittesting import parseArgs, testVector
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(UnregisterNodesRequestTargetTest)
+
+
+
+class UnregisterNodesRequestTargetTest(unittest.TestCase):
+    
+    def setUp(self):
+        self.target0 = pyuaf.client.requests.UnregisterNodesRequestTarget()
+        
+        self.target1 = pyuaf.client.requests.UnregisterNodesRequestTarget()
+        self.target1.address = pyuaf.util.Address( pyuaf.util.NodeId("id", "ns"), "svr" )
+        
+        self.target2 = pyuaf.client.requests.UnregisterNodesRequestTarget( pyuaf.util.Address( pyuaf.util.NodeId("id", "ns"), "svr" ) )
+    
+    def test_client_UnregisterNodesRequestTarget_address(self):
+        self.assertEqual( self.target1.address , pyuaf.util.Address( pyuaf.util.NodeId("id", "ns"), "svr" ) )
+    
+    def test_client_UnregisterNodesRequestTarget_constructor(self):
+        self.assertEqual( self.target1 , self.target2 )
+    
+    def test_client_UnregisterNodesRequestTargetVector(self):
+        testVector(self, pyuaf.client.requests.UnregisterNodesRequestTargetVector, [self.target0, self.target1])
+    
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -0,0 +1,45 @@
+import pyuaf
+import unittest
+from pyuaf.util.unittesting import parseArgs, testVector
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(RegisterNodesResultTargetTest)
+
+
+
+class RegisterNodesResultTargetTest(unittest.TestCase):
+    
+    def setUp(self):
+        self.target0 = pyuaf.client.results.RegisterNodesResultTarget()
+        
+        self.target1 = pyuaf.client.results.RegisterNodesResultTarget()
+        self.target1.clientConnectionId = 3
+        self.target1.status.setGood()
+        self.target1.registeredNodeId = pyuaf.util.NodeId(42, 3)
+    
+    def test_client_RegisterNodesResultTarget_clientConnectionId(self):
+        self.assertEqual( self.target1.clientConnectionId , 3 )
+    
+    def test_client_RegisterNodesResultTarget_status(self):
+        status = pyuaf.util.Status()
+        status.setGood()
+        self.assertEqual( self.target1.status , status )
+    
+    def test_client_RegisterNodesResultTarget_registeredNodeId(self):
+        self.assertEqual( self.target1.registeredNodeId , pyuaf.util.NodeId(42, 3) )
+    
+    def test_client_RegisterNodesResultTargetVector(self):
+        testVector(self, pyuaf.client.results.RegisterNodesResultTargetVector, [self.target0, self.target1])
+    
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
@@ -0,0 +1,41 @@
+import pyuaf
+import unittest
+from pyuaf.util.unittesting import parseArgs, testVector
+
+
+ARGS = parseArgs()
+
+
+def suite(args=None):
+    if args is not None:
+        global ARGS
+        ARGS = args
+    
+    return unittest.TestLoader().loadTestsFromTestCase(UnregisterNodesResultTargetTest)
+
+
+
+class UnregisterNodesResultTargetTest(unittest.TestCase):
+    
+    def setUp(self):
+        self.target0 = pyuaf.client.results.UnregisterNodesResultTarget()
+        
+        self.target1 = pyuaf.client.results.UnregisterNodesResultTarget()
+        self.target1.clientConnectionId = 3
+        self.target1.status.setGood()
+    
+    def test_client_UnregisterNodesResultTarget_clientConnectionId(self):
+        self.assertEqual( self.target1.clientConnectionId , 3 )
+    
+    def test_client_UnregisterNodesResultTarget_status(self):
+        status = pyuaf.util.Status()
+        status.setGood()
+        self.assertEqual( self.target1.status , status )
+    
+    def test_client_UnregisterNodesResultTargetVector(self):
+        testVector(self, pyuaf.client.results.UnregisterNodesResultTargetVector, [self.target0, self.target1])
+    
+
+
+if __name__ == '__main__':
+    unittest.TextTestRunner(verbosity = ARGS.verbosity).run(suite())
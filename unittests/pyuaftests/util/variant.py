@@ -501,6 +501,54 @@ class VariantTest(unittest.TestCase):
         self.assertEqual( v , [pyuaf.util.Guid("{cecf86f6-cad5-48d5-9b22-989f848acc9d}"), 
                                pyuaf.util.Guid("{cecf86f6-cad5-48d5-9b22-989f848acc9e}")] )
 
+    def test_util_String_short_and_long_inputtypemap(self):
+        # short strings are stored inside the variant, long strings are allocated separately
+        for length in [0, 1, 15, 16, 23, 24, 25, 100, 1000]:
+            s = "".join([chr(ord('a') + i % 26) for i in range(length)])
+            v = self.tester.testVariantTypemap_in(pyuaf.util.primitives.String(s))
+            self.assertEqual( v , pyuaf.util.primitives.String(s) )
+            v = self.tester.testVariantTypemap_in(s)
+            self.assertEqual( v , pyuaf.util.primitives.String(s) )
+    
+    def test_util_String_short_and_long_array_inputtypemap(self):
+        v = self.tester.testVariantTypemap_in( [pyuaf.util.primitives.String("short"),
+                                                pyuaf.util.primitives.String("a" * 1000),
+                                                pyuaf.util.primitives.String("")] )
+        self.assertEqual( v , [pyuaf.util.primitives.String("short"),
+                               pyuaf.util.primitives.String("a" * 1000),
+                               pyuaf.util.primitives.String("")] )
+    
+    def test_util_String_roundTrip(self):
+        for length in [0, 1, 15, 16, 23, 24, 25, 100, 1000]:
+            self.assertTrue( self.tester.testVariantString_roundTrip(length, False) )
+            self.assertTrue( self.tester.testVariantString_roundTrip(length, True) )
+    
+    def test_util_ArrayView_adopt(self):
+        types = [ (pyuaf.util.opcuatypes.SByte  , pyuaf.util.primitives.SByte  , [-1, 2, -3]),
+                  (pyuaf.util.opcuatypes.Byte   , pyuaf.util.primitives.Byte   , [1, 2, 3]),
+                  (pyuaf.util.opcuatypes.Int16  , pyuaf.util.primitives.Int16  , [-1, 2, -3]),
+                  (pyuaf.util.opcuatypes.UInt16 , pyuaf.util.primitives.UInt16 , [1, 2, 3]),
+                  (pyuaf.util.opcuatypes.Int32  , pyuaf.util.primitives.Int32  , [-1, 2, -3]),
+                  (pyuaf.util.opcuatypes.UInt32 , pyuaf.util.primitives.UInt32 , [1, 2, 3]),
+                  (pyuaf.util.opcuatypes.Int64  , pyuaf.util.primitives.Int64  , [-1, 2, -3]),
+                  (pyuaf.util.opcuatypes.UInt64 , pyuaf.util.primitives.UInt64 , [1, 2, 3]),
+                  (pyuaf.util.opcuatypes.Float  , pyuaf.util.primitives.Float  , [-1.5, 2.5, -3.5]),
+                  (pyuaf.util.opcuatypes.Double , pyuaf.util.primitives.Double , [-1.5, 2.5, -3.5]) ]
+        for (opcUaType, primitive, values) in types:
+            array = [primitive(value) for value in values]
+            v = self.tester.testVariantArrayView_adopt(array, opcUaType)
+            self.assertEqual( v , array )
+    
+    def test_util_ArrayView_wrongType(self):
+        # a view doesn't convert: the variant must hold an array of exactly the requested type
+        v = self.tester.testVariantArrayView_adopt( [pyuaf.util.primitives.Int32(1),
+                                                     pyuaf.util.primitives.Int32(2)],
+                                                    pyuaf.util.opcuatypes.Double )
+        self.assertEqual( v , None )
+        v = self.tester.testVariantArrayView_adopt( pyuaf.util.primitives.Int32(1),
+                                                    pyuaf.util.opcuatypes.Int32 )
+        self.assertEqual( v , None )
+
     def test_util_VariantVector(self):
         testVector(self, pyuaf.util.VariantVector, [ pyuaf.util.primitives.UInt64(123132),
                                                      pyuaf.util.primitives.ByteString(bytearray("\01\02\03")),